@@ -0,0 +1,55 @@
+/**
+ * @file    adc_utils.h
+ * @brief   ADC1 : scan Vin (PA1) / capteur de température interne / VREFINT
+ *          déclenché par timer, DMA circulaire et suréchantillonnage.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "scn_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Voies du scan, dans l'ordre des rangs (répété ADC_OVS fois) */
+#define ADC_CH_VIN                   0U
+#define ADC_CH_TSENS                 1U
+#define ADC_CH_VREF                  2U
+#define ADC_NB_CH                    3U
+#define ADC_SCAN_LEN                 (ADC_NB_CH * ADC_OVS)
+
+/* Dernier scan : sommes de ADC_OVS conversions 12 bits par voie */
+typedef struct {
+    uint16_t sum[ADC_NB_CH];
+    uint32_t scans;          // scans reçus depuis AdcUtils_Start (0 : aucune mesure)
+} adc_raw_t;
+
+/* API de lifecycle : DMA circulaire armé puis timer de déclenchement */
+scn_err_t AdcUtils_Start(void);
+
+/* Copie cohérente du dernier scan (jamais d'attente de fin de conversion) */
+void      AdcUtils_GetRaw(adc_raw_t *raw);
+
+/* Conversions entières ratiométriques (VREFINT) : 0 tant qu'aucun scan n'est reçu */
+uint16_t  AdcUtils_VddamV(const adc_raw_t *raw);      // alim analogique mesurée
+uint16_t  AdcUtils_VinmV(const adc_raw_t *raw);       // entrée 24 V (pont VIN_DIV_*)
+int16_t   AdcUtils_TmcucC(const adc_raw_t *raw);      // capteur interne, TS_CAL1/TS_CAL2
+
+#if SIM_TARGET
+/* Mock du buffer DMA : écrit un scan synthétique (valeurs 12 bits par voie) dans la
+ * moitié suivante du buffer circulaire puis joue le callback demi/plein transfert
+ */
+void      AdcUtils_SimFeed(uint16_t vin, uint16_t tsens, uint16_t vref);
+void      AdcUtils_SimSetCal(uint16_t vrefint_cal, uint16_t ts_cal1, uint16_t ts_cal2);   // valeurs d'usine simulées
+#endif
+
+#ifdef __cplusplus
+}
+#endif
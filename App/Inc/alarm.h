@@ -0,0 +1,68 @@
+/**
+ * @file    alarm.h
+ * @brief   Machine d'états d'alarme température, pilotée par table :
+ *          NORMAL -> PENDING -> ACTIVE -> CLEARING -> NORMAL.
+ *          Temporisations calculées sur horodatage (compteur ms libre) :
+ *          l'appelant dort jusqu'à Alarm_Deadline au lieu de scruter.
+ *          Indépendant du RTOS : l'heure est passée en paramètre.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ALARM_NORMAL = 0,   // T dans la plage
+    ALARM_PENDING,      // T hors plage depuis moins de dwell_ms
+    ALARM_ACTIVE,       // alarme levée
+    ALARM_CLEARING,     // T revenue dans la plage moins l'hystérésis, depuis moins de dwell_ms
+    ALARM_STATE_COUNT
+} alarm_state_t;
+
+/* Changement visible de l'extérieur (seules transitions qui produisent un événement) */
+typedef enum {
+    ALARM_EV_NONE = 0,
+    ALARM_EV_RAISE,     // PENDING -> ACTIVE
+    ALARM_EV_CLEAR      // CLEARING -> NORMAL
+} alarm_ev_t;
+
+/* Politique : hors plage si T > high ou T < low ; retour si low + hyst <= T <= high - hyst */
+typedef struct {
+    int16_t  high_cC;
+    int16_t  low_cC;
+    int16_t  hyst_cC;
+    uint32_t dwell_ms;  // durée hors plage avant levée, et dans la plage avant retombée
+} alarm_cfg_t;
+
+typedef struct {
+    alarm_cfg_t   cfg;
+    alarm_state_t state;
+    bool          armed;    // échéance t_due en cours
+    uint32_t      t_due;
+} alarm_t;
+
+void          Alarm_Init(alarm_t *a, const alarm_cfg_t *cfg);   // cfg NULL : valeurs de config.h
+void          Alarm_DefaultCfg(alarm_cfg_t *cfg);
+
+/* Entrées : une mesure valide, ou le passage du temps (échéance atteinte) */
+alarm_ev_t    Alarm_Sample(alarm_t *a, int16_t t_cC, uint32_t now_ms);
+alarm_ev_t    Alarm_Poll(alarm_t *a, uint32_t now_ms);
+
+/* Attente jusqu'à la prochaine échéance : false si aucune (attente illimitée) */
+bool          Alarm_Deadline(const alarm_t *a, uint32_t now_ms, uint32_t *wait_ms);
+alarm_state_t Alarm_State(const alarm_t *a);
+bool          Alarm_IsActive(const alarm_t *a);                 // ACTIVE ou CLEARING
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file    can_bus.h
+ * @brief   Bus CAN virtuel multi-noeuds (SIM_TARGET) : trames de données
+ *          standard codées bit à bit (CRC-15, bourrage réel), arbitrage par
+ *          ET câblé sur l'identifiant, durée exacte à CAN_BAUD.
+ *          Chaque noeud reproduit l'émission de can_tx : une file par classe
+ *          (CANTX_Q_*), une trame en vol par classe, la mailbox d'ID le plus
+ *          bas présentée à l'arbitrage. Latence = mise en file -> fin d'EOF.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "can_proto.h"
+#include "can_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if SIM_TARGET
+
+#define CANBUS_NODES_MAX             127U   // un noeud par NodeID 1..127
+#define CANBUS_IFS_BITS              3U     // intermission, comptée dans la durée de trame
+#define CANBUS_HIST_US               20U    // largeur d'une classe d'histogramme de latence
+#define CANBUS_HIST_BINS             4096U  // au-delà (~82 ms) : dernière classe
+
+typedef struct {
+    uint32_t sent;              // trames acquittées
+    uint32_t lost;              // trames refusées : file de classe pleine (CanTx_Send -> ERR_CAN_TX_OVR)
+    uint32_t lost_cls[CANTX_PRIO_COUNT];
+    uint8_t  hiwater;           // profondeur max observée, toutes classes
+    uint32_t lat_p50_us;        // percentiles : borne haute de la classe d'histogramme
+    uint32_t lat_p90_us;
+    uint32_t lat_p99_us;
+    uint32_t lat_max_us;        // exact
+    uint32_t alarm_max_us;      // pire latence d'une trame de la classe alarme
+} canbus_node_stats_t;
+
+typedef struct {
+    uint64_t now_us;            // fin de la dernière trame émise
+    uint32_t frames;
+    uint64_t busy_bits;         // bits émis, bourrage et IFS compris
+    uint32_t stuff_bits;
+    uint32_t id_clashes;        // arbitrage sans gagnant unique (même ID sur deux noeuds)
+    uint16_t util_pm;           // busy / temps écoulé, ‰
+} canbus_stats_t;
+
+/* Longueur en bits d'une trame de données standard (SOF..EOF + IFS), *stuff : bits de bourrage */
+uint32_t CanBus_FrameBits(const can_frame_t *f, uint32_t *stuff);
+
+/* Bus libre à t = 0, noeuds 0..nodes-1 sans trame en attente, statistiques à zéro */
+bool     CanBus_SimInit(uint16_t nodes);
+
+/* Mise en file sur le noeud à l'instant t_us (croissant d'un appel à l'autre, RunUntil(t_us) fait avant).
+ * false : file de la classe pleine, trame perdue.
+ */
+bool     CanBus_SimSend(uint16_t node, cantx_prio_t prio, const can_frame_t *f, uint64_t t_us);
+
+/* Émet toutes les trames dont l'arbitrage commence avant t_us */
+void     CanBus_SimRunUntil(uint64_t t_us);
+
+void     CanBus_SimGetStats(canbus_stats_t *st);
+void     CanBus_SimGetNodeStats(uint16_t node, canbus_node_stats_t *st);
+
+#endif /* SIM_TARGET */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file    can_load.h
+ * @brief   Charge bus CAN simulée (SIM_TARGET) : N noeuds SCN, chacun avec
+ *          son modèle de grandeurs (cycle compresseur, ouvertures de porte,
+ *          bruit résiduel après filtrage), acquis à PERIOD_ACQ_MS et publiés
+ *          par la politique d'émission de can_proto (CanProto_ReportPoll).
+ *          Compare la télémétrie périodique et l'émission par exception,
+ *          en charge offerte ou sur le bus virtuel de can_bus.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "can_proto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if SIM_TARGET
+
+#define CANLOAD_NODES_MAX            127U   // NodeID 1..127 (0 : diffusion)
+
+typedef struct {
+    uint16_t           nodes;       // noeuds simulés, NodeID 1..nodes
+    uint32_t           duration_ms; // durée simulée
+    uint32_t           seed;        // graine des modèles (même graine : mêmes grandeurs)
+    canp_report_mode_t mode;
+} canload_cfg_t;
+
+typedef struct {
+    uint32_t frames_telem;  // trames CANP_FN_TELEM produites (tous noeuds)
+    uint32_t frames_alarm;  // trames CANP_FN_ALARM produites (transitions de porte / alarme)
+    uint32_t lost;          // SimRunBus : trames refusées, file de classe pleine
+    uint32_t fps_x100;      // trames par seconde sur le bus, x100
+    uint16_t load_pm;       // SimRun : charge offerte (‰ de CAN_BAUD, > 1000 : segment saturé) ;
+                            // SimRunBus : occupation mesurée
+} canload_result_t;
+
+/* false si nodes vaut 0 ou dépasse CANLOAD_NODES_MAX, ou durée nulle.
+ * SimRun : charge offerte, trames codées bit à bit (CanBus_FrameBits).
+ * SimRunBus : noeuds i = 0..nodes-1 (NodeID i + 1) sur can_bus ; détail par noeud
+ * (latences, pertes) ensuite par CanBus_SimGetNodeStats(i).
+ */
+bool      CanLoad_SimRun(const canload_cfg_t *cfg, canload_result_t *res);
+bool      CanLoad_SimRunBus(const canload_cfg_t *cfg, canload_result_t *res);
+
+#endif /* SIM_TARGET */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file    can_proto.h
+ * @brief   Protocole CAN SCN : identifiants, trames et transfert segmenté
+ *          (type ISO-TP : SF/FF/CF/FC) pour l'export du journal.
+ *          Indépendant de la HAL : task_can convertit can_frame_t <-> bxCAN.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "scn_err.h"
+#include "telem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Identifiants standard 11 bits : fonction (4 bits) | NodeID (7 bits).
+ * ID bas = priorité d'arbitrage haute : alarmes > télémétrie > commandes > transferts.
+ */
+#define CANP_FN_ALARM                0x1U    // noeud -> gateway
+#define CANP_FN_TELEM                0x3U    // noeud -> gateway
+#define CANP_FN_CMD                  0x6U    // gateway -> noeud
+#define CANP_FN_CFG                  0x7U    // gateway -> noeud (seuils)
+#define CANP_FN_XFER_TX              0xBU    // transfert segmenté noeud -> gateway (SF/FF/CF)
+#define CANP_FN_XFER_RX              0xCU    // gateway -> noeud (FC)
+#define CANP_ID(fn, node)            ((((uint32_t)(fn)) << 7) | ((uint32_t)(node) & 0x7FU))
+#define CANP_NODE_BCAST              0x00U   // NodeID de diffusion (gateway -> tous les noeuds)
+
+/* Commandes (CANP_FN_CMD, octet 0) */
+#define CANP_CMD_EXPORT              0x01U   // démarrer l'export du journal
+#define CANP_CMD_SNAPSHOT            0x02U   // réémettre tout l'état au prochain cycle (TLV non filtrés)
+
+/* Transfert segmenté : longueur sur 12 bits (FF), trames toujours complétées à 8 octets */
+#define CANP_XFER_MAX_LEN            4095U
+#define CANP_PAD                     0xCCU
+
+/* Export journal : un message par segment FRAM, puis un message d'un octet de fin */
+#define CANP_EXPORT_EOT              0x00U
+
+/* FIFO RX bxCAN par urgence : FIFO0 (IT dédiée, vidée en premier) pour ce qui agit
+ * sur le noeud, FIFO1 pour la configuration et le contrôle de flux des transferts.
+ */
+#define CANP_RX_FIFO_URGENT          0U
+#define CANP_RX_FIFO_NORMAL          1U
+
+/* Banc de filtres bxCAN en 16 bits : image d'un ID standard = STDID << 5 (RTR = IDE = 0).
+ * Liste : 4 images dans fr1[15:0], fr1[31:16], fr2[15:0], fr2[31:16].
+ * Masque : (ID, masque) dans fr1[15:0] / fr1[31:16] puis fr2[15:0] / fr2[31:16].
+ */
+#define CANP_FILTER_BANKS_MAX        14U     // bancs de CAN1 (SlaveStartFilterBank = 14)
+#define CANP_RX_IDS_MAX              32U     // ID consommés au plus (tables de travail sur la pile)
+
+/* Identifiant consommé par le noeud */
+typedef struct {
+    uint8_t fn;         // CANP_FN_*
+    uint8_t node;       // NODE_ID ou CANP_NODE_BCAST
+    uint8_t fifo;       // CANP_RX_FIFO_*
+} canp_rx_id_t;
+
+typedef struct {
+    uint32_t fr1;
+    uint32_t fr2;
+    uint8_t  fifo;      // CANP_RX_FIFO_*
+    bool     list;      // true : mode liste, false : mode masque
+} canp_filter_t;
+
+/* Champs CAN_FilterTypeDef d'un banc 16 bits. HAL_CAN_ConfigFilter les range en
+ * FR1 = MaskIdLow << 16 | IdLow et FR2 = MaskIdHigh << 16 | IdHigh.
+ */
+typedef struct {
+    uint16_t id_high;   // FilterIdHigh
+    uint16_t id_low;    // FilterIdLow
+    uint16_t mask_high; // FilterMaskIdHigh
+    uint16_t mask_low;  // FilterMaskIdLow
+} canp_filter_hal_t;
+
+/* Trame classique (DLC <= 8) */
+typedef struct {
+    uint32_t id;        // identifiant standard
+    uint8_t  dlc;
+    uint8_t  data[8];
+} can_frame_t;
+
+/* TLV d'état (README §8) : télémétrie TELEM_TLV_* 0x01..0x06, puis seuils d'alarme */
+#define CANP_TLV_THIGH               0x10U   // int16 centi-°C
+#define CANP_TLV_TLOW                0x11U   // int16 centi-°C
+#define CANP_TLV_HYST                0x12U   // int16 centi-°C
+#define CANP_TLV_COUNT               9U
+#define CANP_TLV_VAL_MAX             2U      // octets de valeur au plus
+
+/* Sélection de TLV : un bit par champ, dans l'ordre 0x01..0x06, 0x10..0x12 */
+#define CANP_TLV_BIT(id)             (((id) >= CANP_TLV_THIGH) ? (1UL << ((id) - CANP_TLV_THIGH + 6U)) \
+                                                               : (1UL << ((id) - TELEM_TLV_TEMP)))
+#define CANP_TLV_TELEM               0x03FUL // 0x01..0x06
+#define CANP_TLV_THRESH              0x1C0UL // 0x10..0x12
+#define CANP_TLV_ALL                 (CANP_TLV_TELEM | CANP_TLV_THRESH)
+
+/* Etat publié par le noeud */
+typedef struct {
+    telem_t t;
+    int16_t thigh_cC;
+    int16_t tlow_cC;
+    int16_t hyst_cC;
+} canp_state_t;
+
+/* Dernières valeurs émises, codées, par TLV : un champ inchangé n'est pas réémis */
+typedef struct {
+    uint8_t  val[CANP_TLV_COUNT][CANP_TLV_VAL_MAX];
+    uint16_t db[CANP_TLV_COUNT];    // bande morte par champ (unité du TLV, 0 : tout écart)
+    uint32_t known;     // CANP_TLV_BIT des champs dont val est à jour chez le récepteur
+} canp_tlv_cache_t;
+
+/* Sélection des champs à émettre par CanProto_PackTlv */
+typedef enum {
+    CANP_PACK_ALL = 0,  // tous les champs du masque
+    CANP_PACK_CHANGED,  // valeur codée différente du cache
+    CANP_PACK_DEADBAND  // écart au cache > db du champ
+} canp_pack_t;
+
+/* Politique d'émission de l'état (task_can) */
+typedef enum {
+    CANP_REPORT_PERIODIC = 0,   // télémétrie complète à chaque appel, seuils sur changement
+    CANP_REPORT_EXCEPTION       // écart > bande morte, changement d'alarme / porte, heartbeat
+} canp_report_mode_t;
+
+typedef struct {
+    canp_tlv_cache_t   tlv;
+    canp_report_mode_t mode;
+    uint32_t           t_hb;    // prochain heartbeat (état complet)
+    bool               sync;    // prochain appel : tout écart émis (bandes mortes ignorées)
+} canp_report_t;
+
+typedef enum {
+    CANP_X_IDLE = 0,    // rien en cours
+    CANP_X_BUSY,        // émission (ou réception) de CF
+    CANP_X_WAIT_FC,     // émetteur : attente d'une FC
+    CANP_X_DONE,        // message complet
+    CANP_X_ABORT        // timeout, séquence rompue ou débordement
+} canp_xstate_t;
+
+/* Émetteur : le message reste à l'appelant jusqu'à DONE/ABORT */
+typedef struct {
+    const uint8_t *msg;
+    uint16_t       len;
+    uint16_t       pos;     // octets déjà émis
+    uint32_t       id;      // ID des SF/FF/CF
+    uint8_t        sn;      // numéro de séquence de la prochaine CF
+    uint8_t        bs_cnt;  // CF restantes avant la prochaine FC (0 : illimité)
+    uint8_t        bs;      // taille de bloc imposée par le récepteur
+    uint8_t        st_ms;   // écart entre CF (max de la FC et du plancher local)
+    uint8_t        wft;     // FC WAIT consécutives
+    uint32_t       t_due;   // prochaine CF ou timeout de FC
+    canp_xstate_t  state;
+} canp_tx_t;
+
+/* Récepteur : buffer fourni par l'appelant, FC émises avec CANP_XFER_BS / CANP_XFER_STMIN_MS */
+typedef struct {
+    uint8_t       *buf;
+    uint16_t       cap;
+    uint16_t       len;     // longueur annoncée
+    uint16_t       pos;     // octets reçus
+    uint32_t       fc_id;   // ID des FC émises
+    uint8_t        sn;      // numéro de séquence attendu
+    uint8_t        bs_cnt;  // CF restantes avant la prochaine FC
+    uint32_t       t_due;   // timeout de CF
+    canp_xstate_t  state;
+} canp_rx_t;
+
+/* Session d'export du journal (côté noeud) */
+typedef struct {
+    canp_tx_t tx;
+    uint32_t  cursor;       // seq du dernier segment transmis
+    uint16_t  segs;         // segments transmis
+    bool      active;
+    bool      eot;          // message de fin en cours
+    scn_err_t err;          // lecture du journal en échec : export arrêté sans EOT
+    uint8_t   msg[FRAM_SLOT_SIZE];
+} canp_export_t;
+
+/* Émission. Poll à appeler quand une place TX est libre : true si *out est à émettre. */
+bool          CanProto_XferBegin(canp_tx_t *tx, uint32_t id, const uint8_t *msg, size_t len, uint32_t now_ms);
+bool          CanProto_XferPoll(canp_tx_t *tx, uint32_t now_ms, can_frame_t *out);
+void          CanProto_XferOnFc(canp_tx_t *tx, const can_frame_t *fc, uint32_t now_ms);
+
+/* Réception. *fc à émettre si la fonction retourne avec *send_fc = true. */
+void          CanProto_RxBegin(canp_rx_t *rx, uint32_t fc_id, uint8_t *buf, size_t cap);
+canp_xstate_t CanProto_RxFrame(canp_rx_t *rx, const can_frame_t *in, uint32_t now_ms,
+                               can_frame_t *fc, bool *send_fc);
+canp_xstate_t CanProto_RxPoll(canp_rx_t *rx, uint32_t now_ms);              // timeout N_Cr
+
+/* Export journal sur CANP_ID(CANP_FN_XFER_TX, NODE_ID), FC attendues sur CANP_FN_XFER_RX */
+void          CanProto_ExportBegin(canp_export_t *ex, uint32_t now_ms);
+bool          CanProto_ExportPoll(canp_export_t *ex, uint32_t now_ms, can_frame_t *out);
+void          CanProto_ExportOnFc(canp_export_t *ex, const can_frame_t *fc, uint32_t now_ms);
+
+/* TLV d'état. Pack : champs de mask retenus par sel face au cache, écrits directement
+ * dans les trames (aucun buffer intermédiaire), répartis au plus serré (les plus longs
+ * d'abord, première trame où ils tiennent). Retour : trames remplies (0 : rien à émettre ;
+ * max insuffisant : champs en trop laissés pour le cycle suivant).
+ */
+size_t        CanProto_TlvSize(uint8_t id);                                    // 0 si id inconnu
+void          CanProto_TlvForget(canp_tlv_cache_t *c);                         // tout réémettre
+size_t        CanProto_PackTlv(const canp_state_t *s, canp_tlv_cache_t *c, uint32_t mask, canp_pack_t sel,
+                               uint32_t id, can_frame_t *frames, size_t max);
+bool          CanProto_TlvAppend(can_frame_t *f, const canp_state_t *s, uint8_t id);   // false : plus de place
+
+/* Emission par exception : à appeler toutes les PERIOD_CAN_MS, rend les trames de l'état à émettre.
+ * Bandes mortes initialisées à CAN_DB_* ; heartbeat (état complet) toutes les PERIOD_CAN_HB_MS,
+ * déphasé selon node : des noeuds démarrés ensemble n'émettent pas leur état complet ensemble.
+ */
+void          CanProto_ReportInit(canp_report_t *r, canp_report_mode_t mode, uint8_t node, uint32_t now_ms);
+bool          CanProto_ReportSetDeadband(canp_report_t *r, uint8_t id, uint16_t db);   // false : id inconnu ou 1 octet
+void          CanProto_ReportSync(canp_report_t *r);         // transition d'alarme / porte publiée
+size_t        CanProto_ReportPoll(canp_report_t *r, const canp_state_t *s, uint32_t now_ms,
+                                  uint32_t id, can_frame_t *frames, size_t max);
+
+/* Unpack en place : TlvNext avance dans f->data et rend un pointeur sur la valeur (pas de copie).
+ * UnpackTlv applique les champs à *s ; false si trame tronquée ou id inconnu (*s partiellement mis à jour,
+ * *seen indique les champs appliqués).
+ */
+bool          CanProto_TlvNext(const can_frame_t *f, size_t *pos, uint8_t *id, const uint8_t **val);
+bool          CanProto_UnpackTlv(const can_frame_t *f, canp_state_t *s, uint32_t *seen);
+
+/* Réception : table des ID consommés (seule source des filtres matériels) */
+size_t        CanProto_RxTable(const canp_rx_id_t **rows);
+
+/* Bancs de filtres exacts pour la table : ID voisins regroupés en masque quand le groupe
+ * couvre au moins 4 ID, sinon listés (4 par banc). Retour : bancs utilisés, 0 si > max.
+ */
+size_t        CanProto_FilterBuild(canp_filter_t *banks, size_t max);
+size_t        CanProto_FilterBuildFrom(const canp_rx_id_t *rows, size_t n, canp_filter_t *banks, size_t max);
+
+/* Emulation de la bxCAN : true si l'ID standard (trame de données) passe un banc, *fifo renseigné */
+bool          CanProto_FilterMatch(const canp_filter_t *banks, size_t n, uint32_t id, uint8_t *fifo);
+
+/* Champs HAL qui reproduisent fr1 / fr2 une fois rangés par HAL_CAN_ConfigFilter */
+void          CanProto_FilterHal(const canp_filter_t *bank, canp_filter_hal_t *hal);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file    can_rx.h
+ * @brief   Réception CAN : filtres matériels générés depuis la table des ID
+ *          consommés (can_proto), une file logicielle par FIFO bxCAN,
+ *          remplie sous IT. Seules les trames de la table atteignent le CPU.
+ *          SIM_TARGET : trames injectées à travers les mêmes bancs de
+ *          filtres (émulation bxCAN).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "scn_err.h"
+#include "can_proto.h"
+
+#if !SIM_TARGET
+  #include "FreeRTOS.h"
+  #include "task.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CANRX_Q_LEN                  8U     // trames par FIFO (puissance de 2)
+
+typedef struct {
+    uint32_t rx[2];         // trames reçues par FIFO (CANP_RX_FIFO_*)
+    uint32_t overruns[2];   // trames perdues : file logicielle pleine
+    uint8_t  banks;         // bancs de filtres programmés
+} canrx_stats_t;
+
+/* Lifecycle : programme les bancs et les IT FIFO0/FIFO1, avant CanTx_Init (HAL_CAN_Start) */
+scn_err_t CanRx_Init(void);
+
+#if !SIM_TARGET
+/* Réveil du consommateur : bits notifiés (eSetBits) à la tâche à la première trame en
+ * attente, réarmé quand CanRx_Get a tout vidé.
+ */
+void      CanRx_SetWake(TaskHandle_t task, uint32_t bits);
+#endif
+
+/* Trame suivante, FIFO urgente d'abord ; false : plus rien en attente */
+bool      CanRx_Get(can_frame_t *f);
+
+void      CanRx_GetStats(canrx_stats_t *st);
+
+#if SIM_TARGET
+bool      CanRx_SimInject(const can_frame_t *f);   // false : rejetée par les filtres
+uint32_t  CanRx_SimRejected(void);                 // trames écartées par le matériel (aucune IT)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file    can_tx.h
+ * @brief   Emission CAN par files logicielles à priorité fixe :
+ *          alarmes > télémétrie > export journal.
+ *          Les trois mailboxes bxCAN sont rechargées depuis l'IT de fin
+ *          d'émission : aucune tâche n'attend ni ne scrute une mailbox libre.
+ *          Une seule trame en vol par classe : l'ordre d'émission d'une classe
+ *          est celui de sa file, la bxCAN arbitre entre classes par ID.
+ *          SIM_TARGET : bxCAN simulée (3 mailboxes, arbitrage par ID, durée
+ *          de trame à CAN_BAUD) sur horloge virtuelle en µs.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "scn_err.h"
+#include "can_proto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CANTX_MAILBOXES              3U
+
+/* Classes d'émission, de la plus urgente à la moins urgente */
+typedef enum {
+    CANTX_PRIO_ALARM = 0,   // CANP_FN_ALARM
+    CANTX_PRIO_TELEM,       // CANP_FN_TELEM
+    CANTX_PRIO_BULK,        // CANP_FN_XFER_TX (export journal)
+    CANTX_PRIO_COUNT
+} cantx_prio_t;
+
+/* Compteurs d'une classe */
+typedef struct {
+    uint8_t  depth;         // trames en file (hors trame en vol)
+    uint8_t  hiwater;       // profondeur max observée
+    uint32_t queued;        // trames acceptées
+    uint32_t sent;          // trames acquittées sur le bus (TXOK)
+    uint32_t drops;         // trames refusées : file pleine
+} cantx_class_stats_t;
+
+typedef struct {
+    cantx_class_stats_t cls[CANTX_PRIO_COUNT];
+    uint32_t            tx_errors;  // erreur ou perte d'arbitrage signalée sur une mailbox
+    uint32_t            aborts;     // mailbox annulée avant émission
+} cantx_stats_t;
+
+/* Lifecycle : démarre la bxCAN et l'IT mailbox vide (après MX_CAN1_Init) */
+scn_err_t CanTx_Init(void);
+
+/* Mise en file (appel tâche). La trame part immédiatement si sa classe n'a rien en vol
+ * et qu'une mailbox est libre. ERR_CAN_TX_OVR : file de la classe pleine, trame perdue.
+ */
+scn_err_t CanTx_Send(cantx_prio_t prio, const can_frame_t *f);
+size_t    CanTx_Free(cantx_prio_t prio);          // places libres dans la file de la classe
+bool      CanTx_Idle(void);                       // files vides et aucune trame en vol
+
+/* Diagnostics */
+void      CanTx_GetStats(cantx_stats_t *st);
+void      CanTx_ResetStats(void);
+
+#if SIM_TARGET
+/* bxCAN simulée : la trame gagnante occupe le bus (47 + 8*dlc bits + bourrage max) / CAN_BAUD,
+ * puis sa mailbox se libère et le chemin « IT fin d'émission » recharge les mailboxes.
+ */
+typedef void (*cantx_sim_sink_t)(const can_frame_t *f, uint64_t t_end_us);
+
+uint32_t  CanTx_SimFrameUs(uint8_t dlc);               // durée bus d'une trame (intermission comprise)
+void      CanTx_SimSetSink(cantx_sim_sink_t sink);     // appelé à chaque trame acquittée
+void      CanTx_SimBusBusy(uint32_t us);               // bus occupé par un autre noeud à partir de maintenant
+void      CanTx_SimAdvance(uint32_t us);               // écoule le temps (fins de trame et recharges)
+uint64_t  CanTx_SimNowUs(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file    crc_utils.h
+ * @brief   Fonctions CRC pour la validation des données (journal, capteurs).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CRC-8 poly LOGGER_CRC8_POLY (0x31), init 0xFF, sans xor final (cf. SHT31) */
+#define CRC8_INIT                    0xFFU
+
+/* Variante utilisée par Crc8_Update (résultats identiques, débits différents) */
+#define CRC8_IMPL_BITWISE            0
+#define CRC8_IMPL_TABLE              1
+#define CRC8_IMPL_SLICE4             2
+#ifndef CRC8_IMPL
+  #define CRC8_IMPL                  CRC8_IMPL_SLICE4
+#endif
+
+uint8_t Crc8_Update(uint8_t crc, const uint8_t *data, size_t len);   // variante CRC8_IMPL
+uint8_t Crc8_Compute(const uint8_t *data, size_t len);               // = Crc8_Update(CRC8_INIT, ...)
+
+/* Variantes explicites */
+uint8_t Crc8_UpdateBitwise(uint8_t crc, const uint8_t *data, size_t len);   // référence, sans table
+uint8_t Crc8_UpdateTable(uint8_t crc, const uint8_t *data, size_t len);     // table 256 octets (flash)
+uint8_t Crc8_UpdateSlice4(uint8_t crc, const uint8_t *data, size_t len);    // 4 tables, 4 octets/itération
+
+bool    Crc8_SelfTest(void);   // vecteurs connus + variantes croisées
+
+/* CRC-32 de bloc, identique à l'unité CRC STM32 : poly 0x04C11DB7, init 0xFFFFFFFF,
+ * mots 32 bits little-endian traités MSB first, dernier mot complété par des zéros.
+ * Cible : périphérique CRC (hcrc), hôte/SIM : table logicielle bit-exacte.
+ */
+#ifndef CRC32_USE_HW
+  #define CRC32_USE_HW               (!SIM_TARGET)
+#endif
+
+uint32_t Crc32_Compute(const uint8_t *data, size_t len);
+bool     Crc32_SelfTest(void);       // mot 0x12345678 -> 0xDF8A8A2B (valeur de référence ST)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file    door.h
+ * @brief   Contact de porte (reed sur PA0) par interruption : EXTI sur les
+ *          deux fronts, anti-rebond par timer matériel one-pulse relancé à
+ *          chaque front. L'état n'est pris en compte qu'après DOOR_DEBOUNCE_MS
+ *          de silence, puis publié depuis l'ISR (Core_EvtPublishFromISR, EVT_SYS_DOOR_OPEN).
+ *          Plus aucune lecture GPIO dans le cycle d'acquisition.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "scn_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t edges;             // fronts vus par l'EXTI (rebonds compris)
+    uint32_t changes;           // changements d'état publiés
+    uint32_t last_change_ms;    // horodatage du dernier changement publié
+} door_stats_t;
+
+/* Lit l'état initial et publie le bit EVT_SYS_DOOR_OPEN ; à appeler une fois les
+ * objets de core_init créés (publications suivantes depuis l'ISR du timer).
+ */
+scn_err_t Door_Init(void);
+bool      Door_IsOpen(void);                    // état filtré (aucun accès GPIO)
+
+/* Points d'entrée IT (cible : HAL_GPIO_EXTI_Callback et HAL_TIM_PeriodElapsedCallback) */
+void      Door_OnEdgeIRQ(void);
+void      Door_OnDebounceIRQ(void);
+
+void      Door_GetStats(door_stats_t *st);
+
+#if SIM_TARGET
+/* Broche et timer simulés sur horloge virtuelle : chaque changement de niveau est un front EXTI */
+void      Door_SimSetPin(bool open);            // niveau du contact (true : ouvert)
+void      Door_SimAdvance(uint32_t ms);         // fait expirer l'anti-rebond s'il échoit
+uint32_t  Door_SimNowMs(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file    filter.h
+ * @brief   Filtrage en flux des mesures, entiers uniquement, mémoire fixe :
+ *          médiane glissante sur 5 (rejet des pics), moyenne exponentielle
+ *          en virgule fixe, puis compensation offset / gain par voie.
+ *          Chaque étage est O(1) par échantillon et sans allocation.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FILTER_MED_LEN               5U
+#define FILTER_EMA_FRAC              8U              // bits fractionnaires de l'accumulateur EMA
+#define FILTER_GAIN_FRAC             14U             // gain de calibration en Q14
+#define FILTER_GAIN_ONE              (1L << FILTER_GAIN_FRAC)
+
+/* Médiane glissante : un pic isolé (jusqu'à 2 sur 5) n'atteint jamais la sortie */
+typedef struct {
+    int32_t win[FILTER_MED_LEN];
+    uint8_t pos;        // prochaine case écrasée
+} filter_med5_t;
+
+/* EMA : y += (x - y) / 2^shift, accumulateur en Q(FILTER_EMA_FRAC) (pas de biais de troncature) */
+typedef struct {
+    int32_t acc;
+    uint8_t shift;      // constante de temps ~ 2^shift échantillons
+} filter_ema_t;
+
+/* Compensation : y = x * gain / 2^FILTER_GAIN_FRAC + offset (unités de la voie) */
+typedef struct {
+    int32_t offset;
+    int32_t gain_q14;
+} filter_cal_t;
+
+/* Voie complète : médiane -> EMA -> calibration.
+ * La calibration, linéaire, est appliquée en dernier : la modifier en marche
+ * ne perturbe pas l'état des filtres.
+ */
+typedef struct {
+    filter_med5_t med;
+    filter_ema_t  ema;
+    filter_cal_t  cal;
+    bool          seeded;   // false : le prochain échantillon réinitialise médiane et EMA
+} filter_chan_t;
+
+/* Etages séparés */
+void    Filter_Med5Seed(filter_med5_t *m, int32_t x);
+int32_t Filter_Med5(filter_med5_t *m, int32_t x);
+void    Filter_EmaSeed(filter_ema_t *e, int32_t x);
+int32_t Filter_Ema(filter_ema_t *e, int32_t x);
+int32_t Filter_Cal(const filter_cal_t *c, int32_t x);
+
+/* Voie : calibration neutre (gain 1, offset 0) */
+void    Filter_ChanInit(filter_chan_t *c, uint8_t ema_shift);
+void    Filter_ChanReset(filter_chan_t *c);            // après un défaut : repart du prochain échantillon
+int32_t Filter_Chan(filter_chan_t *c, int32_t x);
+
+/* Banc : n échantillons synthétiques (rampe + pics) à travers une voie complète.
+ * Retour : coût moyen par échantillon, en cycles CPU (DWT->CYCCNT) sur cible,
+ * en ns (CLOCK_MONOTONIC) en SIM_TARGET.
+ */
+uint32_t Filter_Bench(uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
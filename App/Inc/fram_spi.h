@@ -0,0 +1,66 @@
+/**
+ * @file    fram_spi.h
+ * @brief   Driver FRAM SPI (MB85RS256B) : lectures/écritures et écriture de
+ *          pages par DMA avec double buffer de staging.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "config.h"
+#include "scn_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Compteurs bus (mesure du coût SPI par commit) */
+typedef struct {
+    uint32_t transactions;   // sélections CS
+    uint32_t cmd_bytes;      // octets opcode + adresse
+    uint32_t data_bytes;     // octets utiles lus/écrits
+    uint32_t errors;         // échecs HAL / timeouts DMA
+} fram_stats_t;
+
+/* API de lifecycle */
+scn_err_t Fram_Init(void);
+
+/* Accès bloquants (attendent la fin d'un DMA en cours) */
+scn_err_t Fram_Read(uint32_t addr, uint8_t *dst, size_t len);
+scn_err_t Fram_Write(uint32_t addr, const uint8_t *src, size_t len);
+
+/* Double buffer : on remplit Fram_StageBuffer() pendant que l'autre part sur le bus */
+uint8_t  *Fram_StageBuffer(void);                          // buffer libre (FRAM_STAGE_SIZE octets)
+scn_err_t Fram_StageSubmit(uint32_t addr, size_t len);     // WREN + WRITE + DMA, puis bascule
+scn_err_t Fram_Flush(void);                                // attend la fin du DMA en cours
+
+/* Diagnostics */
+void      Fram_GetStats(fram_stats_t *st);
+void      Fram_ResetStats(void);
+
+#if SIM_TARGET
+/* FRAM virtuelle : temps bus modélisé et usure (persistée dans FRAM_SIM_FILE) */
+typedef struct {
+    uint64_t bus_ns;         // temps bus SPI cumulé depuis Fram_ResetStats()
+    uint64_t byte_writes;    // écritures d'octets, toutes exécutions confondues
+    uint32_t max_writes;     // usure de l'octet le plus sollicité
+    uint32_t max_addr;       // adresse de cet octet
+} fram_sim_stats_t;
+
+void      Fram_SimGetStats(fram_sim_stats_t *st);
+const uint32_t *Fram_SimWearMap(void);                    // FRAM_SIZE_BYTES compteurs (NULL avant Fram_Init)
+
+/* Injection de coupure d'alim : les écritures s'arrêtent après after_bytes octets,
+ * jusqu'au prochain Fram_Init() (reboot simulé)
+ */
+void      Fram_SimPowerCut(uint32_t after_bytes);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
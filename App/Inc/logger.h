@@ -0,0 +1,108 @@
+/**
+ * @file    logger.h
+ * @brief   Journalisation télémétrie : ring buffer RAM lock-free (SPSC)
+ *          vidé périodiquement vers la FRAM SPI.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+#include "scn_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Entrée journal (valeurs entières, pas de float en FRAM) */
+typedef struct {
+    uint32_t ts_ms;     // horodatage (ms, tick RTOS + décalage restauré au boot : monotone)
+    int16_t  t_cC;      // température air (centi-°C)
+    uint16_t rh_pm;     // humidité (‰)
+    int16_t  tmcu_cC;   // temp MCU (centi-°C)
+    uint16_t vin_mV;    // tension entrée (mV)
+    uint8_t  door;      // 0/1
+    uint8_t  flags;     // bits divers (hors plage, capteur HS...)
+    uint8_t  crc8;      // CRC-8 de l'entrée
+} log_entry_t;
+
+/* Codec FRAM : keyframe complète toutes LOGGER_KEYFRAME_INTERVAL entrées, puis
+ * deltas zig-zag varint et jetons de répétition (RLE porte/flags/valeurs stables).
+ * Chaque groupe (keyframe + deltas) est clos par un CRC-8 sur ses octets encodés.
+ */
+#define LOGGER_REC_MAX               29U   // pire cas : clôture + keyframe + réserve de clôture
+
+typedef struct {
+    log_entry_t prev;       // dernière entrée encodée
+    uint32_t    dt_ms;      // dernier écart d'horodatage
+    uint16_t    since_key;  // entrées depuis la dernière keyframe
+    int32_t     grp_pos;    // début du groupe courant (-1 : aucun)
+    int32_t     run_pos;    // jeton de répétition en cours (-1 : aucun)
+} logger_enc_t;
+
+typedef struct {
+    log_entry_t prev;       // dernière entrée décodée
+    uint32_t    dt_ms;      // dernier écart d'horodatage
+    size_t      grp_pos;    // début du groupe courant
+    uint8_t     run;        // répétitions restantes à émettre
+    bool        in_grp;     // keyframe reçue
+} logger_dec_t;
+
+/* Bloc journal = une page commitée en FRAM :
+ *   magic | flags | len (LE16) | payload codec complété à 4 octets | crc32 (LE32, si BLK_F_CRC32)
+ * Le CRC-32 valide le bloc en une passe ; sans lui, on retombe sur les CRC-8 de groupe.
+ * Le magic sert de marqueur de commit : écrit en dernier, un bloc coupé commence par 0x00.
+ */
+#define LOGGER_BLK_MAGIC             0xB7U
+#define LOGGER_BLK_HDR_SIZE          4U
+#define LOGGER_BLK_F_CRC32           0x01U
+#define LOGGER_SEG_HDR_SIZE          10U     // magic | seq | ts_first | CRC-8 en tête de segment
+
+/* API de lifecycle */
+void     Logger_Init(void);
+
+/* Côté producteur (task_proc uniquement) */
+bool     Logger_Append(const log_entry_t *e);        // false si ring plein (entrée perdue)
+
+/* Côté consommateur (chemin de commit uniquement) */
+size_t   Logger_Drain(log_entry_t *dst, size_t max); // copie et libère jusqu'à max entrées
+scn_err_t Logger_Commit(void);                       // vide le ring vers la FRAM (sur EVT_SYS_COMMIT_REQ)
+
+/* Lecture du journal FRAM (ex. "log dump") : entrées commitées d'horodatage >= ts_from.
+ * Appels successifs avec ts_from = dernier ts + 1 pour paginer. Comparaisons modulo 2^32
+ * (repliement du compteur ms) : journal couvrant moins de ~24,8 jours ; ts_from antérieur
+ * à la plus ancienne entrée (d'au plus 2^31 ms) : tout le journal.
+ */
+size_t   Logger_ReadFrom(uint32_t ts_from, log_entry_t *dst, size_t max);
+
+/* Export brut (ex. transfert CAN) : copie du segment FRAM suivant, du plus ancien au plus récent,
+ * tronqué après son dernier bloc commité. *cursor = seq du dernier segment exporté (0 au départ).
+ * *len = 0 en fin de journal. ERR_BUF_SIZE si le segment dépasse max, ou erreur de lecture FRAM :
+ * *cursor inchangé dans les deux cas. Côté récepteur : en-tête de segment (LOGGER_SEG_HDR_SIZE
+ * octets) puis blocs, relus avec Logger_CheckBlock() / Logger_DecNext().
+ */
+scn_err_t Logger_ExportSegment(uint32_t *cursor, uint8_t *dst, size_t max, size_t *len);
+
+/* Codec (buffer de sortie fourni par l'appelant, ex. page FRAM) */
+void     Logger_EncBegin(logger_enc_t *enc);                                    // nouveau buffer : keyframe forcée
+bool     Logger_EncPut(logger_enc_t *enc, const log_entry_t *e,
+                       uint8_t *buf, size_t cap, size_t *pos);                  // false si place insuffisante
+void     Logger_EncEnd(logger_enc_t *enc, uint8_t *buf, size_t *pos);           // clôt le groupe courant
+void     Logger_DecBegin(logger_dec_t *dec);
+bool     Logger_DecNext(logger_dec_t *dec, const uint8_t *buf, size_t len,
+                        size_t *pos, log_entry_t *out);                         // false : fin ou données corrompues
+uint8_t  Logger_EntryCrc(const log_entry_t *e);                                 // CRC-8 des champs (hors crc8)
+scn_err_t Logger_CheckBlock(const uint8_t *blk, size_t avail, size_t *blk_len); // ERR_FRAM_CRC si bloc invalide
+
+/* Diagnostics (lisibles depuis n'importe quelle tâche) */
+uint32_t Logger_Count(void);                         // entrées en attente de commit
+uint32_t Logger_Dropped(void);                       // entrées perdues (ring plein)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file    scn_err.h
+ * @brief   Codes d'erreur normalisés du projet SCN (drivers et middlewares).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SCN_OK = 0,
+    ERR_SPI_WRITE,       // échec/timeout d'une écriture SPI
+    ERR_SPI_READ,        // échec/timeout d'une lecture SPI
+    ERR_FRAM_RANGE,      // accès hors de la FRAM
+    ERR_FRAM_CRC,        // contrôle d'intégrité journal invalide
+    ERR_ADC,             // démarrage ADC/DMA/timer refusé ou séquence incohérente
+    ERR_I2C_BUS,         // transfert I2C refusé (bus occupé) ou erreur bus/arbitrage
+    ERR_I2C_NACK,        // adresse ou donnée non acquittée
+    ERR_I2C_TIMEOUT,     // pas de fin de transfert dans le délai
+    ERR_SENSOR_CRC,      // CRC capteur invalide
+    ERR_CAN_INIT,        // démarrage bxCAN ou activation des IT refusé
+    ERR_CAN_TX_OVR,      // file d'émission pleine : trame perdue (comptée)
+    ERR_BUF_SIZE,        // buffer de l'appelant trop petit pour le résultat
+} scn_err_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file    sensor_th.h
+ * @brief   Driver température / humidité I2C (SHT31 ou HDC1080), non bloquant :
+ *          commande et lecture par interruption, la tâche dort pendant la
+ *          conversion du capteur au lieu d'occuper le bus ou le CPU.
+ *          SHT31 en mode périodique (SENSOR_TH_MODE) : une seule lecture
+ *          FETCH DATA par mesure ; HDC1080 : T et HR en une conversion.
+ *          Capteur détecté sur le bus (SHT31 0x44/0x45, HDC1080 0x40).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "scn_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Capteur détecté */
+typedef enum {
+    TH_MODEL_NONE = 0,
+    TH_MODEL_SHT31,
+    TH_MODEL_HDC1080
+} th_model_t;
+
+/* Mesure convertie (mêmes unités que telem_t) */
+typedef struct {
+    int16_t  t_cC;      // température (centi-°C)
+    uint16_t rh_pm;     // humidité relative (‰)
+} th_sample_t;
+
+/* Machine d'états d'une mesure */
+typedef enum {
+    TH_IDLE = 0,        // aucune mesure en cours
+    TH_CMD,             // commande en cours d'émission (IT)
+    TH_CONV,            // conversion dans le capteur, bus libre
+    TH_READ             // lecture du résultat en cours (IT)
+} th_state_t;
+
+/* Compteurs bus (coût I2C par mesure) */
+typedef struct {
+    uint32_t xfers;          // transferts START..STOP (écriture + lecture en repeated start : 1)
+    uint32_t bytes;          // octets sur le bus, octets d'adresse compris
+    uint32_t probes;         // détections lancées
+    uint32_t setups;         // (re)configurations du capteur
+    uint32_t nacks;          // adresse ou donnée non acquittée
+    uint32_t timeouts;       // fin de transfert jamais signalée
+    uint32_t bus_errors;     // refus HAL, erreur bus / arbitrage
+    uint32_t crc_errors;     // CRC capteur invalide
+} th_stats_t;
+
+/* API de lifecycle (aucun accès bus : détection et configuration depuis la tâche) */
+scn_err_t  SensorTh_Init(void);
+
+/* Détection : SHT31 (0x44 puis 0x45) puis HDC1080 (registre Device ID), premier trouvé retenu.
+ * Relancée par Trigger tant qu'aucun capteur n'est retenu, ou après des NACK répétés.
+ */
+scn_err_t  SensorTh_Probe(void);
+th_model_t SensorTh_Model(void);
+uint16_t   SensorTh_Addr(void);                        // adresse 8 bits (0 : aucun capteur)
+
+/* Mesure en deux temps : Trigger rend la main dès la commande lancée ; Collect bloque
+ * la tâche appelante (sémaphore / délai RTOS, jamais d'attente active) jusqu'au résultat.
+ * Erreurs : ERR_I2C_NACK, ERR_I2C_TIMEOUT, ERR_I2C_BUS, ERR_SENSOR_CRC (la mesure repart de TH_IDLE).
+ */
+scn_err_t  SensorTh_Trigger(void);
+scn_err_t  SensorTh_Collect(th_sample_t *out);
+scn_err_t  SensorTh_Read(th_sample_t *out);            // Trigger + Collect
+th_state_t SensorTh_State(void);
+
+/* Diagnostics */
+void       SensorTh_GetStats(th_stats_t *st);
+void       SensorTh_ResetStats(void);
+
+#if SIM_TARGET
+/* Bus I2C simulé : capteurs émulés au niveau transaction (commande, conversion, lecture).
+ * Une lecture avant la fin de conversion est NACKée, comme sur le vrai composant.
+ */
+#define TH_SIM_SHT31                 (1U << 0)   // SHT31 en 0x44
+#define TH_SIM_SHT31_ALT             (1U << 1)   // SHT31 en 0x45
+#define TH_SIM_HDC1080               (1U << 2)   // HDC1080 en 0x40
+
+typedef enum {
+    TH_SIM_NONE = 0,
+    TH_SIM_NACK,        // adresse non acquittée (capteur absent ou occupé)
+    TH_SIM_HANG,        // aucune IT de fin de transfert (bus bloqué) : timeout
+    TH_SIM_CRC          // octet de donnée corrompu à la lecture
+} th_sim_fault_t;
+
+void       SensorTh_SimPresent(uint8_t mask);                   // TH_SIM_* présents (défaut : TH_SIM_SHT31)
+void       SensorTh_SimSetEnv(int16_t t_cC, uint16_t rh_pm);    // grandeurs vues par les capteurs
+void       SensorTh_SimFault(th_sim_fault_t fault, uint8_t n);  // appliqué aux n transferts suivants
+uint32_t   SensorTh_SimNowMs(void);                             // horloge virtuelle (délais et timeouts)
+void       SensorTh_SimAdvance(uint32_t ms);                    // temps écoulé hors driver (période d'acquisition)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
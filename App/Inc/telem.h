@@ -0,0 +1,59 @@
+/**
+ * @file    telem.h
+ * @brief   Télémétrie en virgule fixe : même représentation entière de
+ *          l'acquisition à la FRAM (log_entry_t) et au CAN (TLV), sans float.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "logger.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bits de flags (communs télémétrie / journal / TLV FLAGS) */
+#define TELEM_F_TH_FAULT             (1U << 0)   // capteur T/HR absent ou en erreur
+#define TELEM_F_ADC_FAULT            (1U << 1)   // mesure Vin / Tmcu invalide
+#define TELEM_F_T_HIGH               (1U << 2)   // T au-dessus du seuil haut
+#define TELEM_F_T_LOW                (1U << 3)   // T sous le seuil bas
+#define TELEM_F_VIN_LOW              (1U << 4)   // alimentation basse
+
+/* Mesure d'un cycle d'acquisition (16 octets, copiée par valeur dans s_qTelem).
+ * Champs dans l'ordre de log_entry_t : conversion par simples copies.
+ */
+typedef struct {
+    uint32_t ts_ms;     // tick RTOS de l'acquisition
+    int16_t  t_cC;      // température air (centi-°C)
+    uint16_t rh_pm;     // humidité (‰)
+    int16_t  tmcu_cC;   // temp MCU (centi-°C)
+    uint16_t vin_mV;    // tension entrée (mV)
+    uint8_t  door;      // 0/1
+    uint8_t  flags;     // TELEM_F_*
+} telem_t;
+
+/* TLV CAN (README §8) : id (1 octet) + valeur little-endian de taille fixe */
+#define TELEM_TLV_TEMP               0x01U   // int16  centi-°C
+#define TELEM_TLV_HUM                0x02U   // uint16 ‰
+#define TELEM_TLV_TMCU               0x03U   // int16  centi-°C
+#define TELEM_TLV_VIN                0x04U   // uint16 mV
+#define TELEM_TLV_DOOR               0x05U   // uint8  0/1
+#define TELEM_TLV_FLAGS              0x06U   // uint8  TELEM_F_*
+
+/* Journal : entrée prête pour Logger_Append (crc8 posé par le logger) */
+void     Telem_ToLog(const telem_t *t, log_entry_t *e);
+
+/* TLV : taille de la valeur (0 si id inconnu), écriture/lecture d'un champ */
+size_t   Telem_TlvSize(uint8_t id);
+size_t   Telem_TlvPut(const telem_t *t, uint8_t id, uint8_t *dst);              // octets écrits (valeur seule)
+bool     Telem_TlvGet(telem_t *t, uint8_t id, const uint8_t *src, size_t len);  // false si id/longueur invalide
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file    adc_utils.c
+ * @brief   ADC1 en scan déclenché par TIM3 : Vin, capteur de température
+ *          interne et VREFINT, chaque voie répétée ADC_OVS fois dans la
+ *          séquence (suréchantillonnage matériel, le F4 n'a pas d'accumulateur).
+ *          DMA circulaire sur deux scans : les IT demi/plein transfert somment
+ *          la moitié stable pendant que le DMA remplit l'autre. Aucune attente
+ *          d'EOC côté tâches.
+ *          Conversions ratiométriques : VDDA déduite de VREFINT et de sa valeur
+ *          d'usine, capteur interne recalé sur TS_CAL1/TS_CAL2, arithmétique
+ *          entière avec facteurs précalculés au démarrage.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "adc_utils.h"
+#include <string.h>
+
+#if !SIM_TARGET
+  #include "stm32f4xx_ll_adc.h"      /* adresses des valeurs d'usine */
+  extern ADC_HandleTypeDef ADC_HANDLE;
+  extern TIM_HandleTypeDef ADC_TRIG_TIM;
+  #define ADC_DMB()   __DMB()
+#else
+  #define ADC_DMB()   __asm__ volatile ("" ::: "memory")
+  #define VREFINT_CAL_VREF       3300UL
+  #define TEMPSENSOR_CAL1_TEMP   30
+  #define TEMPSENSOR_CAL2_TEMP   110
+#endif
+
+/* Valeurs d'usine typiques (datasheet : VREFINT 1,21 V, capteur 0,76 V @ 25 °C, 2,5 mV/°C),
+ * utilisées si la zone système est illisible/incohérente et comme défaut SIM
+ */
+#define CAL_VREFINT_TYP   1502U
+#define CAL_TS1_TYP       959U
+#define CAL_TS2_TYP       1207U
+
+typedef char adc_scan_len_check[(ADC_SCAN_LEN <= 16U) ? 1 : -1];           /* 16 rangs réguliers max */
+typedef char adc_sum_fits_check[((4095U * ADC_OVS) <= 0xFFFFU) ? 1 : -1];
+
+/* ---------- État (scope fichier) ---------- */
+static uint16_t          s_dma[2U * ADC_SCAN_LEN];   /* deux scans : demi-transfert = un scan */
+static adc_raw_t         s_last;                     /* écrit en IT uniquement               */
+static volatile uint32_t s_gen;                      /* impair : s_last en cours d'écriture   */
+
+/* Facteurs précalculés depuis les valeurs d'usine (cal_load) */
+static uint32_t          s_vdda_k;     /* VDDA[mV] = s_vdda_k / somme_vref                  */
+static uint32_t          s_vin_k;      /* Vin[mV]  = somme_vin * s_vin_k / somme_vref (pont) */
+static uint32_t          s_vref_cal;   /* VREFINT_CAL                                      */
+static int32_t           s_ts1_q4;     /* TS_CAL1 << 4                                     */
+static int32_t           s_ts_span_q4; /* (TS_CAL2 - TS_CAL1) << 4                         */
+#if SIM_TARGET
+static uint32_t          s_sim_half;                 /* moitié remplie par le prochain feed   */
+static uint16_t          s_sim_cal[3] = { CAL_VREFINT_TYP, CAL_TS1_TYP, CAL_TS2_TYP };
+#endif
+
+/* Lit les valeurs d'usine et précalcule les facteurs (une fois, hors chemin de mesure) */
+static void cal_load(void)
+{
+#if SIM_TARGET
+	uint32_t vref = s_sim_cal[0], ts1 = s_sim_cal[1], ts2 = s_sim_cal[2];
+#else
+	uint32_t vref = *VREFINT_CAL_ADDR, ts1 = *TEMPSENSOR_CAL1_ADDR, ts2 = *TEMPSENSOR_CAL2_ADDR;
+#endif
+	/* Plages plausibles (VREFINT 1,18..1,24 V ; pente capteur 2..3 mV/°C sur 80 °C) */
+	if (vref < 1400U || vref > 1650U) {
+		vref = CAL_VREFINT_TYP;
+	}
+	if (ts2 <= ts1 || (ts2 - ts1) < 190U || (ts2 - ts1) > 300U) {
+		ts1 = CAL_TS1_TYP;
+		ts2 = CAL_TS2_TYP;
+	}
+
+	s_vref_cal   = vref;
+	s_vdda_k     = VREFINT_CAL_VREF * vref * ADC_OVS;
+	s_vin_k      = (uint32_t)(((uint64_t)VREFINT_CAL_VREF * vref * (VIN_DIV_RTOP_OHM + VIN_DIV_RBOT_OHM)
+	                           + (uint64_t)VIN_DIV_RBOT_OHM * 4095U / 2U)
+	                          / ((uint64_t)VIN_DIV_RBOT_OHM * 4095U));
+	s_ts1_q4     = (int32_t)(ts1 << 4);
+	s_ts_span_q4 = (int32_t)((ts2 - ts1) << 4);
+}
+
+/* Contexte IT DMA : somme un scan et publie (seqlock, le lecteur relit si besoin) */
+static void scan_done(const uint16_t *scan)
+{
+	uint16_t sum[ADC_NB_CH] = {0};
+	for (uint32_t k = 0; k < ADC_OVS; k++) {
+		for (uint32_t c = 0; c < ADC_NB_CH; c++) {
+			sum[c] = (uint16_t)(sum[c] + scan[k * ADC_NB_CH + c]);
+		}
+	}
+
+	s_gen++;
+	ADC_DMB();
+	memcpy(s_last.sum, sum, sizeof(sum));
+	s_last.scans++;
+	ADC_DMB();
+	s_gen++;
+}
+
+/* API */
+scn_err_t AdcUtils_Start(void)
+{
+	memset(&s_last, 0, sizeof(s_last));
+	s_gen = 0U;
+	cal_load();
+
+#if SIM_TARGET
+	s_sim_half = 0U;
+	return SCN_OK;
+#else
+	/* La séquence de MX_ADC1_Init doit correspondre à ADC_OVS x (Vin, Tmcu, VREFINT) */
+	if (ADC_HANDLE.Init.NbrOfConversion != ADC_SCAN_LEN) {
+		return ERR_ADC;
+	}
+	if (HAL_ADC_Start_DMA(&ADC_HANDLE, (uint32_t *)s_dma, 2U * ADC_SCAN_LEN) != HAL_OK) {
+		return ERR_ADC;
+	}
+	return (HAL_TIM_Base_Start(&ADC_TRIG_TIM) == HAL_OK) ? SCN_OK : ERR_ADC;
+#endif
+}
+
+void AdcUtils_GetRaw(adc_raw_t *raw)
+{
+	/* Préemptable uniquement par l'écrivain (IT) : au pire un tour de plus */
+	uint32_t g;
+	do {
+		g = s_gen;
+		ADC_DMB();
+		*raw = s_last;
+		ADC_DMB();
+	} while ((g & 1U) != 0U || g != s_gen);
+}
+
+uint16_t AdcUtils_VddamV(const adc_raw_t *raw)
+{
+	uint32_t vref = raw->sum[ADC_CH_VREF];
+	return (vref == 0U) ? 0U : (uint16_t)((s_vdda_k + vref / 2U) / vref);
+}
+
+uint16_t AdcUtils_VinmV(const adc_raw_t *raw)
+{
+	uint32_t vref = raw->sum[ADC_CH_VREF];
+	if (vref == 0U) {
+		return 0U;
+	}
+	uint32_t mv = ((uint32_t)raw->sum[ADC_CH_VIN] * s_vin_k + vref / 2U) / vref;
+	return (mv > 0xFFFFU) ? 0xFFFFU : (uint16_t)mv;
+}
+
+int16_t AdcUtils_TmcucC(const adc_raw_t *raw)
+{
+	uint32_t vref = raw->sum[ADC_CH_VREF];
+	if (vref == 0U) {
+		return 0;
+	}
+	/* Mesure ramenée à VDDA = 3,3 V (conditions de calibration), en 12 bits Q4 */
+	int32_t ts_q4 = (int32_t)(((uint32_t)raw->sum[ADC_CH_TSENS] * s_vref_cal * 16U) / vref);
+	int32_t dt    = (TEMPSENSOR_CAL2_TEMP - TEMPSENSOR_CAL1_TEMP) * 100;
+	return (int16_t)(TEMPSENSOR_CAL1_TEMP * 100 + ((ts_q4 - s_ts1_q4) * dt) / s_ts_span_q4);
+}
+
+#if SIM_TARGET
+
+void AdcUtils_SimFeed(uint16_t vin, uint16_t tsens, uint16_t vref)
+{
+	uint16_t *scan = &s_dma[s_sim_half * ADC_SCAN_LEN];
+	for (uint32_t k = 0; k < ADC_OVS; k++) {
+		scan[k * ADC_NB_CH + ADC_CH_VIN]   = vin;
+		scan[k * ADC_NB_CH + ADC_CH_TSENS] = tsens;
+		scan[k * ADC_NB_CH + ADC_CH_VREF]  = vref;
+	}
+	scan_done(scan);
+	s_sim_half ^= 1U;
+}
+
+void AdcUtils_SimSetCal(uint16_t vrefint_cal, uint16_t ts_cal1, uint16_t ts_cal2)
+{
+	s_sim_cal[0] = vrefint_cal;
+	s_sim_cal[1] = ts_cal1;
+	s_sim_cal[2] = ts_cal2;
+	cal_load();
+}
+
+#else
+
+/* Callbacks HAL (contexte IT DMA2_Stream0) */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	if (hadc->Instance == ADC_HANDLE.Instance) {
+		scan_done(&s_dma[0]);
+	}
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	if (hadc->Instance == ADC_HANDLE.Instance) {
+		scan_done(&s_dma[ADC_SCAN_LEN]);
+	}
+}
+
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+	/* Overrun : le DMA s'arrête, on réarme (le prochain TRGO relance un scan complet) */
+	if (hadc->Instance == ADC_HANDLE.Instance) {
+		(void)HAL_ADC_Stop_DMA(hadc);
+		(void)HAL_ADC_Start_DMA(hadc, (uint32_t *)s_dma, 2U * ADC_SCAN_LEN);
+	}
+}
+
+#endif /* SIM_TARGET */
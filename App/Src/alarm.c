@@ -0,0 +1,154 @@
+/**
+ * @file    alarm.c
+ * @brief   Alarme température : table de transitions état x entrée.
+ *          Une mesure est classée OK / BAND (dans la plage, dans
+ *          l'hystérésis) / OUT ; l'échéance du dwell est une entrée TMO.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "alarm.h"
+
+/* Défauts cohérents : une zone de retour non vide entre les deux seuils */
+typedef char alarm_cfg_check[(TEMP_LOW_cC + TEMP_HYST_cC <= TEMP_HIGH_cC - TEMP_HYST_cC) ? 1 : -1];
+
+typedef enum {
+	IN_OK = 0,      // low + hyst <= T <= high - hyst
+	IN_BAND,        // dans la plage, à moins de hyst d'un seuil
+	IN_OUT,         // T > high ou T < low
+	IN_TMO,         // échéance atteinte
+	IN_COUNT
+} alarm_in_t;
+
+/* Actions d'une transition */
+#define ACT_ARM         0x01U   // échéance = maintenant + dwell
+#define ACT_DISARM      0x02U
+#define ACT_RAISE       0x04U
+#define ACT_CLEAR       0x08U
+
+typedef struct {
+	uint8_t next;   // alarm_state_t
+	uint8_t act;    // ACT_*
+} alarm_tr_t;
+
+static const alarm_tr_t k_fsm[ALARM_STATE_COUNT][IN_COUNT] = {
+	[ALARM_NORMAL] = {
+		[IN_OK]   = { ALARM_NORMAL,   0U },
+		[IN_BAND] = { ALARM_NORMAL,   0U },
+		[IN_OUT]  = { ALARM_PENDING,  ACT_ARM },
+		[IN_TMO]  = { ALARM_NORMAL,   0U },
+	},
+	[ALARM_PENDING] = {
+		[IN_OK]   = { ALARM_NORMAL,   ACT_DISARM },
+		[IN_BAND] = { ALARM_NORMAL,   ACT_DISARM },
+		[IN_OUT]  = { ALARM_PENDING,  0U },                     /* échéance conservée */
+		[IN_TMO]  = { ALARM_ACTIVE,   ACT_DISARM | ACT_RAISE },
+	},
+	[ALARM_ACTIVE] = {
+		[IN_OK]   = { ALARM_CLEARING, ACT_ARM },
+		[IN_BAND] = { ALARM_ACTIVE,   0U },
+		[IN_OUT]  = { ALARM_ACTIVE,   0U },
+		[IN_TMO]  = { ALARM_ACTIVE,   0U },
+	},
+	[ALARM_CLEARING] = {
+		[IN_OK]   = { ALARM_CLEARING, 0U },
+		[IN_BAND] = { ALARM_ACTIVE,   ACT_DISARM },             /* retour incomplet : on recommence */
+		[IN_OUT]  = { ALARM_ACTIVE,   ACT_DISARM },
+		[IN_TMO]  = { ALARM_NORMAL,   ACT_DISARM | ACT_CLEAR },
+	},
+};
+
+/* Echéance atteinte (compteur ms libre, débordement toléré) */
+static inline bool due(uint32_t now, uint32_t t)
+{
+	return (int32_t)(now - t) >= 0;
+}
+
+static alarm_in_t classify(const alarm_cfg_t *c, int16_t t)
+{
+	if (t > c->high_cC || t < c->low_cC) {
+		return IN_OUT;
+	}
+	if (t > c->high_cC - c->hyst_cC || t < c->low_cC + c->hyst_cC) {
+		return IN_BAND;
+	}
+	return IN_OK;
+}
+
+static alarm_ev_t step(alarm_t *a, alarm_in_t in, uint32_t now_ms)
+{
+	const alarm_tr_t *tr = &k_fsm[a->state][in];
+
+	a->state = (alarm_state_t)tr->next;
+	if ((tr->act & ACT_DISARM) != 0U) {
+		a->armed = false;
+	}
+	if ((tr->act & ACT_ARM) != 0U) {
+		a->armed = true;
+		a->t_due = now_ms + a->cfg.dwell_ms;
+	}
+	if ((tr->act & ACT_RAISE) != 0U) {
+		return ALARM_EV_RAISE;
+	}
+	return ((tr->act & ACT_CLEAR) != 0U) ? ALARM_EV_CLEAR : ALARM_EV_NONE;
+}
+
+/* API */
+void Alarm_DefaultCfg(alarm_cfg_t *cfg)
+{
+	cfg->high_cC  = TEMP_HIGH_cC;
+	cfg->low_cC   = TEMP_LOW_cC;
+	cfg->hyst_cC  = TEMP_HYST_cC;
+	cfg->dwell_ms = ALARM_DWELL_MS;
+}
+
+void Alarm_Init(alarm_t *a, const alarm_cfg_t *cfg)
+{
+	if (cfg != NULL) {
+		a->cfg = *cfg;
+	} else {
+		Alarm_DefaultCfg(&a->cfg);
+	}
+	a->state = ALARM_NORMAL;
+	a->armed = false;
+	a->t_due = 0U;
+}
+
+alarm_ev_t Alarm_Poll(alarm_t *a, uint32_t now_ms)
+{
+	if (!a->armed || !due(now_ms, a->t_due)) {
+		return ALARM_EV_NONE;
+	}
+	return step(a, IN_TMO, now_ms);
+}
+
+alarm_ev_t Alarm_Sample(alarm_t *a, int16_t t_cC, uint32_t now_ms)
+{
+	/* Echéance passée avant cette mesure : appliquée d'abord. Elle mène à ACTIVE ou
+	 * NORMAL, d'où une mesure ne produit aucun événement : un seul au total.
+	 */
+	alarm_ev_t ev = Alarm_Poll(a, now_ms);
+	alarm_ev_t ev_s = step(a, classify(&a->cfg, t_cC), now_ms);
+	return (ev != ALARM_EV_NONE) ? ev : ev_s;
+}
+
+bool Alarm_Deadline(const alarm_t *a, uint32_t now_ms, uint32_t *wait_ms)
+{
+	if (!a->armed) {
+		return false;
+	}
+	int32_t left = (int32_t)(a->t_due - now_ms);
+	*wait_ms = (left > 0) ? (uint32_t)left : 0U;
+	return true;
+}
+
+alarm_state_t Alarm_State(const alarm_t *a)
+{
+	return a->state;
+}
+
+bool Alarm_IsActive(const alarm_t *a)
+{
+	return a->state == ALARM_ACTIVE || a->state == ALARM_CLEARING;
+}
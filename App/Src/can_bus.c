@@ -0,0 +1,299 @@
+/**
+ * @file    can_bus.c
+ * @brief   Bus CAN virtuel : temps en ns, un bit = 1e9 / CAN_BAUD.
+ *          Une trame démarre quand le bus est libre (fin d'IFS) et qu'au moins
+ *          un noeud a une trame prête ; tous les noeuds prêts à cet instant
+ *          émettent leur SOF ensemble et s'arbitrent bit à bit sur l'ID
+ *          (dominant 0 l'emporte), les autres attendent la fin de la trame.
+ *          Le bourrage ne change pas l'issue de l'arbitrage (préfixes
+ *          identiques tant que deux noeuds sont en lice), il ne compte que
+ *          dans la durée de la trame gagnante.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "can_bus.h"
+
+#if SIM_TARGET
+
+#include <string.h>
+
+#define BUS_BIT_NS       (1000000000ULL / CAN_BAUD)
+#define BUS_Q_MAX        CANTX_Q_ALARM      /* plus grande des files (voir bus_check) */
+#define BUS_CRC15_POLY   0x4599U
+
+typedef char bus_q_check[(CANTX_Q_ALARM >= CANTX_Q_TELEM && CANTX_Q_ALARM >= CANTX_Q_BULK) ? 1 : -1];
+typedef char bus_baud_check[(1000000000ULL % CAN_BAUD == 0U) ? 1 : -1];
+
+typedef struct {
+	can_frame_t f;
+	uint64_t    t_ns;        /* mise en file */
+} bus_slot_t;
+
+typedef struct {
+	bus_slot_t q[CANTX_PRIO_COUNT][BUS_Q_MAX];
+	uint8_t    head[CANTX_PRIO_COUNT];
+	uint8_t    count[CANTX_PRIO_COUNT];
+	canbus_node_stats_t st;
+} bus_node_t;
+
+/* ---------- État (scope fichier) ---------- */
+static const uint8_t  k_cap[CANTX_PRIO_COUNT] = { CANTX_Q_ALARM, CANTX_Q_TELEM, CANTX_Q_BULK };
+
+static bus_node_t     s_node[CANBUS_NODES_MAX];
+static uint32_t       s_hist[CANBUS_NODES_MAX][CANBUS_HIST_BINS];
+static uint16_t       s_nodes;
+static uint64_t       s_free_ns;         /* fin de la trame en cours (IFS compris) */
+static uint64_t       s_run_ns;          /* horizon atteint par RunUntil */
+static canbus_stats_t s_stats;
+
+/* ---------- Codage bit à bit ---------- */
+typedef struct {
+	uint16_t crc;
+	uint8_t  last;
+	uint8_t  run;
+	uint32_t bits;
+	uint32_t stuff;
+} bit_enc_t;
+
+/* Bit de la zone bourrée (SOF..CRC) ; crc : bit compris dans le CRC-15 */
+static void enc_bit(bit_enc_t *e, uint8_t b, bool crc)
+{
+	if (crc) {
+		uint8_t nxt = (uint8_t)(b ^ ((e->crc >> 14) & 1U));
+		e->crc = (uint16_t)((e->crc << 1) & 0x7FFFU);
+		if (nxt != 0U) {
+			e->crc ^= BUS_CRC15_POLY;
+		}
+	}
+	e->bits++;
+	if (e->run > 0U && b == e->last) {
+		e->run++;
+	} else {
+		e->last = b;
+		e->run  = 1U;
+	}
+	if (e->run == 5U) {                                 /* 5 bits égaux : bit inverse inséré */
+		e->bits++;
+		e->stuff++;
+		e->last = (uint8_t)!b;
+		e->run  = 1U;
+	}
+}
+
+static void enc_field(bit_enc_t *e, uint32_t v, uint8_t n, bool crc)
+{
+	while (n-- > 0U) {
+		enc_bit(e, (uint8_t)((v >> n) & 1U), crc);
+	}
+}
+
+uint32_t CanBus_FrameBits(const can_frame_t *f, uint32_t *stuff)
+{
+	bit_enc_t e;
+	uint8_t   dlc = (f->dlc > 8U) ? 8U : f->dlc;
+
+	memset(&e, 0, sizeof(e));
+	enc_bit(&e, 0U, true);                              /* SOF */
+	enc_field(&e, f->id & 0x7FFU, 11U, true);
+	enc_field(&e, 0U, 3U, true);                        /* RTR, IDE, r0 */
+	enc_field(&e, f->dlc & 0xFU, 4U, true);
+	for (uint8_t i = 0U; i < dlc; i++) {
+		enc_field(&e, f->data[i], 8U, true);
+	}
+	enc_field(&e, e.crc, 15U, false);
+	if (stuff != NULL) {
+		*stuff = e.stuff;
+	}
+	/* Délimiteur CRC, ACK, délimiteur ACK, EOF (7), intermission : hors bourrage */
+	return e.bits + 1U + 1U + 1U + 7U + CANBUS_IFS_BITS;
+}
+
+/* ---------- Noeuds ---------- */
+static bus_slot_t *node_head(bus_node_t *n, uint8_t prio)
+{
+	return (n->count[prio] > 0U) ? &n->q[prio][n->head[prio]] : NULL;
+}
+
+/* Mailbox présentée à l'arbitrage : ID le plus bas parmi les têtes de classe (TXFP = 0) */
+static int node_pick(bus_node_t *n, uint64_t start_ns)
+{
+	int best = -1;
+
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		bus_slot_t *s = node_head(n, p);
+		if (s != NULL && s->t_ns <= start_ns && (best < 0 || s->f.id < n->q[best][n->head[best]].f.id)) {
+			best = p;
+		}
+	}
+	return best;
+}
+
+static void node_done(uint16_t i, uint8_t prio, uint64_t end_ns)
+{
+	bus_node_t *n   = &s_node[i];
+	bus_slot_t *s   = node_head(n, prio);
+	uint64_t    lat = (end_ns - s->t_ns) / 1000U;
+	uint32_t    bin = (uint32_t)(lat / CANBUS_HIST_US);
+
+	s_hist[i][(bin < CANBUS_HIST_BINS) ? bin : CANBUS_HIST_BINS - 1U]++;
+	if (lat > n->st.lat_max_us) {
+		n->st.lat_max_us = (uint32_t)lat;
+	}
+	if (prio == CANTX_PRIO_ALARM && lat > n->st.alarm_max_us) {
+		n->st.alarm_max_us = (uint32_t)lat;
+	}
+	n->st.sent++;
+	n->head[prio] = (uint8_t)((n->head[prio] + 1U) % k_cap[prio]);
+	n->count[prio]--;
+}
+
+/* ---------- API ---------- */
+bool CanBus_SimInit(uint16_t nodes)
+{
+	if (nodes == 0U || nodes > CANBUS_NODES_MAX) {
+		return false;
+	}
+	memset(s_node, 0, sizeof(s_node));
+	memset(s_hist, 0, sizeof(s_hist));
+	memset(&s_stats, 0, sizeof(s_stats));
+	s_nodes   = nodes;
+	s_free_ns = 0U;
+	s_run_ns  = 0U;
+	return true;
+}
+
+bool CanBus_SimSend(uint16_t node, cantx_prio_t prio, const can_frame_t *f, uint64_t t_us)
+{
+	if (node >= s_nodes || prio >= CANTX_PRIO_COUNT) {
+		return false;
+	}
+	bus_node_t *n = &s_node[node];
+	if (n->count[prio] == k_cap[prio]) {
+		n->st.lost++;
+		n->st.lost_cls[prio]++;
+		return false;
+	}
+	bus_slot_t *s = &n->q[prio][(n->head[prio] + n->count[prio]) % k_cap[prio]];
+	s->f    = *f;
+	s->t_ns = t_us * 1000U;
+	n->count[prio]++;
+
+	uint8_t depth = (uint8_t)(n->count[0] + n->count[1] + n->count[2]);
+	if (depth > n->st.hiwater) {
+		n->st.hiwater = depth;
+	}
+	return true;
+}
+
+void CanBus_SimRunUntil(uint64_t t_us)
+{
+	uint64_t t_end = t_us * 1000U;
+
+	for (;;) {
+		/* Départ : bus libre et première trame prête */
+		uint64_t ready = UINT64_MAX;
+		for (uint16_t i = 0U; i < s_nodes; i++) {
+			for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+				bus_slot_t *s = node_head(&s_node[i], p);
+				if (s != NULL && s->t_ns < ready) {
+					ready = s->t_ns;
+				}
+			}
+		}
+		if (ready == UINT64_MAX) {
+			break;
+		}
+		uint64_t start = (ready > s_free_ns) ? ready : s_free_ns;
+		if (start >= t_end) {
+			break;                                      /* d'autres trames peuvent encore arriver avant */
+		}
+
+		/* Arbitrage : ET câblé, MSB de l'ID d'abord (RTR dominant pour toutes les trames de données) */
+		uint16_t who[CANBUS_NODES_MAX];
+		uint8_t  cls[CANBUS_NODES_MAX];
+		uint16_t id[CANBUS_NODES_MAX];
+		uint16_t n = 0U;
+		for (uint16_t i = 0U; i < s_nodes; i++) {
+			int p = node_pick(&s_node[i], start);
+			if (p >= 0) {
+				who[n]  = i;
+				cls[n]  = (uint8_t)p;
+				id[n++] = (uint16_t)(node_head(&s_node[i], (uint8_t)p)->f.id & 0x7FFU);
+			}
+		}
+		for (int b = 10; b >= 0 && n > 1U; b--) {
+			uint16_t bus = 1U;
+			for (uint16_t k = 0U; k < n; k++) {
+				bus &= (uint16_t)((id[k] >> b) & 1U);
+			}
+			uint16_t m = 0U;
+			for (uint16_t k = 0U; k < n; k++) {
+				if (((id[k] >> b) & 1U) == bus) {       /* récessif sur bus dominant : perd, repasse en réception */
+					who[m]  = who[k];
+					cls[m]  = cls[k];
+					id[m++] = id[k];
+				}
+			}
+			n = m;
+		}
+		if (n > 1U) {
+			s_stats.id_clashes++;                       /* erreur de bit en données sur cible ; ici le premier noeud passe */
+		}
+
+		uint32_t stuff;
+		uint32_t bits = CanBus_FrameBits(&node_head(&s_node[who[0]], cls[0])->f, &stuff);
+		s_free_ns     = start + (uint64_t)bits * BUS_BIT_NS;
+		node_done(who[0], cls[0], s_free_ns - CANBUS_IFS_BITS * BUS_BIT_NS);
+
+		s_stats.frames++;
+		s_stats.busy_bits  += bits;
+		s_stats.stuff_bits += stuff;
+		s_stats.now_us      = s_free_ns / 1000U;
+	}
+	if (t_end > s_run_ns) {
+		s_run_ns = t_end;
+	}
+}
+
+void CanBus_SimGetStats(canbus_stats_t *st)
+{
+	uint64_t span = (s_free_ns > s_run_ns) ? s_free_ns : s_run_ns;
+
+	*st = s_stats;
+	st->util_pm = (span > 0U) ? (uint16_t)(s_stats.busy_bits * BUS_BIT_NS * 1000U / span) : 0U;
+}
+
+void CanBus_SimGetNodeStats(uint16_t node, canbus_node_stats_t *st)
+{
+	if (node >= s_nodes) {
+		memset(st, 0, sizeof(*st));
+		return;
+	}
+	const uint32_t *h = s_hist[node];
+	uint32_t        n = s_node[node].st.sent;
+	uint32_t        acc = 0U;
+	uint32_t        p50 = (n + 1U) / 2U, p90 = n - n / 10U, p99 = n - n / 100U;
+
+	*st = s_node[node].st;
+	for (uint32_t b = 0U; b < CANBUS_HIST_BINS && acc < n; b++) {
+		uint32_t edge = (b + 1U) * CANBUS_HIST_US;
+		acc += h[b];
+		if (st->lat_p50_us == 0U && acc >= p50) {
+			st->lat_p50_us = edge;
+		}
+		if (st->lat_p90_us == 0U && acc >= p90) {
+			st->lat_p90_us = edge;
+		}
+		if (st->lat_p99_us == 0U && acc >= p99) {
+			st->lat_p99_us = edge;
+		}
+	}
+	/* Dernière classe ouverte ; jamais au-delà du max exact */
+	st->lat_p50_us = (st->lat_p50_us > st->lat_max_us) ? st->lat_max_us : st->lat_p50_us;
+	st->lat_p90_us = (st->lat_p90_us > st->lat_max_us) ? st->lat_max_us : st->lat_p90_us;
+	st->lat_p99_us = (st->lat_p99_us > st->lat_max_us) ? st->lat_max_us : st->lat_p99_us;
+}
+
+#endif /* SIM_TARGET */
@@ -0,0 +1,239 @@
+/**
+ * @file    can_load.c
+ * @brief   Charge bus CAN simulée, même cadence que task_can : acquisition
+ *          à PERIOD_ACQ_MS, évaluation à PERIOD_CAN_MS, phases tirées au
+ *          hasard par noeud.
+ *          - SimRun : chaque noeud déroulé seul sur toute la durée (charge
+ *            offerte : les noeuds ne s'influencent pas sur le nombre de trames) ;
+ *          - SimRunBus : tous les noeuds ensemble, ms par ms, sur le bus
+ *            virtuel de can_bus (arbitrage, files pleines, latences).
+ *          Modèle après filtrage task_proc : cycle compresseur triangulaire
+ *          2,5..3,5 °C, porte ouverte ~1 fois / 10 min (20..60 s, surchauffe
+ *          et HR qui montent puis retombent), bruit résiduel de quelques LSB.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "can_load.h"
+
+#if SIM_TARGET
+
+#include "can_bus.h"
+#include <string.h>
+
+#define LOAD_CYC_MIN_Q8      (250 * 256)     /* cycle compresseur, centi-°C Q8 */
+#define LOAD_CYC_MAX_Q8      (350 * 256)
+#define LOAD_CYC_SLOPE_Q8    43              /* ~0,17 centi-°C/s : demi-cycle de 10 min */
+#define LOAD_DOOR_ODDS       600U            /* une chance sur 600 par seconde */
+#define LOAD_DOOR_RISE_cC    4               /* par seconde porte ouverte */
+#define LOAD_DOOR_MAX_cC     300
+
+#define LOAD_EVT_ALARM      0x01U           /* EVT_SYS_ALARM_ACTIVE */
+#define LOAD_EVT_DOOR       0x04U           /* EVT_SYS_DOOR_OPEN */
+
+typedef struct {
+	uint8_t       id;            /* NodeID */
+	uint32_t      t_acq;         /* prochaine acquisition */
+	uint32_t      t_can;         /* prochaine évaluation de la télémétrie */
+	canp_report_t rep;
+	canp_state_t  st;
+	uint32_t      rng;
+	int32_t       cyc_q8;
+	int32_t       dir;
+	uint32_t      door_left;     /* secondes d'ouverture restantes */
+	int32_t       door_cC;       /* surchauffe due à la porte */
+} load_node_t;
+
+/* ---------- État (scope fichier) ---------- */
+static load_node_t s_node[CANLOAD_NODES_MAX];   /* SimRunBus : noeuds déroulés ensemble */
+
+static inline bool due(uint32_t now, uint32_t t)
+{
+	return (int32_t)(now - t) >= 0;
+}
+
+/* xorshift32 : suite reproductible par noeud */
+static uint32_t rnd(load_node_t *n)
+{
+	uint32_t x = n->rng;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	n->rng = x;
+	return x;
+}
+
+static int32_t noise(load_node_t *n, uint32_t amp)
+{
+	return (int32_t)(rnd(n) % (2U * amp + 1U)) - (int32_t)amp;
+}
+
+/* Une acquisition : bits LOAD_EVT_* changés (trame alarme), 0 sinon */
+static uint8_t load_acquire(load_node_t *n, uint32_t now)
+{
+	telem_t *t     = &n->st.t;
+	uint8_t  door  = t->door;
+	uint8_t  flags = t->flags;
+
+	n->cyc_q8 += n->dir * LOAD_CYC_SLOPE_Q8;
+	if (n->cyc_q8 >= LOAD_CYC_MAX_Q8 || n->cyc_q8 <= LOAD_CYC_MIN_Q8) {
+		n->dir = -n->dir;
+	}
+	if (n->door_left == 0U && rnd(n) % LOAD_DOOR_ODDS == 0U) {
+		n->door_left = 20U + rnd(n) % 41U;
+	}
+	if (n->door_left > 0U) {
+		n->door_left--;
+		n->door_cC += LOAD_DOOR_RISE_cC;
+		if (n->door_cC > LOAD_DOOR_MAX_cC) {
+			n->door_cC = LOAD_DOOR_MAX_cC;
+		}
+	} else {
+		n->door_cC = (n->door_cC * 15) / 16;
+	}
+
+	t->ts_ms   = now;
+	t->t_cC    = (int16_t)(n->cyc_q8 / 256 + n->door_cC + noise(n, 2U));
+	t->rh_pm   = (uint16_t)(550 + n->door_cC / 2 + noise(n, 3U));
+	t->tmcu_cC = (int16_t)(3000 + noise(n, 8U));
+	t->vin_mV  = (uint16_t)(12000 + noise(n, 15U));
+	t->door    = (n->door_left > 0U) ? 1U : 0U;
+	t->flags   = 0U;
+	if (t->t_cC > n->st.thigh_cC) {
+		t->flags |= TELEM_F_T_HIGH;
+	} else if (t->t_cC < n->st.tlow_cC) {
+		t->flags |= TELEM_F_T_LOW;
+	}
+	return (uint8_t)(((t->door != door) ? LOAD_EVT_DOOR : 0U) | ((t->flags != flags) ? LOAD_EVT_ALARM : 0U));
+}
+
+static void load_init(load_node_t *n, const canload_cfg_t *cfg, uint8_t id)
+{
+	memset(n, 0, sizeof(*n));
+	n->id          = id;
+	n->rng         = (cfg->seed ^ (id * 0x9E3779B9UL)) | 1U;
+	n->cyc_q8      = LOAD_CYC_MIN_Q8 + (int32_t)(rnd(n) % (uint32_t)(LOAD_CYC_MAX_Q8 - LOAD_CYC_MIN_Q8));
+	n->dir         = (rnd(n) & 1U) ? 1 : -1;
+	n->st.thigh_cC = TEMP_HIGH_cC;
+	n->st.tlow_cC  = TEMP_LOW_cC;
+	n->st.hyst_cC  = TEMP_HYST_cC;
+	n->t_can       = rnd(n) % PERIOD_CAN_MS;
+	n->t_acq       = rnd(n) % PERIOD_ACQ_MS;
+	(void)load_acquire(n, n->t_acq);
+	n->t_acq      += PERIOD_ACQ_MS;
+	CanProto_ReportInit(&n->rep, cfg->mode, id, n->t_can);
+}
+
+/* Trame alarme de task_can : bits changés, nouvel état, état courant, TLV TEMP + FLAGS */
+static void load_alarm_frame(load_node_t *n, uint8_t changed, can_frame_t *f)
+{
+	uint8_t state = (uint8_t)(((n->st.t.flags & (TELEM_F_T_HIGH | TELEM_F_T_LOW)) != 0U ? LOAD_EVT_ALARM : 0U) |
+	                          ((n->st.t.door != 0U) ? LOAD_EVT_DOOR : 0U));
+
+	f->id      = CANP_ID(CANP_FN_ALARM, n->id);
+	f->data[0] = changed;
+	f->data[1] = (uint8_t)(state & changed);
+	f->data[2] = state;
+	f->dlc     = 3U;
+	(void)CanProto_TlvAppend(f, &n->st, TELEM_TLV_TEMP);
+	(void)CanProto_TlvAppend(f, &n->st, TELEM_TLV_FLAGS);
+	CanProto_ReportSync(&n->rep);
+}
+
+static void load_finish(const canload_cfg_t *cfg, canload_result_t *res, uint64_t busy_bits)
+{
+	uint64_t frames = (uint64_t)res->frames_telem + res->frames_alarm;
+
+	res->fps_x100 = (uint32_t)(frames * 100000U / cfg->duration_ms);
+	res->load_pm  = (uint16_t)(busy_bits * 1000000U / CAN_BAUD / cfg->duration_ms);
+}
+
+bool CanLoad_SimRun(const canload_cfg_t *cfg, canload_result_t *res)
+{
+	uint64_t busy_bits = 0U;
+
+	if (cfg->nodes == 0U || cfg->nodes > CANLOAD_NODES_MAX || cfg->duration_ms == 0U) {
+		return false;
+	}
+	memset(res, 0, sizeof(*res));
+
+	for (uint16_t node = 1U; node <= cfg->nodes; node++) {
+		load_node_t n;
+		can_frame_t f[CANP_TLV_COUNT];
+
+		load_init(&n, cfg, (uint8_t)node);
+		for (; n.t_can < cfg->duration_ms; n.t_can += PERIOD_CAN_MS) {
+			while (due(n.t_can, n.t_acq)) {
+				uint8_t ev = load_acquire(&n, n.t_acq);
+				if (ev != 0U) {
+					load_alarm_frame(&n, ev, &f[0]);
+					busy_bits += CanBus_FrameBits(&f[0], NULL);
+					res->frames_alarm++;
+				}
+				n.t_acq += PERIOD_ACQ_MS;
+			}
+			size_t k = CanProto_ReportPoll(&n.rep, &n.st, n.t_can, CANP_ID(CANP_FN_TELEM, node), f, CANP_TLV_COUNT);
+			for (size_t i = 0U; i < k; i++) {
+				busy_bits += CanBus_FrameBits(&f[i], NULL);
+			}
+			res->frames_telem += (uint32_t)k;
+		}
+	}
+	load_finish(cfg, res, busy_bits);
+	return true;
+}
+
+bool CanLoad_SimRunBus(const canload_cfg_t *cfg, canload_result_t *res)
+{
+	canbus_stats_t bs;
+
+	if (cfg->duration_ms == 0U || !CanBus_SimInit(cfg->nodes)) {
+		return false;
+	}
+	memset(res, 0, sizeof(*res));
+	for (uint16_t i = 0U; i < cfg->nodes; i++) {
+		load_init(&s_node[i], cfg, (uint8_t)(i + 1U));
+	}
+
+	for (uint32_t t = 0U; t < cfg->duration_ms; t++) {
+		CanBus_SimRunUntil((uint64_t)t * 1000U);
+		for (uint16_t i = 0U; i < cfg->nodes; i++) {
+			load_node_t *n = &s_node[i];
+			can_frame_t  f[CANP_TLV_COUNT];
+
+			if (due(t, n->t_acq)) {
+				uint8_t ev = load_acquire(n, t);
+				n->t_acq += PERIOD_ACQ_MS;
+				if (ev != 0U) {
+					load_alarm_frame(n, ev, &f[0]);
+					(void)CanBus_SimSend(i, CANTX_PRIO_ALARM, &f[0], (uint64_t)t * 1000U);
+					res->frames_alarm++;
+				}
+			}
+			if (due(t, n->t_can)) {
+				n->t_can += PERIOD_CAN_MS;
+				size_t k = CanProto_ReportPoll(&n->rep, &n->st, t, CANP_ID(CANP_FN_TELEM, n->id), f, CANP_TLV_COUNT);
+				for (size_t j = 0U; j < k; j++) {
+					if (!CanBus_SimSend(i, CANTX_PRIO_TELEM, &f[j], (uint64_t)t * 1000U)) {
+						CanProto_TlvForget(&n->rep.tlv);    /* comme task_can : tout l'état au cycle suivant */
+					}
+				}
+				res->frames_telem += (uint32_t)k;
+			}
+		}
+	}
+	CanBus_SimRunUntil((uint64_t)cfg->duration_ms * 1000U);
+
+	for (uint16_t i = 0U; i < cfg->nodes; i++) {
+		canbus_node_stats_t ns;
+		CanBus_SimGetNodeStats(i, &ns);
+		res->lost += ns.lost;
+	}
+	CanBus_SimGetStats(&bs);
+	res->fps_x100 = (uint32_t)((uint64_t)bs.frames * 100000U / cfg->duration_ms);
+	res->load_pm  = bs.util_pm;
+	return true;
+}
+
+#endif /* SIM_TARGET */
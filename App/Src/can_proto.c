@@ -0,0 +1,701 @@
+/**
+ * @file    can_proto.c
+ * @brief   Protocole CAN SCN : transfert segmenté type ISO-TP.
+ *          SF (0x0L) : message <= 7 octets en une trame.
+ *          FF (0x1LLL) puis CF (0x2N) : 6 + 7 octets par trame, SN modulo 16.
+ *          FC (0x3S BS STmin) : le récepteur cadence l'émetteur par blocs.
+ *          Les transferts partent sur un ID de fonction plus haut que la
+ *          télémétrie : ils perdent l'arbitrage et ne la retardent jamais
+ *          de plus d'une trame ; STmin borne leur charge bus.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "can_proto.h"
+#include "logger.h"
+#include <string.h>
+
+/* PCI (nibble haut de l'octet 0) */
+#define CANP_PCI_SF     0x0U
+#define CANP_PCI_FF     0x1U
+#define CANP_PCI_CF     0x2U
+#define CANP_PCI_FC     0x3U
+
+/* Flow status */
+#define CANP_FS_CTS     0x0U
+#define CANP_FS_WAIT    0x1U
+#define CANP_FS_OVFLW   0x2U
+
+/* Préfixe du module : CF_DATA existe déjà dans stm32_hal_legacy.h */
+#define CANP_SF_MAX     7U
+#define CANP_FF_DATA    6U
+#define CANP_CF_DATA    7U
+
+/* Echéance atteinte (compteur ms libre, débordement toléré) */
+static inline bool due(uint32_t now, uint32_t t)
+{
+	return (int32_t)(now - t) >= 0;
+}
+
+static void frame_init(can_frame_t *f, uint32_t id)
+{
+	f->id  = id;
+	f->dlc = 8U;
+	memset(f->data, CANP_PAD, sizeof(f->data));
+}
+
+/* STmin : 0x00..0x7F en ms, 0xF1..0xF9 en centaines de µs (arrondi à 1 tick), réservé = max */
+static uint8_t stmin_ms(uint8_t st)
+{
+	if (st <= 0x7FU) {
+		return st;
+	}
+	return (st >= 0xF1U && st <= 0xF9U) ? 1U : 0x7FU;
+}
+
+/* ---------- Emission ---------- */
+bool CanProto_XferBegin(canp_tx_t *tx, uint32_t id, const uint8_t *msg, size_t len, uint32_t now_ms)
+{
+	if (len == 0U || len > CANP_XFER_MAX_LEN) {
+		tx->state = CANP_X_ABORT;
+		return false;
+	}
+	tx->msg    = msg;
+	tx->len    = (uint16_t)len;
+	tx->pos    = 0U;
+	tx->id     = id;
+	tx->sn     = 1U;
+	tx->bs     = 0U;
+	tx->bs_cnt = 0U;
+	tx->st_ms  = CANP_XFER_STMIN_MS;
+	tx->wft    = 0U;
+	tx->t_due  = now_ms;
+	tx->state  = CANP_X_BUSY;
+	return true;
+}
+
+bool CanProto_XferPoll(canp_tx_t *tx, uint32_t now_ms, can_frame_t *out)
+{
+	if (tx->state == CANP_X_WAIT_FC && due(now_ms, tx->t_due)) {
+		tx->state = CANP_X_ABORT;                       /* N_Bs : récepteur muet */
+	}
+	if (tx->state != CANP_X_BUSY || !due(now_ms, tx->t_due)) {
+		return false;
+	}
+
+	frame_init(out, tx->id);
+	if (tx->pos == 0U && tx->len <= CANP_SF_MAX) {
+		out->data[0] = (uint8_t)((CANP_PCI_SF << 4) | tx->len);
+		memcpy(&out->data[1], tx->msg, tx->len);
+		tx->pos   = tx->len;
+		tx->state = CANP_X_DONE;
+		return true;
+	}
+	if (tx->pos == 0U) {
+		out->data[0] = (uint8_t)((CANP_PCI_FF << 4) | (tx->len >> 8));
+		out->data[1] = (uint8_t)tx->len;
+		memcpy(&out->data[2], tx->msg, CANP_FF_DATA);
+		tx->pos   = CANP_FF_DATA;
+		tx->state = CANP_X_WAIT_FC;                     /* 1re FC obligatoire */
+		tx->t_due = now_ms + CANP_XFER_TIMEOUT_MS;
+		return true;
+	}
+
+	size_t n = (size_t)(tx->len - tx->pos);
+	if (n > CANP_CF_DATA) {
+		n = CANP_CF_DATA;
+	}
+	out->data[0] = (uint8_t)((CANP_PCI_CF << 4) | tx->sn);
+	memcpy(&out->data[1], &tx->msg[tx->pos], n);
+	tx->pos = (uint16_t)(tx->pos + n);
+	tx->sn  = (uint8_t)((tx->sn + 1U) & 0x0FU);
+
+	if (tx->pos == tx->len) {
+		tx->state = CANP_X_DONE;
+	} else if (tx->bs != 0U && --tx->bs_cnt == 0U) {
+		tx->state = CANP_X_WAIT_FC;
+		tx->t_due = now_ms + CANP_XFER_TIMEOUT_MS;
+	} else {
+		tx->t_due = now_ms + tx->st_ms;
+	}
+	return true;
+}
+
+void CanProto_XferOnFc(canp_tx_t *tx, const can_frame_t *fc, uint32_t now_ms)
+{
+	if (tx->state != CANP_X_WAIT_FC || fc->dlc < 3U || (fc->data[0] >> 4) != CANP_PCI_FC) {
+		return;
+	}
+	switch (fc->data[0] & 0x0FU) {
+	case CANP_FS_CTS:
+		tx->bs     = fc->data[1];
+		tx->bs_cnt = fc->data[1];
+		tx->st_ms  = stmin_ms(fc->data[2]);
+		if (tx->st_ms < CANP_XFER_STMIN_MS) {
+			tx->st_ms = CANP_XFER_STMIN_MS;             /* plancher local : part de bus laissée à la télémétrie */
+		}
+		tx->wft   = 0U;
+		tx->t_due = now_ms;
+		tx->state = CANP_X_BUSY;
+		break;
+	case CANP_FS_WAIT:
+		if (++tx->wft > CANP_XFER_WFT_MAX) {
+			tx->state = CANP_X_ABORT;
+		} else {
+			tx->t_due = now_ms + CANP_XFER_TIMEOUT_MS;
+		}
+		break;
+	default:
+		tx->state = CANP_X_ABORT;                       /* OVFLW ou FS invalide */
+		break;
+	}
+}
+
+/* ---------- Réception ---------- */
+static void fc_build(const canp_rx_t *rx, can_frame_t *fc, uint8_t fs)
+{
+	frame_init(fc, rx->fc_id);
+	fc->data[0] = (uint8_t)((CANP_PCI_FC << 4) | fs);
+	fc->data[1] = CANP_XFER_BS;
+	fc->data[2] = CANP_XFER_STMIN_MS;
+}
+
+void CanProto_RxBegin(canp_rx_t *rx, uint32_t fc_id, uint8_t *buf, size_t cap)
+{
+	rx->buf    = buf;
+	rx->cap    = (uint16_t)((cap > CANP_XFER_MAX_LEN) ? CANP_XFER_MAX_LEN : cap);
+	rx->len    = 0U;
+	rx->pos    = 0U;
+	rx->fc_id  = fc_id;
+	rx->sn     = 0U;
+	rx->bs_cnt = 0U;
+	rx->t_due  = 0U;
+	rx->state  = CANP_X_IDLE;
+}
+
+canp_xstate_t CanProto_RxFrame(canp_rx_t *rx, const can_frame_t *in, uint32_t now_ms,
+                               can_frame_t *fc, bool *send_fc)
+{
+	*send_fc = false;
+	if (in->dlc < 1U) {
+		return rx->state;
+	}
+	uint8_t pci = (uint8_t)(in->data[0] >> 4);
+
+	/* SF/FF : nouveau message, un transfert en cours est abandonné (comme ISO 15765-2) */
+	if (pci == CANP_PCI_SF) {
+		size_t n = in->data[0] & 0x0FU;
+		if (n == 0U || n > CANP_SF_MAX || n + 1U > in->dlc || n > rx->cap) {
+			rx->state = CANP_X_ABORT;
+			return rx->state;
+		}
+		memcpy(rx->buf, &in->data[1], n);
+		rx->len   = (uint16_t)n;
+		rx->pos   = (uint16_t)n;
+		rx->state = CANP_X_DONE;
+		return rx->state;
+	}
+	if (pci == CANP_PCI_FF) {
+		size_t n = ((size_t)(in->data[0] & 0x0FU) << 8) | in->data[1];
+		if (in->dlc < 8U || n <= CANP_SF_MAX) {
+			rx->state = CANP_X_ABORT;
+			return rx->state;
+		}
+		if (n > rx->cap) {
+			fc_build(rx, fc, CANP_FS_OVFLW);
+			*send_fc  = true;
+			rx->state = CANP_X_ABORT;
+			return rx->state;
+		}
+		memcpy(rx->buf, &in->data[2], CANP_FF_DATA);
+		rx->len    = (uint16_t)n;
+		rx->pos    = CANP_FF_DATA;
+		rx->sn     = 1U;
+		rx->bs_cnt = CANP_XFER_BS;
+		rx->t_due  = now_ms + CANP_XFER_TIMEOUT_MS;
+		rx->state  = CANP_X_BUSY;
+		fc_build(rx, fc, CANP_FS_CTS);
+		*send_fc = true;
+		return rx->state;
+	}
+	if (pci != CANP_PCI_CF || rx->state != CANP_X_BUSY) {
+		return rx->state;                               /* FC ou CF hors transfert : ignorée */
+	}
+
+	if ((in->data[0] & 0x0FU) != rx->sn) {
+		rx->state = CANP_X_ABORT;                       /* CF perdue */
+		return rx->state;
+	}
+	size_t n = (size_t)(rx->len - rx->pos);
+	if (n > CANP_CF_DATA) {
+		n = CANP_CF_DATA;
+	}
+	if (n + 1U > in->dlc) {
+		rx->state = CANP_X_ABORT;
+		return rx->state;
+	}
+	memcpy(&rx->buf[rx->pos], &in->data[1], n);
+	rx->pos = (uint16_t)(rx->pos + n);
+	rx->sn  = (uint8_t)((rx->sn + 1U) & 0x0FU);
+	rx->t_due = now_ms + CANP_XFER_TIMEOUT_MS;
+
+	if (rx->pos == rx->len) {
+		rx->state = CANP_X_DONE;
+	} else if (CANP_XFER_BS != 0U && --rx->bs_cnt == 0U) {
+		rx->bs_cnt = CANP_XFER_BS;
+		fc_build(rx, fc, CANP_FS_CTS);
+		*send_fc = true;
+	}
+	return rx->state;
+}
+
+canp_xstate_t CanProto_RxPoll(canp_rx_t *rx, uint32_t now_ms)
+{
+	if (rx->state == CANP_X_BUSY && due(now_ms, rx->t_due)) {
+		rx->state = CANP_X_ABORT;                       /* N_Cr : émetteur muet */
+	}
+	return rx->state;
+}
+
+/* ---------- Export journal ---------- */
+void CanProto_ExportBegin(canp_export_t *ex, uint32_t now_ms)
+{
+	ex->cursor   = 0U;
+	ex->segs     = 0U;
+	ex->active   = true;
+	ex->eot      = false;
+	ex->err      = SCN_OK;
+	ex->tx.state = CANP_X_IDLE;
+	ex->tx.t_due = now_ms;
+}
+
+bool CanProto_ExportPoll(canp_export_t *ex, uint32_t now_ms, can_frame_t *out)
+{
+	if (!ex->active) {
+		return false;
+	}
+	if (ex->tx.state == CANP_X_ABORT || (ex->tx.state == CANP_X_DONE && ex->eot)) {
+		ex->active = false;                             /* fin d'export ou gateway muette */
+		return false;
+	}
+	if (ex->tx.state == CANP_X_IDLE || ex->tx.state == CANP_X_DONE) {
+		/* Segment suivant ; l'écart STmin vaut aussi entre deux messages */
+		if (!due(now_ms, ex->tx.t_due)) {
+			return false;
+		}
+		size_t    len;
+		scn_err_t err = Logger_ExportSegment(&ex->cursor, ex->msg, sizeof(ex->msg), &len);
+		if (err != SCN_OK) {
+			ex->err    = err;                           /* pas d'EOT : la gateway ne prend pas un échec pour la fin */
+			ex->active = false;
+			return false;
+		}
+		if (len == 0U) {
+			ex->msg[0] = CANP_EXPORT_EOT;
+			len        = 1U;
+			ex->eot    = true;
+		} else {
+			ex->segs++;
+		}
+		(void)CanProto_XferBegin(&ex->tx, CANP_ID(CANP_FN_XFER_TX, NODE_ID), ex->msg, len, now_ms);
+	}
+
+	bool sent = CanProto_XferPoll(&ex->tx, now_ms, out);
+	if (sent && ex->tx.state == CANP_X_DONE) {
+		ex->tx.t_due = now_ms + ex->tx.st_ms;
+	}
+	return sent;
+}
+
+void CanProto_ExportOnFc(canp_export_t *ex, const can_frame_t *fc, uint32_t now_ms)
+{
+	if (ex->active && fc->id == CANP_ID(CANP_FN_XFER_RX, NODE_ID)) {
+		CanProto_XferOnFc(&ex->tx, fc, now_ms);
+	}
+}
+
+/* ---------- TLV d'état ---------- */
+static const uint8_t k_tlv_ids[CANP_TLV_COUNT] = {
+	TELEM_TLV_TEMP, TELEM_TLV_HUM, TELEM_TLV_TMCU, TELEM_TLV_VIN, TELEM_TLV_DOOR, TELEM_TLV_FLAGS,
+	CANP_TLV_THIGH, CANP_TLV_TLOW, CANP_TLV_HYST,
+};
+
+static inline bool is_thresh(uint8_t id)
+{
+	return (id >= CANP_TLV_THIGH) && (id <= CANP_TLV_HYST);
+}
+
+static size_t tlv_put(const canp_state_t *s, uint8_t id, uint8_t *dst)
+{
+	int16_t v;
+
+	switch (id) {
+	case CANP_TLV_THIGH: v = s->thigh_cC; break;
+	case CANP_TLV_TLOW:  v = s->tlow_cC;  break;
+	case CANP_TLV_HYST:  v = s->hyst_cC;  break;
+	default:             return Telem_TlvPut(&s->t, id, dst);
+	}
+	dst[0] = (uint8_t)v;
+	dst[1] = (uint8_t)((uint16_t)v >> 8);
+	return 2U;
+}
+
+static void tlv_frame_init(can_frame_t *f, uint32_t id)
+{
+	f->id  = id;
+	f->dlc = 0U;
+	memset(f->data, 0, sizeof(f->data));
+}
+
+size_t CanProto_TlvSize(uint8_t id)
+{
+	return is_thresh(id) ? 2U : Telem_TlvSize(id);
+}
+
+/* Valeur codée -> entier (écart aux bandes mortes) */
+static int32_t tlv_int(uint8_t id, const uint8_t *v, size_t n)
+{
+	if (n == 1U) {
+		return v[0];
+	}
+	uint16_t u = (uint16_t)v[0] | ((uint16_t)v[1] << 8);
+	return (id == TELEM_TLV_HUM || id == TELEM_TLV_VIN) ? (int32_t)u : (int32_t)(int16_t)u;
+}
+
+static int tlv_index(uint8_t id)
+{
+	for (int i = 0; i < (int)CANP_TLV_COUNT; i++) {
+		if (k_tlv_ids[i] == id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Champ hors cache, ou valeur courante différente de la dernière émise */
+static bool tlv_moved(const canp_state_t *s, const canp_tlv_cache_t *c, uint8_t id)
+{
+	int     i = tlv_index(id);
+	uint8_t v[CANP_TLV_VAL_MAX];
+	size_t  n = tlv_put(s, id, v);
+
+	return (c->known & (1UL << i)) == 0U || memcmp(v, c->val[i], n) != 0;
+}
+
+void CanProto_TlvForget(canp_tlv_cache_t *c)
+{
+	c->known = 0U;
+}
+
+size_t CanProto_PackTlv(const canp_state_t *s, canp_tlv_cache_t *c, uint32_t mask, canp_pack_t sel,
+                        uint32_t id, can_frame_t *frames, size_t max)
+{
+	size_t nf = 0U;
+
+	/* First-fit décroissant : TLV de 3 octets puis de 2 ; 3+3+2 remplit exactement une trame */
+	for (size_t want = CANP_TLV_VAL_MAX; want >= 1U; want--) {
+		for (uint8_t i = 0U; i < CANP_TLV_COUNT; i++) {
+			uint8_t  tid = k_tlv_ids[i];
+			size_t   n   = CanProto_TlvSize(tid);
+			uint32_t bit = 1UL << i;
+			uint8_t  v[CANP_TLV_VAL_MAX];
+
+			if (n != want || (mask & bit) == 0U) {
+				continue;
+			}
+			(void)tlv_put(s, tid, v);
+			if (sel != CANP_PACK_ALL && (c->known & bit) != 0U) {
+				int32_t  d  = tlv_int(tid, v, n) - tlv_int(tid, c->val[i], n);
+				uint32_t db = (sel == CANP_PACK_DEADBAND) ? c->db[i] : 0U;
+				if ((uint32_t)((d < 0) ? -d : d) <= db) {
+					continue;                           /* dans la bande morte de la dernière émission */
+				}
+			}
+
+			size_t k = 0U;
+			while (k < nf && frames[k].dlc + 1U + n > sizeof(frames[k].data)) {
+				k++;
+			}
+			if (k == nf) {
+				if (nf == max) {
+					continue;                           /* reste « modifié » : cycle suivant */
+				}
+				tlv_frame_init(&frames[nf++], id);
+			}
+			uint8_t *dst = &frames[k].data[frames[k].dlc];
+			dst[0] = tid;
+			memcpy(&dst[1], v, n);
+			frames[k].dlc = (uint8_t)(frames[k].dlc + 1U + n);
+
+			memcpy(c->val[i], v, n);
+			c->known |= bit;
+		}
+	}
+	return nf;
+}
+
+void CanProto_ReportInit(canp_report_t *r, canp_report_mode_t mode, uint8_t node, uint32_t now_ms)
+{
+	memset(r, 0, sizeof(*r));
+	r->mode = mode;
+	r->t_hb = now_ms + PERIOD_CAN_HB_MS + (node & 0x7FU) * (PERIOD_CAN_HB_MS / 128U);   /* 128 créneaux par période */
+	(void)CanProto_ReportSetDeadband(r, TELEM_TLV_TEMP, CAN_DB_TEMP_cC);
+	(void)CanProto_ReportSetDeadband(r, TELEM_TLV_HUM,  CAN_DB_HUM_pm);
+	(void)CanProto_ReportSetDeadband(r, TELEM_TLV_TMCU, CAN_DB_TMCU_cC);
+	(void)CanProto_ReportSetDeadband(r, TELEM_TLV_VIN,  CAN_DB_VIN_mV);
+}
+
+bool CanProto_ReportSetDeadband(canp_report_t *r, uint8_t id, uint16_t db)
+{
+	int i = tlv_index(id);
+
+	if (i < 0 || CanProto_TlvSize(id) < 2U) {
+		return false;                                   /* porte / flags : tout changement est un événement */
+	}
+	r->tlv.db[i] = db;
+	return true;
+}
+
+void CanProto_ReportSync(canp_report_t *r)
+{
+	r->sync = true;
+}
+
+size_t CanProto_ReportPoll(canp_report_t *r, const canp_state_t *s, uint32_t now_ms,
+                           uint32_t id, can_frame_t *frames, size_t max)
+{
+	canp_pack_t sel = CANP_PACK_DEADBAND;
+
+	if (r->mode == CANP_REPORT_PERIODIC) {
+		r->tlv.known &= ~CANP_TLV_TELEM;                /* télémétrie complète, seuils sur changement */
+		sel = CANP_PACK_CHANGED;
+	} else if (due(now_ms, r->t_hb)) {
+		r->t_hb += PERIOD_CAN_HB_MS;
+		if (due(now_ms, r->t_hb)) {
+			r->t_hb = now_ms + PERIOD_CAN_HB_MS;
+		}
+		r->tlv.known = 0U;                              /* heartbeat : état complet */
+	} else if (r->sync || tlv_moved(s, &r->tlv, TELEM_TLV_FLAGS) || tlv_moved(s, &r->tlv, TELEM_TLV_DOOR)) {
+		sel = CANP_PACK_CHANGED;                        /* changement d'état : la gateway voit les valeurs exactes */
+	}
+	r->sync = false;
+	return CanProto_PackTlv(s, &r->tlv, CANP_TLV_ALL, sel, id, frames, max);
+}
+
+bool CanProto_TlvAppend(can_frame_t *f, const canp_state_t *s, uint8_t id)
+{
+	size_t n = CanProto_TlvSize(id);
+
+	if (n == 0U || f->dlc + 1U + n > sizeof(f->data)) {
+		return false;
+	}
+	f->data[f->dlc] = id;
+	f->dlc = (uint8_t)(f->dlc + 1U + tlv_put(s, id, &f->data[f->dlc + 1U]));
+	return true;
+}
+
+bool CanProto_TlvNext(const can_frame_t *f, size_t *pos, uint8_t *id, const uint8_t **val)
+{
+	size_t end = (f->dlc > sizeof(f->data)) ? sizeof(f->data) : f->dlc;
+
+	if (*pos >= end) {
+		return false;
+	}
+	uint8_t tid = f->data[*pos];
+	size_t  n   = CanProto_TlvSize(tid);
+	if (n == 0U || *pos + 1U + n > end) {
+		return false;                                   /* id inconnu ou valeur tronquée : *pos reste dessus */
+	}
+	*id   = tid;
+	*val  = &f->data[*pos + 1U];
+	*pos += 1U + n;
+	return true;
+}
+
+bool CanProto_UnpackTlv(const can_frame_t *f, canp_state_t *s, uint32_t *seen)
+{
+	size_t         pos = 0U;
+	uint8_t        id;
+	const uint8_t *v;
+
+	*seen = 0U;
+	while (CanProto_TlvNext(f, &pos, &id, &v)) {
+		if (is_thresh(id)) {
+			int16_t x = (int16_t)((uint16_t)v[0] | ((uint16_t)v[1] << 8));
+			if (id == CANP_TLV_THIGH) {
+				s->thigh_cC = x;
+			} else if (id == CANP_TLV_TLOW) {
+				s->tlow_cC = x;
+			} else {
+				s->hyst_cC = x;
+			}
+		} else {
+			(void)Telem_TlvGet(&s->t, id, v, CanProto_TlvSize(id));
+		}
+		*seen |= CANP_TLV_BIT(id);
+	}
+	return pos == ((f->dlc > sizeof(f->data)) ? sizeof(f->data) : f->dlc);
+}
+
+/* ---------- Réception : ID consommés et filtres matériels ---------- */
+static const canp_rx_id_t k_rx[] = {
+	{ CANP_FN_CMD,     NODE_ID,         CANP_RX_FIFO_URGENT },
+	{ CANP_FN_CMD,     CANP_NODE_BCAST, CANP_RX_FIFO_URGENT },
+	{ CANP_FN_CFG,     NODE_ID,         CANP_RX_FIFO_NORMAL },
+	{ CANP_FN_CFG,     CANP_NODE_BCAST, CANP_RX_FIFO_NORMAL },
+	{ CANP_FN_XFER_RX, NODE_ID,         CANP_RX_FIFO_NORMAL },   /* FC de l'export */
+};
+
+#define STD_MASK        0x7FFU
+#define F16_IMG(v)      ((uint32_t)(((v) & STD_MASK) << 5))
+#define F16_RTR_IDE     0x0018U             /* masque : RTR et IDE comparés (trame de données standard) */
+
+/* Motif : ID dont seuls les bits de care sont comparés */
+typedef struct {
+	uint16_t val;
+	uint16_t care;
+} pat_t;
+
+static uint8_t free_bits(uint16_t care)
+{
+	uint8_t  n = 0U;
+	uint16_t x = (uint16_t)(~care & STD_MASK);
+	while (x != 0U) {
+		x &= (uint16_t)(x - 1U);
+		n++;
+	}
+	return n;
+}
+
+size_t CanProto_RxTable(const canp_rx_id_t **rows)
+{
+	*rows = k_rx;
+	return sizeof(k_rx) / sizeof(k_rx[0]);
+}
+
+size_t CanProto_FilterBuildFrom(const canp_rx_id_t *rows, size_t n, canp_filter_t *banks, size_t max)
+{
+	size_t used = 0U;
+
+	if (n > CANP_RX_IDS_MAX) {
+		return 0U;
+	}
+	for (uint8_t fifo = CANP_RX_FIFO_URGENT; fifo <= CANP_RX_FIFO_NORMAL; fifo++) {
+		pat_t    pat[CANP_RX_IDS_MAX];
+		uint16_t ids[CANP_RX_IDS_MAX];
+		size_t   np = 0U, nl = 0U, nm = 0U;
+
+		/* ID de la FIFO, sans doublon */
+		for (size_t i = 0U; i < n; i++) {
+			uint16_t id  = (uint16_t)CANP_ID(rows[i].fn, rows[i].node);
+			bool     dup = false;
+			if (rows[i].fifo != fifo) {
+				continue;
+			}
+			for (size_t k = 0U; k < np; k++) {
+				dup = dup || (pat[k].val == id);
+			}
+			if (!dup) {
+				pat[np].val  = id;
+				pat[np].care = STD_MASK;
+				np++;
+			}
+		}
+
+		/* Regroupement exact : deux motifs de même masque qui diffèrent d'un seul bit comparé */
+		bool merged;
+		do {
+			merged = false;
+			for (size_t a = 0U; a < np && !merged; a++) {
+				for (size_t b = a + 1U; b < np && !merged; b++) {
+					uint16_t d = (uint16_t)(pat[a].val ^ pat[b].val);
+					if (pat[a].care == pat[b].care && d != 0U && (d & (d - 1U)) == 0U) {
+						pat[a].care = (uint16_t)(pat[a].care & ~d);
+						pat[a].val  = (uint16_t)(pat[a].val & pat[a].care);
+						pat[b]      = pat[--np];
+						merged      = true;
+					}
+				}
+			}
+		} while (merged);
+
+		/* Masque rentable à partir de 4 ID (2 motifs par banc contre 4 ID listés) */
+		for (size_t k = 0U; k < np; k++) {
+			if (free_bits(pat[k].care) >= 2U) {
+				pat[nm++] = pat[k];                     /* nm <= k : compactage sur place */
+				continue;
+			}
+			uint16_t d = (uint16_t)(~pat[k].care & STD_MASK);
+			ids[nl++]  = pat[k].val;
+			if (d != 0U) {
+				ids[nl++] = (uint16_t)(pat[k].val | d);
+			}
+		}
+
+		/* Cases libres d'un banc : dernière entrée répétée (aucun ID en plus) */
+		for (size_t i = 0U; i < nl; i += 4U) {
+			uint32_t r[4];
+			if (used == max) {
+				return 0U;
+			}
+			for (size_t k = 0U; k < 4U; k++) {
+				r[k] = F16_IMG(ids[(i + k < nl) ? i + k : nl - 1U]);
+			}
+			banks[used].fr1  = r[0] | (r[1] << 16);
+			banks[used].fr2  = r[2] | (r[3] << 16);
+			banks[used].fifo = fifo;
+			banks[used].list = true;
+			used++;
+		}
+		for (size_t i = 0U; i < nm; i += 2U) {
+			const pat_t *m0 = &pat[i];
+			const pat_t *m1 = &pat[(i + 1U < nm) ? i + 1U : i];
+			if (used == max) {
+				return 0U;
+			}
+			banks[used].fr1  = F16_IMG(m0->val) | ((F16_IMG(m0->care) | F16_RTR_IDE) << 16);
+			banks[used].fr2  = F16_IMG(m1->val) | ((F16_IMG(m1->care) | F16_RTR_IDE) << 16);
+			banks[used].fifo = fifo;
+			banks[used].list = false;
+			used++;
+		}
+	}
+	return used;
+}
+
+size_t CanProto_FilterBuild(canp_filter_t *banks, size_t max)
+{
+	return CanProto_FilterBuildFrom(k_rx, sizeof(k_rx) / sizeof(k_rx[0]), banks, max);
+}
+
+bool CanProto_FilterMatch(const canp_filter_t *banks, size_t n, uint32_t id, uint8_t *fifo)
+{
+	uint32_t img = F16_IMG(id);
+
+	for (size_t i = 0U; i < n; i++) {
+		const canp_filter_t *b = &banks[i];
+		uint32_t h0 = b->fr1 & 0xFFFFU, h1 = b->fr1 >> 16;
+		uint32_t h2 = b->fr2 & 0xFFFFU, h3 = b->fr2 >> 16;
+		bool     hit;
+
+		if (b->list) {
+			hit = (img == h0) || (img == h1) || (img == h2) || (img == h3);
+		} else {
+			hit = (((img ^ h0) & h1) == 0U) || (((img ^ h2) & h3) == 0U);
+		}
+		if (hit) {
+			*fifo = b->fifo;
+			return true;
+		}
+	}
+	return false;
+}
+
+void CanProto_FilterHal(const canp_filter_t *bank, canp_filter_hal_t *hal)
+{
+	hal->id_low    = (uint16_t)(bank->fr1 & 0xFFFFU);
+	hal->mask_low  = (uint16_t)(bank->fr1 >> 16);
+	hal->id_high   = (uint16_t)(bank->fr2 & 0xFFFFU);
+	hal->mask_high = (uint16_t)(bank->fr2 >> 16);
+}
@@ -0,0 +1,210 @@
+/**
+ * @file    can_rx.c
+ * @brief   Réception CAN : bancs de filtres bxCAN 16 bits calculés par
+ *          CanProto_FilterBuild (liste exacte ou masque exact), ce que la
+ *          table de can_proto ne déclare pas est écarté sans IT.
+ *          Une file par FIFO (producteur IT, consommateur task_can) : la
+ *          FIFO urgente est toujours vidée avant l'autre.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "can_rx.h"
+
+#if !SIM_TARGET
+  extern CAN_HandleTypeDef CAN_HANDLE;
+  #define RX_DMB()    __DMB()
+#else
+  #define RX_DMB()    __asm__ volatile ("" ::: "memory")
+#endif
+
+typedef char canrx_q_check[((CANRX_Q_LEN & (CANRX_Q_LEN - 1U)) == 0U && CANRX_Q_LEN <= 128U) ? 1 : -1];
+
+/* File mono-producteur / mono-consommateur : head écrit par l'IT, tail par la tâche */
+typedef struct {
+	can_frame_t      buf[CANRX_Q_LEN];
+	volatile uint8_t head;
+	volatile uint8_t tail;
+} rxq_t;
+
+/* ---------- État (scope fichier) ---------- */
+static rxq_t          s_q[2];
+static canrx_stats_t  s_stats;
+static canp_filter_t  s_banks[CANP_FILTER_BANKS_MAX];
+
+static void rx_push(uint8_t fifo, const can_frame_t *f)
+{
+	rxq_t  *q    = &s_q[fifo];
+	uint8_t head = q->head;
+
+	if ((uint8_t)(head - q->tail) == CANRX_Q_LEN) {
+		s_stats.overruns[fifo]++;
+		return;
+	}
+	q->buf[head & (CANRX_Q_LEN - 1U)] = *f;
+	RX_DMB();                                           /* trame visible avant l'index */
+	q->head = (uint8_t)(head + 1U);
+	s_stats.rx[fifo]++;
+}
+
+static bool rx_pop(uint8_t fifo, can_frame_t *f)
+{
+	rxq_t  *q    = &s_q[fifo];
+	uint8_t tail = q->tail;
+
+	if (tail == q->head) {
+		return false;
+	}
+	*f = q->buf[tail & (CANRX_Q_LEN - 1U)];
+	RX_DMB();                                           /* case lue avant de la rendre à l'IT */
+	q->tail = (uint8_t)(tail + 1U);
+	return true;
+}
+
+/* ---------- Accès matériel ---------- */
+#if SIM_TARGET
+
+static size_t   s_nbanks;
+static uint32_t s_rejected;
+
+static scn_err_t hw_init(size_t nbanks)
+{
+	s_nbanks = nbanks;
+	return SCN_OK;
+}
+
+static void rx_rearm(void)
+{
+}
+
+bool CanRx_SimInject(const can_frame_t *f)
+{
+	uint8_t fifo;
+
+	if (!CanProto_FilterMatch(s_banks, s_nbanks, f->id, &fifo)) {
+		s_rejected++;
+		return false;
+	}
+	rx_push(fifo, f);
+	return true;
+}
+
+uint32_t CanRx_SimRejected(void)
+{
+	return s_rejected;
+}
+
+#else /* cible */
+
+static TaskHandle_t   s_wake;
+static uint32_t       s_wake_bits;
+static volatile bool  s_bell;           /* réveil déjà notifié, pas encore vidé */
+
+static scn_err_t hw_init(size_t nbanks)
+{
+	for (size_t i = 0U; i < nbanks; i++) {
+		canp_filter_hal_t h;
+		CanProto_FilterHal(&s_banks[i], &h);
+		CAN_FilterTypeDef fc = {
+			.FilterIdHigh         = h.id_high,
+			.FilterIdLow          = h.id_low,
+			.FilterMaskIdHigh     = h.mask_high,
+			.FilterMaskIdLow      = h.mask_low,
+			.FilterFIFOAssignment = (s_banks[i].fifo == CANP_RX_FIFO_URGENT) ? CAN_FILTER_FIFO0 : CAN_FILTER_FIFO1,
+			.FilterBank           = (uint32_t)i,
+			.FilterMode           = s_banks[i].list ? CAN_FILTERMODE_IDLIST : CAN_FILTERMODE_IDMASK,
+			.FilterScale          = CAN_FILTERSCALE_16BIT,
+			.FilterActivation     = CAN_FILTER_ENABLE,
+			.SlaveStartFilterBank = CANP_FILTER_BANKS_MAX,
+		};
+		if (HAL_CAN_ConfigFilter(&CAN_HANDLE, &fc) != HAL_OK) {
+			return ERR_CAN_INIT;
+		}
+	}
+	if (HAL_CAN_ActivateNotification(&CAN_HANDLE, CAN_IT_RX_FIFO0_MSG_PENDING |
+	                                              CAN_IT_RX_FIFO1_MSG_PENDING) != HAL_OK) {
+		return ERR_CAN_INIT;
+	}
+	return SCN_OK;
+}
+
+static void rx_rearm(void)
+{
+	s_bell = false;
+}
+
+static void rx_drain_hw(uint32_t hw_fifo, uint8_t fifo)
+{
+	CAN_RxHeaderTypeDef h;
+	can_frame_t         f;
+
+	while (HAL_CAN_GetRxFifoFillLevel(&CAN_HANDLE, hw_fifo) > 0U) {
+		if (HAL_CAN_GetRxMessage(&CAN_HANDLE, hw_fifo, &h, f.data) != HAL_OK) {
+			break;
+		}
+		f.id  = h.StdId;
+		f.dlc = (uint8_t)h.DLC;
+		rx_push(fifo, &f);
+	}
+	if (!s_bell && s_wake != NULL) {
+		BaseType_t woken = pdFALSE;
+		(void)xTaskNotifyFromISR(s_wake, s_wake_bits, eSetBits, &woken);
+		s_bell = true;
+		portYIELD_FROM_ISR(woken);
+	}
+}
+
+void CanRx_SetWake(TaskHandle_t task, uint32_t bits)
+{
+	s_wake      = task;
+	s_wake_bits = bits;
+}
+
+/* IT CAN1_RX0 / CAN1_RX1 (FMP) : FIFO matérielle vidée à chaque IT */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+	(void)hcan;
+	rx_drain_hw(CAN_RX_FIFO0, CANP_RX_FIFO_URGENT);
+}
+
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)
+{
+	(void)hcan;
+	rx_drain_hw(CAN_RX_FIFO1, CANP_RX_FIFO_NORMAL);
+}
+
+#endif /* SIM_TARGET */
+
+/* ---------- API ---------- */
+scn_err_t CanRx_Init(void)
+{
+	size_t n = CanProto_FilterBuild(s_banks, CANP_FILTER_BANKS_MAX);
+
+	if (n == 0U) {
+		return ERR_CAN_INIT;                            /* table vide ou trop de bancs */
+	}
+	s_stats.banks = (uint8_t)n;
+	return hw_init(n);
+}
+
+bool CanRx_Get(can_frame_t *f)
+{
+	if (rx_pop(CANP_RX_FIFO_URGENT, f) || rx_pop(CANP_RX_FIFO_NORMAL, f)) {
+		return true;
+	}
+	rx_rearm();                                         /* tout vidé : prochaine trame -> nouveau réveil */
+	/* Trame arrivée entre le dernier pop et le réarmement : servie sans attendre de réveil */
+	return rx_pop(CANP_RX_FIFO_URGENT, f) || rx_pop(CANP_RX_FIFO_NORMAL, f);
+}
+
+void CanRx_GetStats(canrx_stats_t *st)
+{
+#if !SIM_TARGET
+	taskENTER_CRITICAL();           /* copie cohérente face aux IT RX */
+#endif
+	*st = s_stats;
+#if !SIM_TARGET
+	taskEXIT_CRITICAL();
+#endif
+}
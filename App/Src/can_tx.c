@@ -0,0 +1,345 @@
+/**
+ * @file    can_tx.c
+ * @brief   Ordonnanceur des mailboxes TX bxCAN.
+ *          Chaque classe a sa file circulaire ; au plus une trame par classe
+ *          occupe une mailbox. La bxCAN (TXFP = 0) émet la mailbox d'ID le
+ *          plus bas : l'alarme passe devant la télémétrie, qui passe devant
+ *          l'export, sans jamais inverser deux trames d'une même classe
+ *          (même ID : départage par numéro de mailbox, pas par âge).
+ *          Rechargement dans l'IT de fin d'émission (RQCP), ou dans Send
+ *          quand la classe n'a rien en vol.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "can_tx.h"
+
+#if !SIM_TARGET
+  #include "FreeRTOS.h"
+  #include "task.h"
+  extern CAN_HandleTypeDef CAN_HANDLE;
+  #define TX_LOCK()      taskENTER_CRITICAL()     /* masque l'IT TX (priorité 5) */
+  #define TX_UNLOCK()    taskEXIT_CRITICAL()
+#else
+  #define TX_LOCK()      do { } while (0)         /* mono-fil : l'« IT » tourne dans CanTx_SimAdvance */
+  #define TX_UNLOCK()    do { } while (0)
+#endif
+
+#define MB_NONE          0xFFU
+
+/* Index de file sur 8 bits */
+typedef char cantx_q_check[(CANTX_Q_ALARM <= 255 && CANTX_Q_TELEM <= 255 && CANTX_Q_BULK <= 255 &&
+                            CANTX_Q_ALARM > 0 && CANTX_Q_TELEM > 0 && CANTX_Q_BULK > 0) ? 1 : -1];
+/* Une mailbox par classe en vol : les classes ne se bloquent jamais entre elles */
+typedef char cantx_mb_check[(CANTX_PRIO_COUNT <= CANTX_MAILBOXES) ? 1 : -1];
+
+typedef struct {
+	can_frame_t *buf;
+	uint8_t      cap;
+	uint8_t      head;      /* plus ancienne trame en attente */
+	uint8_t      count;
+	uint8_t      mb;        /* mailbox de la trame en vol (MB_NONE : aucune) */
+} txq_t;
+
+/* ---------- État (scope fichier) ---------- */
+static can_frame_t   s_bufAlarm[CANTX_Q_ALARM];
+static can_frame_t   s_bufTelem[CANTX_Q_TELEM];
+static can_frame_t   s_bufBulk[CANTX_Q_BULK];
+
+static txq_t s_q[CANTX_PRIO_COUNT] = {
+	{ s_bufAlarm, CANTX_Q_ALARM, 0U, 0U, MB_NONE },
+	{ s_bufTelem, CANTX_Q_TELEM, 0U, 0U, MB_NONE },
+	{ s_bufBulk,  CANTX_Q_BULK,  0U, 0U, MB_NONE },
+};
+static uint8_t       s_mb_prio[CANTX_MAILBOXES] = { MB_NONE, MB_NONE, MB_NONE };
+static cantx_stats_t s_stats;
+
+/* ---------- Accès matériel ---------- */
+#if SIM_TARGET
+
+static struct {
+	bool        used;
+	can_frame_t f;
+} s_mbx[CANTX_MAILBOXES];
+
+static uint64_t         s_now_us;
+static uint64_t         s_bus_free_us;              /* fin de l'occupation bus en cours */
+static uint8_t          s_on_bus = MB_NONE;         /* mailbox en cours d'émission */
+static uint64_t         s_on_bus_end_us;
+static cantx_sim_sink_t s_sink;
+
+static void tx_done(uint8_t mb, bool ok);
+
+/* Arbitrage : ID le plus bas, puis numéro de mailbox le plus bas */
+static void sim_start(void)
+{
+	uint8_t best = MB_NONE;
+
+	for (uint8_t i = 0U; i < CANTX_MAILBOXES; i++) {
+		if (s_mbx[i].used && (best == MB_NONE || s_mbx[i].f.id < s_mbx[best].f.id)) {
+			best = i;
+		}
+	}
+	if (best != MB_NONE) {
+		s_on_bus        = best;
+		s_on_bus_end_us = s_now_us + CanTx_SimFrameUs(s_mbx[best].f.dlc);
+	}
+}
+
+static bool hw_submit(const can_frame_t *f, uint8_t *mb)
+{
+	for (uint8_t i = 0U; i < CANTX_MAILBOXES; i++) {
+		if (!s_mbx[i].used) {
+			s_mbx[i].used = true;
+			s_mbx[i].f    = *f;
+			*mb           = i;
+			if (s_on_bus == MB_NONE && s_bus_free_us <= s_now_us) {
+				sim_start();                            /* bus libre : SOF immédiat */
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+static scn_err_t hw_init(void)
+{
+	for (uint8_t i = 0U; i < CANTX_MAILBOXES; i++) {
+		s_mbx[i].used = false;
+	}
+	s_on_bus = MB_NONE;
+	return SCN_OK;
+}
+
+uint32_t CanTx_SimFrameUs(uint8_t dlc)
+{
+	/* Trame standard : 44 + 8n bits, intermission 3 bits, bourrage max sur SOF..CRC (34 + 8n bits) */
+	uint32_t bits = 47U + 8U * dlc + (34U + 8U * dlc - 1U) / 4U;
+	return (uint32_t)((bits * 1000000ULL + CAN_BAUD - 1U) / CAN_BAUD);
+}
+
+void CanTx_SimSetSink(cantx_sim_sink_t sink)
+{
+	s_sink = sink;
+}
+
+void CanTx_SimBusBusy(uint32_t us)
+{
+	uint64_t from = (s_on_bus != MB_NONE) ? s_on_bus_end_us : s_now_us;
+
+	if (from + us > s_bus_free_us) {
+		s_bus_free_us = from + us;
+	}
+}
+
+void CanTx_SimAdvance(uint32_t us)
+{
+	uint64_t end = s_now_us + us;
+
+	for (;;) {
+		if (s_on_bus == MB_NONE) {
+			bool pending = s_mbx[0].used || s_mbx[1].used || s_mbx[2].used;
+			if (!pending || s_bus_free_us > end) {
+				break;
+			}
+			if (s_bus_free_us > s_now_us) {
+				s_now_us = s_bus_free_us;               /* trame étrangère terminée : arbitrage */
+			}
+			sim_start();
+		}
+		if (s_on_bus_end_us > end) {
+			break;
+		}
+		uint8_t mb    = s_on_bus;
+		s_now_us      = s_on_bus_end_us;
+		s_bus_free_us = s_now_us;
+		s_on_bus      = MB_NONE;
+		s_mbx[mb].used = false;
+		if (s_sink != NULL) {
+			s_sink(&s_mbx[mb].f, s_now_us);
+		}
+		tx_done(mb, true);                              /* « IT » RQCP : recharge */
+	}
+	s_now_us = end;
+}
+
+uint64_t CanTx_SimNowUs(void)
+{
+	return s_now_us;
+}
+
+#else /* cible */
+
+static void tx_done(uint8_t mb, bool ok);
+
+static bool hw_submit(const can_frame_t *f, uint8_t *mb)
+{
+	CAN_TxHeaderTypeDef h = {
+		.StdId              = f->id,
+		.ExtId              = 0U,
+		.IDE                = CAN_ID_STD,
+		.RTR                = CAN_RTR_DATA,
+		.DLC                = f->dlc,
+		.TransmitGlobalTime = DISABLE,
+	};
+	uint32_t box;
+
+	if (HAL_CAN_AddTxMessage(&CAN_HANDLE, &h, (uint8_t *)f->data, &box) != HAL_OK) {
+		return false;
+	}
+	*mb = (uint8_t)((box == CAN_TX_MAILBOX0) ? 0U : ((box == CAN_TX_MAILBOX1) ? 1U : 2U));
+	return true;
+}
+
+static scn_err_t hw_init(void)
+{
+	if (HAL_CAN_ActivateNotification(&CAN_HANDLE, CAN_IT_TX_MAILBOX_EMPTY) != HAL_OK ||
+	    HAL_CAN_Start(&CAN_HANDLE) != HAL_OK) {
+		return ERR_CAN_INIT;
+	}
+	return SCN_OK;
+}
+
+/* IT CAN1_TX (RQCP) : TXOK, ou annulation */
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) { (void)hcan; tx_done(0U, true);  }
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) { (void)hcan; tx_done(1U, true);  }
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) { (void)hcan; tx_done(2U, true);  }
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan)    { (void)hcan; s_stats.aborts++; tx_done(0U, false); }
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan)    { (void)hcan; s_stats.aborts++; tx_done(1U, false); }
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan)    { (void)hcan; s_stats.aborts++; tx_done(2U, false); }
+
+/* ALST/TERR : n'arrivent qu'en mode sans retransmission (NART), mailbox libérée par la HAL */
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
+{
+	static const uint32_t k_err[CANTX_MAILBOXES] = {
+		HAL_CAN_ERROR_TX_ALST0 | HAL_CAN_ERROR_TX_TERR0,
+		HAL_CAN_ERROR_TX_ALST1 | HAL_CAN_ERROR_TX_TERR1,
+		HAL_CAN_ERROR_TX_ALST2 | HAL_CAN_ERROR_TX_TERR2,
+	};
+	uint32_t err = HAL_CAN_GetError(hcan);
+
+	for (uint8_t i = 0U; i < CANTX_MAILBOXES; i++) {
+		if ((err & k_err[i]) != 0U) {
+			s_stats.tx_errors++;
+			tx_done(i, false);
+		}
+	}
+	(void)HAL_CAN_ResetError(hcan);
+}
+
+#endif /* SIM_TARGET */
+
+/* ---------- Ordonnancement (sous TX_LOCK ou depuis l'IT TX) ---------- */
+static void refill(void)
+{
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		txq_t  *q = &s_q[p];
+		uint8_t mb;
+
+		if (q->count == 0U || q->mb != MB_NONE) {
+			continue;
+		}
+		if (!hw_submit(&q->buf[q->head], &mb)) {
+			return;                                     /* mailboxes occupées : prochaine IT */
+		}
+		q->mb         = mb;
+		s_mb_prio[mb] = p;
+		q->head       = (uint8_t)((q->head + 1U == q->cap) ? 0U : q->head + 1U);
+		q->count--;
+	}
+}
+
+static void tx_done(uint8_t mb, bool ok)
+{
+	uint8_t p = s_mb_prio[mb];
+
+	if (p >= CANTX_PRIO_COUNT) {
+		return;                                         /* mailbox hors ordonnanceur */
+	}
+	s_mb_prio[mb] = MB_NONE;
+	s_q[p].mb     = MB_NONE;
+	if (ok) {
+		s_stats.cls[p].sent++;
+	}
+	refill();
+}
+
+/* ---------- API ---------- */
+scn_err_t CanTx_Init(void)
+{
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		s_q[p].head  = 0U;
+		s_q[p].count = 0U;
+		s_q[p].mb    = MB_NONE;
+	}
+	for (uint8_t i = 0U; i < CANTX_MAILBOXES; i++) {
+		s_mb_prio[i] = MB_NONE;
+	}
+	return hw_init();
+}
+
+scn_err_t CanTx_Send(cantx_prio_t prio, const can_frame_t *f)
+{
+	scn_err_t err = SCN_OK;
+
+	if ((unsigned)prio >= CANTX_PRIO_COUNT) {
+		return ERR_CAN_TX_OVR;
+	}
+	txq_t               *q  = &s_q[prio];
+	cantx_class_stats_t *st = &s_stats.cls[prio];
+
+	TX_LOCK();
+	if (q->count == q->cap) {
+		st->drops++;
+		err = ERR_CAN_TX_OVR;
+	} else {
+		uint32_t tail = (uint32_t)q->head + q->count;
+		q->buf[(tail >= q->cap) ? tail - q->cap : tail] = *f;
+		q->count++;
+		st->queued++;
+		refill();
+		if (q->count > st->hiwater) {
+			st->hiwater = q->count;                     /* attente réelle : hors départ immédiat */
+		}
+	}
+	TX_UNLOCK();
+	return err;
+}
+
+size_t CanTx_Free(cantx_prio_t prio)
+{
+	if ((unsigned)prio >= CANTX_PRIO_COUNT) {
+		return 0U;
+	}
+	return (size_t)(s_q[prio].cap - s_q[prio].count);  /* lecture 8 bits atomique */
+}
+
+bool CanTx_Idle(void)
+{
+	bool idle = true;
+
+	TX_LOCK();
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		idle = idle && (s_q[p].count == 0U) && (s_q[p].mb == MB_NONE);
+	}
+	TX_UNLOCK();
+	return idle;
+}
+
+void CanTx_GetStats(cantx_stats_t *st)
+{
+	TX_LOCK();
+	*st = s_stats;
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		st->cls[p].depth = s_q[p].count;
+	}
+	TX_UNLOCK();
+}
+
+void CanTx_ResetStats(void)
+{
+	TX_LOCK();
+	s_stats = (cantx_stats_t){ 0 };
+	TX_UNLOCK();
+}
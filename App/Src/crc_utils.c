@@ -0,0 +1,252 @@
+/**
+ * @file    crc_utils.c
+ * @brief   Implémentation des CRC utilisés par le journal et les capteurs.
+ *          CRC-8 en trois variantes : bit à bit (référence), table 256 octets
+ *          et slice-by-4 (4 octets par itération) pour le scan du journal au boot.
+ *          CRC-32 de bloc (pages FRAM) sur l'unité CRC matérielle, ou en logiciel.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "crc_utils.h"
+#include <string.h>
+
+#if CRC32_USE_HW
+  extern CRC_HandleTypeDef hcrc;
+#endif
+
+#if LOGGER_CRC8_POLY != 0x31
+  #error "Tables CRC-8 générées pour le poly 0x31 : les régénérer"
+#endif
+
+/* Tables générées pour le poly 0x31 (T0 : 1 octet, Tk : octet suivi de k zéros) */
+static const uint8_t s_crc8_t0[256] = {
+	0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+	0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+	0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+	0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+	0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+	0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+	0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+	0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+	0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+	0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+	0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+	0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+	0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+	0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+	0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+	0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC,
+};
+
+static const uint8_t s_crc8_slice[3][256] = {
+	{
+		0x00, 0xF4, 0xD9, 0x2D, 0x83, 0x77, 0x5A, 0xAE, 0x37, 0xC3, 0xEE, 0x1A, 0xB4, 0x40, 0x6D, 0x99,
+		0x6E, 0x9A, 0xB7, 0x43, 0xED, 0x19, 0x34, 0xC0, 0x59, 0xAD, 0x80, 0x74, 0xDA, 0x2E, 0x03, 0xF7,
+		0xDC, 0x28, 0x05, 0xF1, 0x5F, 0xAB, 0x86, 0x72, 0xEB, 0x1F, 0x32, 0xC6, 0x68, 0x9C, 0xB1, 0x45,
+		0xB2, 0x46, 0x6B, 0x9F, 0x31, 0xC5, 0xE8, 0x1C, 0x85, 0x71, 0x5C, 0xA8, 0x06, 0xF2, 0xDF, 0x2B,
+		0x89, 0x7D, 0x50, 0xA4, 0x0A, 0xFE, 0xD3, 0x27, 0xBE, 0x4A, 0x67, 0x93, 0x3D, 0xC9, 0xE4, 0x10,
+		0xE7, 0x13, 0x3E, 0xCA, 0x64, 0x90, 0xBD, 0x49, 0xD0, 0x24, 0x09, 0xFD, 0x53, 0xA7, 0x8A, 0x7E,
+		0x55, 0xA1, 0x8C, 0x78, 0xD6, 0x22, 0x0F, 0xFB, 0x62, 0x96, 0xBB, 0x4F, 0xE1, 0x15, 0x38, 0xCC,
+		0x3B, 0xCF, 0xE2, 0x16, 0xB8, 0x4C, 0x61, 0x95, 0x0C, 0xF8, 0xD5, 0x21, 0x8F, 0x7B, 0x56, 0xA2,
+		0x23, 0xD7, 0xFA, 0x0E, 0xA0, 0x54, 0x79, 0x8D, 0x14, 0xE0, 0xCD, 0x39, 0x97, 0x63, 0x4E, 0xBA,
+		0x4D, 0xB9, 0x94, 0x60, 0xCE, 0x3A, 0x17, 0xE3, 0x7A, 0x8E, 0xA3, 0x57, 0xF9, 0x0D, 0x20, 0xD4,
+		0xFF, 0x0B, 0x26, 0xD2, 0x7C, 0x88, 0xA5, 0x51, 0xC8, 0x3C, 0x11, 0xE5, 0x4B, 0xBF, 0x92, 0x66,
+		0x91, 0x65, 0x48, 0xBC, 0x12, 0xE6, 0xCB, 0x3F, 0xA6, 0x52, 0x7F, 0x8B, 0x25, 0xD1, 0xFC, 0x08,
+		0xAA, 0x5E, 0x73, 0x87, 0x29, 0xDD, 0xF0, 0x04, 0x9D, 0x69, 0x44, 0xB0, 0x1E, 0xEA, 0xC7, 0x33,
+		0xC4, 0x30, 0x1D, 0xE9, 0x47, 0xB3, 0x9E, 0x6A, 0xF3, 0x07, 0x2A, 0xDE, 0x70, 0x84, 0xA9, 0x5D,
+		0x76, 0x82, 0xAF, 0x5B, 0xF5, 0x01, 0x2C, 0xD8, 0x41, 0xB5, 0x98, 0x6C, 0xC2, 0x36, 0x1B, 0xEF,
+		0x18, 0xEC, 0xC1, 0x35, 0x9B, 0x6F, 0x42, 0xB6, 0x2F, 0xDB, 0xF6, 0x02, 0xAC, 0x58, 0x75, 0x81,
+	},
+	{
+		0x00, 0x46, 0x8C, 0xCA, 0x29, 0x6F, 0xA5, 0xE3, 0x52, 0x14, 0xDE, 0x98, 0x7B, 0x3D, 0xF7, 0xB1,
+		0xA4, 0xE2, 0x28, 0x6E, 0x8D, 0xCB, 0x01, 0x47, 0xF6, 0xB0, 0x7A, 0x3C, 0xDF, 0x99, 0x53, 0x15,
+		0x79, 0x3F, 0xF5, 0xB3, 0x50, 0x16, 0xDC, 0x9A, 0x2B, 0x6D, 0xA7, 0xE1, 0x02, 0x44, 0x8E, 0xC8,
+		0xDD, 0x9B, 0x51, 0x17, 0xF4, 0xB2, 0x78, 0x3E, 0x8F, 0xC9, 0x03, 0x45, 0xA6, 0xE0, 0x2A, 0x6C,
+		0xF2, 0xB4, 0x7E, 0x38, 0xDB, 0x9D, 0x57, 0x11, 0xA0, 0xE6, 0x2C, 0x6A, 0x89, 0xCF, 0x05, 0x43,
+		0x56, 0x10, 0xDA, 0x9C, 0x7F, 0x39, 0xF3, 0xB5, 0x04, 0x42, 0x88, 0xCE, 0x2D, 0x6B, 0xA1, 0xE7,
+		0x8B, 0xCD, 0x07, 0x41, 0xA2, 0xE4, 0x2E, 0x68, 0xD9, 0x9F, 0x55, 0x13, 0xF0, 0xB6, 0x7C, 0x3A,
+		0x2F, 0x69, 0xA3, 0xE5, 0x06, 0x40, 0x8A, 0xCC, 0x7D, 0x3B, 0xF1, 0xB7, 0x54, 0x12, 0xD8, 0x9E,
+		0xD5, 0x93, 0x59, 0x1F, 0xFC, 0xBA, 0x70, 0x36, 0x87, 0xC1, 0x0B, 0x4D, 0xAE, 0xE8, 0x22, 0x64,
+		0x71, 0x37, 0xFD, 0xBB, 0x58, 0x1E, 0xD4, 0x92, 0x23, 0x65, 0xAF, 0xE9, 0x0A, 0x4C, 0x86, 0xC0,
+		0xAC, 0xEA, 0x20, 0x66, 0x85, 0xC3, 0x09, 0x4F, 0xFE, 0xB8, 0x72, 0x34, 0xD7, 0x91, 0x5B, 0x1D,
+		0x08, 0x4E, 0x84, 0xC2, 0x21, 0x67, 0xAD, 0xEB, 0x5A, 0x1C, 0xD6, 0x90, 0x73, 0x35, 0xFF, 0xB9,
+		0x27, 0x61, 0xAB, 0xED, 0x0E, 0x48, 0x82, 0xC4, 0x75, 0x33, 0xF9, 0xBF, 0x5C, 0x1A, 0xD0, 0x96,
+		0x83, 0xC5, 0x0F, 0x49, 0xAA, 0xEC, 0x26, 0x60, 0xD1, 0x97, 0x5D, 0x1B, 0xF8, 0xBE, 0x74, 0x32,
+		0x5E, 0x18, 0xD2, 0x94, 0x77, 0x31, 0xFB, 0xBD, 0x0C, 0x4A, 0x80, 0xC6, 0x25, 0x63, 0xA9, 0xEF,
+		0xFA, 0xBC, 0x76, 0x30, 0xD3, 0x95, 0x5F, 0x19, 0xA8, 0xEE, 0x24, 0x62, 0x81, 0xC7, 0x0D, 0x4B,
+	},
+	{
+		0x00, 0x9B, 0x07, 0x9C, 0x0E, 0x95, 0x09, 0x92, 0x1C, 0x87, 0x1B, 0x80, 0x12, 0x89, 0x15, 0x8E,
+		0x38, 0xA3, 0x3F, 0xA4, 0x36, 0xAD, 0x31, 0xAA, 0x24, 0xBF, 0x23, 0xB8, 0x2A, 0xB1, 0x2D, 0xB6,
+		0x70, 0xEB, 0x77, 0xEC, 0x7E, 0xE5, 0x79, 0xE2, 0x6C, 0xF7, 0x6B, 0xF0, 0x62, 0xF9, 0x65, 0xFE,
+		0x48, 0xD3, 0x4F, 0xD4, 0x46, 0xDD, 0x41, 0xDA, 0x54, 0xCF, 0x53, 0xC8, 0x5A, 0xC1, 0x5D, 0xC6,
+		0xE0, 0x7B, 0xE7, 0x7C, 0xEE, 0x75, 0xE9, 0x72, 0xFC, 0x67, 0xFB, 0x60, 0xF2, 0x69, 0xF5, 0x6E,
+		0xD8, 0x43, 0xDF, 0x44, 0xD6, 0x4D, 0xD1, 0x4A, 0xC4, 0x5F, 0xC3, 0x58, 0xCA, 0x51, 0xCD, 0x56,
+		0x90, 0x0B, 0x97, 0x0C, 0x9E, 0x05, 0x99, 0x02, 0x8C, 0x17, 0x8B, 0x10, 0x82, 0x19, 0x85, 0x1E,
+		0xA8, 0x33, 0xAF, 0x34, 0xA6, 0x3D, 0xA1, 0x3A, 0xB4, 0x2F, 0xB3, 0x28, 0xBA, 0x21, 0xBD, 0x26,
+		0xF1, 0x6A, 0xF6, 0x6D, 0xFF, 0x64, 0xF8, 0x63, 0xED, 0x76, 0xEA, 0x71, 0xE3, 0x78, 0xE4, 0x7F,
+		0xC9, 0x52, 0xCE, 0x55, 0xC7, 0x5C, 0xC0, 0x5B, 0xD5, 0x4E, 0xD2, 0x49, 0xDB, 0x40, 0xDC, 0x47,
+		0x81, 0x1A, 0x86, 0x1D, 0x8F, 0x14, 0x88, 0x13, 0x9D, 0x06, 0x9A, 0x01, 0x93, 0x08, 0x94, 0x0F,
+		0xB9, 0x22, 0xBE, 0x25, 0xB7, 0x2C, 0xB0, 0x2B, 0xA5, 0x3E, 0xA2, 0x39, 0xAB, 0x30, 0xAC, 0x37,
+		0x11, 0x8A, 0x16, 0x8D, 0x1F, 0x84, 0x18, 0x83, 0x0D, 0x96, 0x0A, 0x91, 0x03, 0x98, 0x04, 0x9F,
+		0x29, 0xB2, 0x2E, 0xB5, 0x27, 0xBC, 0x20, 0xBB, 0x35, 0xAE, 0x32, 0xA9, 0x3B, 0xA0, 0x3C, 0xA7,
+		0x61, 0xFA, 0x66, 0xFD, 0x6F, 0xF4, 0x68, 0xF3, 0x7D, 0xE6, 0x7A, 0xE1, 0x73, 0xE8, 0x74, 0xEF,
+		0x59, 0xC2, 0x5E, 0xC5, 0x57, 0xCC, 0x50, 0xCB, 0x45, 0xDE, 0x42, 0xD9, 0x4B, 0xD0, 0x4C, 0xD7,
+	},
+};
+
+#if !CRC32_USE_HW
+/* Table CRC-32 MSB first, poly 0x04C11DB7 (fallback logiciel) */
+static const uint32_t s_crc32_t[256] = {
+	0x00000000U, 0x04C11DB7U, 0x09823B6EU, 0x0D4326D9U, 0x130476DCU, 0x17C56B6BU, 0x1A864DB2U, 0x1E475005U,
+	0x2608EDB8U, 0x22C9F00FU, 0x2F8AD6D6U, 0x2B4BCB61U, 0x350C9B64U, 0x31CD86D3U, 0x3C8EA00AU, 0x384FBDBDU,
+	0x4C11DB70U, 0x48D0C6C7U, 0x4593E01EU, 0x4152FDA9U, 0x5F15ADACU, 0x5BD4B01BU, 0x569796C2U, 0x52568B75U,
+	0x6A1936C8U, 0x6ED82B7FU, 0x639B0DA6U, 0x675A1011U, 0x791D4014U, 0x7DDC5DA3U, 0x709F7B7AU, 0x745E66CDU,
+	0x9823B6E0U, 0x9CE2AB57U, 0x91A18D8EU, 0x95609039U, 0x8B27C03CU, 0x8FE6DD8BU, 0x82A5FB52U, 0x8664E6E5U,
+	0xBE2B5B58U, 0xBAEA46EFU, 0xB7A96036U, 0xB3687D81U, 0xAD2F2D84U, 0xA9EE3033U, 0xA4AD16EAU, 0xA06C0B5DU,
+	0xD4326D90U, 0xD0F37027U, 0xDDB056FEU, 0xD9714B49U, 0xC7361B4CU, 0xC3F706FBU, 0xCEB42022U, 0xCA753D95U,
+	0xF23A8028U, 0xF6FB9D9FU, 0xFBB8BB46U, 0xFF79A6F1U, 0xE13EF6F4U, 0xE5FFEB43U, 0xE8BCCD9AU, 0xEC7DD02DU,
+	0x34867077U, 0x30476DC0U, 0x3D044B19U, 0x39C556AEU, 0x278206ABU, 0x23431B1CU, 0x2E003DC5U, 0x2AC12072U,
+	0x128E9DCFU, 0x164F8078U, 0x1B0CA6A1U, 0x1FCDBB16U, 0x018AEB13U, 0x054BF6A4U, 0x0808D07DU, 0x0CC9CDCAU,
+	0x7897AB07U, 0x7C56B6B0U, 0x71159069U, 0x75D48DDEU, 0x6B93DDDBU, 0x6F52C06CU, 0x6211E6B5U, 0x66D0FB02U,
+	0x5E9F46BFU, 0x5A5E5B08U, 0x571D7DD1U, 0x53DC6066U, 0x4D9B3063U, 0x495A2DD4U, 0x44190B0DU, 0x40D816BAU,
+	0xACA5C697U, 0xA864DB20U, 0xA527FDF9U, 0xA1E6E04EU, 0xBFA1B04BU, 0xBB60ADFCU, 0xB6238B25U, 0xB2E29692U,
+	0x8AAD2B2FU, 0x8E6C3698U, 0x832F1041U, 0x87EE0DF6U, 0x99A95DF3U, 0x9D684044U, 0x902B669DU, 0x94EA7B2AU,
+	0xE0B41DE7U, 0xE4750050U, 0xE9362689U, 0xEDF73B3EU, 0xF3B06B3BU, 0xF771768CU, 0xFA325055U, 0xFEF34DE2U,
+	0xC6BCF05FU, 0xC27DEDE8U, 0xCF3ECB31U, 0xCBFFD686U, 0xD5B88683U, 0xD1799B34U, 0xDC3ABDEDU, 0xD8FBA05AU,
+	0x690CE0EEU, 0x6DCDFD59U, 0x608EDB80U, 0x644FC637U, 0x7A089632U, 0x7EC98B85U, 0x738AAD5CU, 0x774BB0EBU,
+	0x4F040D56U, 0x4BC510E1U, 0x46863638U, 0x42472B8FU, 0x5C007B8AU, 0x58C1663DU, 0x558240E4U, 0x51435D53U,
+	0x251D3B9EU, 0x21DC2629U, 0x2C9F00F0U, 0x285E1D47U, 0x36194D42U, 0x32D850F5U, 0x3F9B762CU, 0x3B5A6B9BU,
+	0x0315D626U, 0x07D4CB91U, 0x0A97ED48U, 0x0E56F0FFU, 0x1011A0FAU, 0x14D0BD4DU, 0x19939B94U, 0x1D528623U,
+	0xF12F560EU, 0xF5EE4BB9U, 0xF8AD6D60U, 0xFC6C70D7U, 0xE22B20D2U, 0xE6EA3D65U, 0xEBA91BBCU, 0xEF68060BU,
+	0xD727BBB6U, 0xD3E6A601U, 0xDEA580D8U, 0xDA649D6FU, 0xC423CD6AU, 0xC0E2D0DDU, 0xCDA1F604U, 0xC960EBB3U,
+	0xBD3E8D7EU, 0xB9FF90C9U, 0xB4BCB610U, 0xB07DABA7U, 0xAE3AFBA2U, 0xAAFBE615U, 0xA7B8C0CCU, 0xA379DD7BU,
+	0x9B3660C6U, 0x9FF77D71U, 0x92B45BA8U, 0x9675461FU, 0x8832161AU, 0x8CF30BADU, 0x81B02D74U, 0x857130C3U,
+	0x5D8A9099U, 0x594B8D2EU, 0x5408ABF7U, 0x50C9B640U, 0x4E8EE645U, 0x4A4FFBF2U, 0x470CDD2BU, 0x43CDC09CU,
+	0x7B827D21U, 0x7F436096U, 0x7200464FU, 0x76C15BF8U, 0x68860BFDU, 0x6C47164AU, 0x61043093U, 0x65C52D24U,
+	0x119B4BE9U, 0x155A565EU, 0x18197087U, 0x1CD86D30U, 0x029F3D35U, 0x065E2082U, 0x0B1D065BU, 0x0FDC1BECU,
+	0x3793A651U, 0x3352BBE6U, 0x3E119D3FU, 0x3AD08088U, 0x2497D08DU, 0x2056CD3AU, 0x2D15EBE3U, 0x29D4F654U,
+	0xC5A92679U, 0xC1683BCEU, 0xCC2B1D17U, 0xC8EA00A0U, 0xD6AD50A5U, 0xD26C4D12U, 0xDF2F6BCBU, 0xDBEE767CU,
+	0xE3A1CBC1U, 0xE760D676U, 0xEA23F0AFU, 0xEEE2ED18U, 0xF0A5BD1DU, 0xF464A0AAU, 0xF9278673U, 0xFDE69BC4U,
+	0x89B8FD09U, 0x8D79E0BEU, 0x803AC667U, 0x84FBDBD0U, 0x9ABC8BD5U, 0x9E7D9662U, 0x933EB0BBU, 0x97FFAD0CU,
+	0xAFB010B1U, 0xAB710D06U, 0xA6322BDFU, 0xA2F33668U, 0xBCB4666DU, 0xB8757BDAU, 0xB5365D03U, 0xB1F740B4U,
+};
+#endif
+
+/* API */
+uint8_t Crc8_UpdateBitwise(uint8_t crc, const uint8_t *data, size_t len)
+{
+	/* Calcul bit à bit, MSB first */
+	while (len--) {
+		crc ^= *data++;
+		for (uint8_t b = 0; b < 8U; b++) {
+			crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ LOGGER_CRC8_POLY) : (uint8_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+uint8_t Crc8_UpdateTable(uint8_t crc, const uint8_t *data, size_t len)
+{
+	while (len--) {
+		crc = s_crc8_t0[crc ^ *data++];
+	}
+	return crc;
+}
+
+uint8_t Crc8_UpdateSlice4(uint8_t crc, const uint8_t *data, size_t len)
+{
+	/* CRC linéaire : contribution de chaque octet du bloc = table décalée de sa distance à la fin */
+	while (len >= 4U) {
+		crc = (uint8_t)(s_crc8_slice[2][crc ^ data[0]] ^ s_crc8_slice[1][data[1]]
+		              ^ s_crc8_slice[0][data[2]]        ^ s_crc8_t0[data[3]]);
+		data += 4;
+		len  -= 4U;
+	}
+	return Crc8_UpdateTable(crc, data, len);
+}
+
+uint8_t Crc8_Update(uint8_t crc, const uint8_t *data, size_t len)
+{
+#if CRC8_IMPL == CRC8_IMPL_BITWISE
+	return Crc8_UpdateBitwise(crc, data, len);
+#elif CRC8_IMPL == CRC8_IMPL_TABLE
+	return Crc8_UpdateTable(crc, data, len);
+#else
+	return Crc8_UpdateSlice4(crc, data, len);
+#endif
+}
+
+uint8_t Crc8_Compute(const uint8_t *data, size_t len)
+{
+	return Crc8_Update(CRC8_INIT, data, len);
+}
+
+bool Crc8_SelfTest(void)
+{
+	/* Vecteurs : "123456789" (CRC-8/NRSC-5 = 0xF7), 0xBEEF (datasheet SHT31 = 0x92) */
+	static const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	static const uint8_t sht[]   = { 0xBEU, 0xEFU };
+	uint8_t buf[37];
+
+	if (Crc8_UpdateBitwise(CRC8_INIT, check, sizeof(check)) != 0xF7U ||
+	    Crc8_UpdateBitwise(CRC8_INIT, sht, sizeof(sht)) != 0x92U) {
+		return false;
+	}
+
+	/* Variantes rapides comparées à la référence sur toutes les longueurs/restes */
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 37U + 11U);
+	}
+	for (size_t n = 0; n <= sizeof(buf); n++) {
+		uint8_t ref = Crc8_UpdateBitwise(CRC8_INIT, buf, n);
+		if (Crc8_UpdateTable(CRC8_INIT, buf, n) != ref || Crc8_UpdateSlice4(CRC8_INIT, buf, n) != ref) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t Crc32_Compute(const uint8_t *data, size_t len)
+{
+	/* Mots chargés par memcpy : pas de contrainte d'alignement du buffer */
+	uint32_t w;
+#if CRC32_USE_HW
+	/* Unité partagée : appel depuis la tâche de commit/scan du journal uniquement */
+	__HAL_CRC_DR_RESET(&hcrc);
+	while (len >= 4U) {
+		memcpy(&w, data, 4U);
+		hcrc.Instance->DR = w;
+		data += 4;
+		len  -= 4U;
+	}
+	if (len != 0U) {
+		w = 0U;
+		memcpy(&w, data, len);
+		hcrc.Instance->DR = w;
+	}
+	return hcrc.Instance->DR;
+#else
+	uint32_t crc = 0xFFFFFFFFU;
+	while (len != 0U) {
+		size_t n = (len < 4U) ? len : 4U;
+		w = 0U;
+		memcpy(&w, data, n);
+		data += n;
+		len  -= n;
+		/* Octets du mot dans l'ordre MSB -> LSB, comme le périphérique */
+		for (int8_t sh = 24; sh >= 0; sh -= 8) {
+			crc = (crc << 8) ^ s_crc32_t[((crc >> 24) ^ (w >> sh)) & 0xFFU];
+		}
+	}
+	return crc;
+#endif
+}
+
+bool Crc32_SelfTest(void)
+{
+	static const uint8_t word[] = { 0x78U, 0x56U, 0x34U, 0x12U };
+	return Crc32_Compute(word, sizeof(word)) == 0xDF8A8A2BU;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file    door.c
+ * @brief   Contact de porte : EXTI + anti-rebond par timer one-pulse.
+ *          Chaque front remet le compteur du timer à zéro : son IT de mise
+ *          à jour n'arrive qu'après DOOR_DEBOUNCE_MS sans front, la broche
+ *          est alors stable et lue une seule fois.
+ *          SIM_TARGET : broche et timer sur horloge virtuelle, publications
+ *          relevées dans les statistiques.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "door.h"
+
+#if !SIM_TARGET
+  #include "core_init.h"
+  extern TIM_HandleTypeDef DOOR_DEB_TIM;
+#endif
+
+/* Un changement de porte doit tenir dans une fenêtre CAN (anti-rebond + diffusion) */
+typedef char door_deb_check[(DOOR_DEBOUNCE_MS < PERIOD_CAN_MS) ? 1 : -1];
+
+static volatile bool s_open;
+static volatile bool s_ready;       /* Door_Init fait : publications autorisées */
+static door_stats_t  s_stats;
+
+/* ---------- Accès matériel ---------- */
+#if SIM_TARGET
+
+static uint32_t s_sim_now;
+static uint32_t s_sim_due;
+static bool     s_sim_armed;
+static bool     s_sim_pin;
+
+static bool pin_open(void)
+{
+	return s_sim_pin;
+}
+
+static void deb_restart(void)
+{
+	s_sim_due   = s_sim_now + DOOR_DEBOUNCE_MS;
+	s_sim_armed = true;
+}
+
+static uint32_t now_ms(void)
+{
+	return s_sim_now;
+}
+
+static void publish(bool open)
+{
+	(void)open;     /* relevé par Door_GetStats / Door_IsOpen */
+}
+
+static void hw_init(void)
+{
+	s_sim_armed = false;
+}
+
+void Door_SimSetPin(bool open)
+{
+	if (open != s_sim_pin) {
+		s_sim_pin = open;
+		Door_OnEdgeIRQ();
+	}
+}
+
+void Door_SimAdvance(uint32_t ms)
+{
+	uint32_t end = s_sim_now + ms;
+
+	if (s_sim_armed && (int32_t)(end - s_sim_due) >= 0) {
+		s_sim_now   = s_sim_due;
+		s_sim_armed = false;
+		Door_OnDebounceIRQ();
+	}
+	s_sim_now = end;
+}
+
+uint32_t Door_SimNowMs(void)
+{
+	return s_sim_now;
+}
+
+#else
+
+/* Contact reed à la masse, pull-up : porte ouverte = niveau haut */
+static bool pin_open(void)
+{
+	return HAL_GPIO_ReadPin(DOOR_GPIO_Port, DOOR_Pin) == GPIO_PIN_SET;
+}
+
+/* Compteur remis à zéro et relancé : le one-pulse s'arrête seul à l'échéance */
+static void deb_restart(void)
+{
+	__HAL_TIM_SET_COUNTER(&DOOR_DEB_TIM, 0U);
+	__HAL_TIM_ENABLE(&DOOR_DEB_TIM);
+}
+
+static uint32_t now_ms(void)
+{
+	return (uint32_t)xTaskGetTickCountFromISR() * TICK_MS;
+}
+
+/* Contexte ISR : bit d'état, transition ordonnée pour task_can et notification des abonnés */
+static void publish(bool open)
+{
+	BaseType_t woken = pdFALSE;
+
+	Core_EvtPublishFromISR(EVT_SYS_DOOR_OPEN, open, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void hw_init(void)
+{
+	/* Durée d'anti-rebond imposée par config.h (le prescaler CubeMX fixe DOOR_DEB_TIM_HZ) */
+	__HAL_TIM_SET_AUTORELOAD(&DOOR_DEB_TIM, (DOOR_DEBOUNCE_MS * DOOR_DEB_TIM_HZ) / 1000U - 1U);
+	__HAL_TIM_CLEAR_FLAG(&DOOR_DEB_TIM, TIM_FLAG_UPDATE);          /* UG de HAL_TIM_Base_Init */
+	__HAL_TIM_ENABLE_IT(&DOOR_DEB_TIM, TIM_IT_UPDATE);
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	if (GPIO_Pin == DOOR_Pin) {
+		Door_OnEdgeIRQ();
+	}
+}
+
+#endif /* SIM_TARGET */
+
+/* ---------- IT ---------- */
+void Door_OnEdgeIRQ(void)
+{
+	s_stats.edges++;
+	deb_restart();
+}
+
+void Door_OnDebounceIRQ(void)
+{
+	bool open = pin_open();
+
+	if (!s_ready || open == s_open) {
+		return;                     /* rebond revenu à l'état stable : rien à publier */
+	}
+	s_open = open;
+	s_stats.changes++;
+	s_stats.last_change_ms = now_ms();
+	publish(open);
+}
+
+/* ---------- API ---------- */
+scn_err_t Door_Init(void)
+{
+	hw_init();
+	s_open = pin_open();
+#if !SIM_TARGET
+	if (s_open) {
+		(void)xEventGroupSetBits(Core_GetSysEvents(), EVT_SYS_DOOR_OPEN);
+	}
+#endif
+	s_ready = true;
+	return SCN_OK;
+}
+
+bool Door_IsOpen(void)
+{
+	return s_open;
+}
+
+void Door_GetStats(door_stats_t *st)
+{
+#if !SIM_TARGET
+	taskENTER_CRITICAL();           /* copie cohérente face aux IT EXTI / timer */
+#endif
+	*st = s_stats;
+#if !SIM_TARGET
+	taskEXIT_CRITICAL();
+#endif
+}
@@ -0,0 +1,136 @@
+/**
+ * @file    filter.c
+ * @brief   Filtrage en flux : médiane 5, EMA virgule fixe, calibration.
+ *          Aucun tri ni boucle dépendant de l'historique : coût constant
+ *          par échantillon (7 comparaisons-échanges, 1 décalage, 1 MAC 64 bits).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "filter.h"
+
+#if SIM_TARGET
+#include <time.h>
+#endif
+
+/* Accumulateur EMA : |x| << FILTER_EMA_FRAC doit tenir sur 31 bits (mesures 16 bits) */
+typedef char filter_ema_check[(FILTER_EMA_FRAC <= 15U) ? 1 : -1];
+
+/* ---------- Médiane glissante ---------- */
+#define CSWAP(a, b)  do { if ((a) > (b)) { int32_t _t = (a); (a) = (b); (b) = _t; } } while (0)
+
+void Filter_Med5Seed(filter_med5_t *m, int32_t x)
+{
+	for (uint8_t i = 0U; i < FILTER_MED_LEN; i++) {
+		m->win[i] = x;
+	}
+	m->pos = 0U;
+}
+
+int32_t Filter_Med5(filter_med5_t *m, int32_t x)
+{
+	m->win[m->pos] = x;
+	m->pos = (uint8_t)((m->pos + 1U == FILTER_MED_LEN) ? 0U : m->pos + 1U);
+
+	/* Réseau de tri partiel (médiane de 5 en 7 échanges) sur une copie : la fenêtre reste en ordre d'arrivée */
+	int32_t p0 = m->win[0], p1 = m->win[1], p2 = m->win[2], p3 = m->win[3], p4 = m->win[4];
+	CSWAP(p0, p1); CSWAP(p3, p4); CSWAP(p0, p3);
+	CSWAP(p1, p4); CSWAP(p1, p2); CSWAP(p2, p3);
+	CSWAP(p1, p2);
+	return p2;
+}
+
+/* ---------- Moyenne exponentielle ---------- */
+void Filter_EmaSeed(filter_ema_t *e, int32_t x)
+{
+	e->acc = x * (1L << FILTER_EMA_FRAC);
+}
+
+int32_t Filter_Ema(filter_ema_t *e, int32_t x)
+{
+	/* Décalages arithmétiques (signés) : même comportement de part et d'autre de 0 */
+	e->acc += (x * (1L << FILTER_EMA_FRAC) - e->acc) >> e->shift;
+	return (e->acc + (1L << (FILTER_EMA_FRAC - 1U))) >> FILTER_EMA_FRAC;
+}
+
+/* ---------- Calibration ---------- */
+int32_t Filter_Cal(const filter_cal_t *c, int32_t x)
+{
+	int64_t y = (int64_t)x * c->gain_q14 + (1LL << (FILTER_GAIN_FRAC - 1U));
+	return (int32_t)(y >> FILTER_GAIN_FRAC) + c->offset;
+}
+
+/* ---------- Voie ---------- */
+void Filter_ChanInit(filter_chan_t *c, uint8_t ema_shift)
+{
+	Filter_Med5Seed(&c->med, 0);                   /* état défini ; réamorcé au 1er échantillon */
+	Filter_EmaSeed(&c->ema, 0);
+	c->ema.shift    = ema_shift;
+	c->cal.offset   = 0;
+	c->cal.gain_q14 = FILTER_GAIN_ONE;
+	c->seeded       = false;
+}
+
+void Filter_ChanReset(filter_chan_t *c)
+{
+	c->seeded = false;
+}
+
+int32_t Filter_Chan(filter_chan_t *c, int32_t x)
+{
+	if (!c->seeded) {
+		/* Premier échantillon (ou reprise après défaut) : pas de transitoire depuis 0 */
+		Filter_Med5Seed(&c->med, x);
+		Filter_EmaSeed(&c->ema, x);
+		c->seeded = true;
+	}
+	return Filter_Cal(&c->cal, Filter_Ema(&c->ema, Filter_Med5(&c->med, x)));
+}
+
+/* ---------- Banc de mesure ---------- */
+#if SIM_TARGET
+static uint32_t bench_now(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#else
+static uint32_t bench_now(void)
+{
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0U;
+		DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+	return DWT->CYCCNT;
+}
+#endif
+
+uint32_t Filter_Bench(uint32_t n)
+{
+	filter_chan_t   c;
+	volatile int32_t sink = 0;  /* résultat consommé : la boucle n'est pas éliminée */
+
+	if (n == 0U) {
+		return 0U;
+	}
+	Filter_ChanInit(&c, 2U);
+	c.cal.offset   = -25;
+	c.cal.gain_q14 = FILTER_GAIN_ONE + 82;
+
+	/* Rampe en dent de scie (centi-°C) avec un pic toutes les 7 mesures */
+	uint32_t t0 = bench_now();
+	for (uint32_t i = 0U; i < n; i++) {
+		int32_t x = (int32_t)(i & 0x3FFU) - 512;
+		if ((i % 7U) == 0U) {
+			x += 5000;
+		}
+		sink = Filter_Chan(&c, x);
+	}
+	uint32_t dt = bench_now() - t0;   /* débordement 32 bits toléré (< 25 s à 168 MHz) */
+
+	(void)sink;
+	return (dt + n / 2U) / n;
+}
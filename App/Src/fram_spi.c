@@ -0,0 +1,372 @@
+/**
+ * @file    fram_spi.c
+ * @brief   Driver FRAM SPI (MB85RS256B).
+ *          Les commits du journal partent en une seule rafale WRITE par page :
+ *          WREN + opcode/adresse, puis transfert DMA sans travail CPU par octet.
+ *          Deux buffers de staging : le logger remplit l'un pendant que l'autre
+ *          est sur le bus.
+ *          SIM_TARGET : FRAM virtuelle sur fichier mappé, latence SPI modélisée
+ *          et usure comptée par octet, même API que sur cible.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "fram_spi.h"
+#include <string.h>
+
+#if !SIM_TARGET
+  #include "FreeRTOS.h"
+  #include "semphr.h"
+  extern SPI_HandleTypeDef FRAM_SPI;
+#else
+  #include <fcntl.h>
+  #include <stdlib.h>
+  #include <sys/mman.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+/* Opcodes MB85RS256B */
+#define FRAM_OP_WREN     0x06U
+#define FRAM_OP_WRITE    0x02U
+#define FRAM_OP_READ     0x03U
+#define FRAM_CMD_LEN     3U        /* opcode + adresse 16 bits */
+
+/* ---------- État (scope fichier) ---------- */
+static uint8_t       s_stage[2][FRAM_STAGE_SIZE];
+static uint8_t       s_fill;       /* buffer en cours de remplissage     */
+static volatile bool s_busy;       /* DMA en cours sur l'autre buffer    */
+static fram_stats_t  s_stats;
+
+static bool in_range(uint32_t addr, size_t len)
+{
+	return (len <= FRAM_SIZE_BYTES) && (addr <= (FRAM_SIZE_BYTES - len));
+}
+
+/* ---------- Accès bus ---------- */
+#if SIM_TARGET
+
+/* Fichier mappé : image FRAM puis un compteur d'écritures (uint32) par octet.
+ * Image et usure survivent aux reboots simulés (Fram_Init) comme aux exécutions successives.
+ */
+#define SIM_MAP_SIZE   ((size_t)FRAM_SIZE_BYTES * (1U + sizeof(uint32_t)))
+
+static uint8_t  *s_img;          /* image FRAM                            */
+static uint32_t *s_wear;         /* écritures par octet                   */
+static uint64_t  s_bus_ns;       /* temps bus SPI simulé cumulé           */
+static uint64_t  s_dma_end_ns;   /* fin du DMA en cours (horloge hôte)    */
+static bool      s_cut_armed;    /* coupure d'alim simulée programmée     */
+static uint32_t  s_cut_left;     /* octets encore écrits avant coupure    */
+
+/* Durée d'une transaction CS : octets à FRAM_SIM_SPI_HZ + surcoût fixe */
+static uint64_t xfer_ns(size_t bytes)
+{
+	return FRAM_SIM_CS_NS + ((uint64_t)bytes * 8U * 1000000000ULL) / FRAM_SIM_SPI_HZ;
+}
+
+#if FRAM_SIM_REALTIME
+static uint64_t host_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Attente active : nanosleep est trop grossier à l'échelle de la µs */
+static void wait_until(uint64_t t)
+{
+	while (host_ns() < t) {
+	}
+}
+#endif
+
+static scn_err_t bus_init(void)
+{
+	s_cut_armed  = false;                          /* Fram_Init = reboot : alim rétablie */
+	s_dma_end_ns = 0U;
+	if (s_img != NULL) {
+		return SCN_OK;                             /* déjà mappée : contenu conservé */
+	}
+
+	const char *path = getenv("SCN_FRAM_FILE");
+	int fd = open((path != NULL) ? path : FRAM_SIM_FILE, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		return ERR_SPI_READ;
+	}
+	void *map = MAP_FAILED;
+	if (ftruncate(fd, (off_t)SIM_MAP_SIZE) == 0) {
+		map = mmap(NULL, SIM_MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	close(fd);
+	if (map == MAP_FAILED) {
+		return ERR_SPI_READ;
+	}
+	s_img  = (uint8_t *)map;
+	s_wear = (uint32_t *)(void *)&s_img[FRAM_SIZE_BYTES];
+	return SCN_OK;
+}
+
+static scn_err_t bus_wait(void)
+{
+#if FRAM_SIM_REALTIME
+	wait_until(s_dma_end_ns);
+#endif
+	return SCN_OK;
+}
+
+static scn_err_t bus_write(uint32_t addr, const uint8_t *src, size_t len, bool dma)
+{
+	uint64_t ns = xfer_ns(1U) + xfer_ns(FRAM_CMD_LEN + len);   /* WREN puis WRITE */
+	s_bus_ns += ns;
+#if FRAM_SIM_REALTIME
+	if (dma) {
+		s_dma_end_ns = host_ns() + ns;             /* rendu immédiat, attendu par bus_wait */
+	} else {
+		wait_until(host_ns() + ns);
+	}
+#else
+	(void)dma;
+#endif
+
+	if (s_cut_armed && len > s_cut_left) {
+		len = s_cut_left;                          /* écriture tronquée, la suite est perdue */
+	}
+	memcpy(&s_img[addr], src, len);
+	for (size_t i = 0; i < len; i++) {
+		s_wear[addr + i]++;
+	}
+	if (s_cut_armed) {
+		s_cut_left -= (uint32_t)len;
+	}
+	return SCN_OK;
+}
+
+static scn_err_t bus_read(uint32_t addr, uint8_t *dst, size_t len)
+{
+	uint64_t ns = xfer_ns(FRAM_CMD_LEN + len);
+	s_bus_ns += ns;
+#if FRAM_SIM_REALTIME
+	wait_until(host_ns() + ns);
+#endif
+	memcpy(dst, &s_img[addr], len);
+	return SCN_OK;
+}
+
+void Fram_SimPowerCut(uint32_t after_bytes)
+{
+	s_cut_armed = true;
+	s_cut_left  = after_bytes;
+}
+
+void Fram_SimGetStats(fram_sim_stats_t *st)
+{
+	memset(st, 0, sizeof(*st));
+	st->bus_ns = s_bus_ns;
+	if (s_wear == NULL) {
+		return;
+	}
+	for (uint32_t a = 0; a < FRAM_SIZE_BYTES; a++) {
+		st->byte_writes += s_wear[a];
+		if (s_wear[a] > st->max_writes) {
+			st->max_writes = s_wear[a];
+			st->max_addr   = a;
+		}
+	}
+}
+
+const uint32_t *Fram_SimWearMap(void)
+{
+	return s_wear;
+}
+
+#else
+
+static SemaphoreHandle_t s_semDone = NULL;   /* donné par l'IT de fin de DMA */
+static StaticSemaphore_t s_semDoneBuf;
+
+static inline void cs_low(void)  { HAL_GPIO_WritePin(FRAM_CS_GPIO_Port, FRAM_CS_Pin, GPIO_PIN_RESET); }
+static inline void cs_high(void) { HAL_GPIO_WritePin(FRAM_CS_GPIO_Port, FRAM_CS_Pin, GPIO_PIN_SET); }
+
+static scn_err_t bus_init(void)
+{
+	s_semDone = xSemaphoreCreateBinaryStatic(&s_semDoneBuf);
+	configASSERT(s_semDone);
+	cs_high();
+	return SCN_OK;
+}
+
+static scn_err_t bus_wait(void)
+{
+	while (s_busy) {
+		if (xSemaphoreTake(s_semDone, pdMS_TO_TICKS(FRAM_DMA_TIMEOUT_MS)) != pdTRUE) {
+			(void)HAL_SPI_Abort(&FRAM_SPI);
+			cs_high();
+			s_busy = false;
+			return ERR_SPI_WRITE;
+		}
+	}
+	return SCN_OK;
+}
+
+static scn_err_t bus_write(uint32_t addr, const uint8_t *src, size_t len, bool dma)
+{
+	uint8_t wren   = FRAM_OP_WREN;
+	uint8_t cmd[3] = { FRAM_OP_WRITE, (uint8_t)(addr >> 8), (uint8_t)addr };
+
+	cs_low();
+	HAL_StatusTypeDef st = HAL_SPI_Transmit(&FRAM_SPI, &wren, 1, FRAM_DMA_TIMEOUT_MS);
+	cs_high();
+
+	cs_low();
+	if (st == HAL_OK) {
+		st = HAL_SPI_Transmit(&FRAM_SPI, cmd, FRAM_CMD_LEN, FRAM_DMA_TIMEOUT_MS);
+	}
+	if (st == HAL_OK && dma) {
+		/* CS relâché par HAL_SPI_TxCpltCallback */
+		s_busy = true;
+		if (HAL_SPI_Transmit_DMA(&FRAM_SPI, (uint8_t *)src, (uint16_t)len) == HAL_OK) {
+			return SCN_OK;
+		}
+		s_busy = false;
+		st = HAL_ERROR;
+	} else if (st == HAL_OK) {
+		st = HAL_SPI_Transmit(&FRAM_SPI, (uint8_t *)src, (uint16_t)len, FRAM_DMA_TIMEOUT_MS);
+	}
+	cs_high();
+	return (st == HAL_OK) ? SCN_OK : ERR_SPI_WRITE;
+}
+
+static scn_err_t bus_read(uint32_t addr, uint8_t *dst, size_t len)
+{
+	uint8_t cmd[3] = { FRAM_OP_READ, (uint8_t)(addr >> 8), (uint8_t)addr };
+
+	cs_low();
+	HAL_StatusTypeDef st = HAL_SPI_Transmit(&FRAM_SPI, cmd, FRAM_CMD_LEN, FRAM_DMA_TIMEOUT_MS);
+	if (st == HAL_OK) {
+		st = HAL_SPI_Receive(&FRAM_SPI, dst, (uint16_t)len, FRAM_DMA_TIMEOUT_MS);
+	}
+	cs_high();
+	return (st == HAL_OK) ? SCN_OK : ERR_SPI_READ;
+}
+
+/* Callbacks HAL (contexte IT DMA2_Stream3) */
+static void dma_done_isr(void)
+{
+	BaseType_t woken = pdFALSE;
+	cs_high();
+	s_busy = false;
+	xSemaphoreGiveFromISR(s_semDone, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == FRAM_SPI.Instance) {
+		dma_done_isr();
+	}
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == FRAM_SPI.Instance) {
+		s_stats.errors++;
+		dma_done_isr();
+	}
+}
+
+#endif /* SIM_TARGET */
+
+/* API */
+scn_err_t Fram_Init(void)
+{
+	s_fill = 0U;
+	s_busy = false;
+	memset(&s_stats, 0, sizeof(s_stats));
+	return bus_init();
+}
+
+scn_err_t Fram_Read(uint32_t addr, uint8_t *dst, size_t len)
+{
+	if (!in_range(addr, len)) {
+		return ERR_FRAM_RANGE;
+	}
+	scn_err_t err = bus_wait();
+	if (err == SCN_OK) {
+		err = bus_read(addr, dst, len);
+	}
+	s_stats.transactions++;
+	s_stats.cmd_bytes  += FRAM_CMD_LEN;
+	s_stats.data_bytes += (uint32_t)len;
+	if (err != SCN_OK) {
+		s_stats.errors++;
+	}
+	return err;
+}
+
+scn_err_t Fram_Write(uint32_t addr, const uint8_t *src, size_t len)
+{
+	if (!in_range(addr, len)) {
+		return ERR_FRAM_RANGE;
+	}
+	scn_err_t err = bus_wait();
+	if (err == SCN_OK) {
+		err = bus_write(addr, src, len, false);
+	}
+	s_stats.transactions += 2U;                    /* WREN + WRITE */
+	s_stats.cmd_bytes    += 1U + FRAM_CMD_LEN;
+	s_stats.data_bytes   += (uint32_t)len;
+	if (err != SCN_OK) {
+		s_stats.errors++;
+	}
+	return err;
+}
+
+uint8_t *Fram_StageBuffer(void)
+{
+	return s_stage[s_fill];
+}
+
+scn_err_t Fram_StageSubmit(uint32_t addr, size_t len)
+{
+	if (len > FRAM_STAGE_SIZE || !in_range(addr, len)) {
+		return ERR_FRAM_RANGE;
+	}
+
+	/* Le bus ne porte qu'un transfert : on attend l'autre buffer avant de lancer celui-ci */
+	scn_err_t err = bus_wait();
+	if (err == SCN_OK) {
+		err = bus_write(addr, s_stage[s_fill], len, true);
+	}
+	s_stats.transactions += 2U;
+	s_stats.cmd_bytes    += 1U + FRAM_CMD_LEN;
+	s_stats.data_bytes   += (uint32_t)len;
+	if (err != SCN_OK) {
+		s_stats.errors++;
+	}
+
+	s_fill ^= 1U;                                  /* l'appelant remplit l'autre buffer */
+	return err;
+}
+
+scn_err_t Fram_Flush(void)
+{
+	scn_err_t err = bus_wait();
+	if (err != SCN_OK) {
+		s_stats.errors++;
+	}
+	return err;
+}
+
+void Fram_GetStats(fram_stats_t *st)
+{
+	*st = s_stats;
+}
+
+void Fram_ResetStats(void)
+{
+	memset(&s_stats, 0, sizeof(s_stats));
+#if SIM_TARGET
+	s_bus_ns = 0U;                                 /* l'usure, elle, n'est jamais remise à zéro */
+#endif
+}
@@ -0,0 +1,913 @@
+/**
+ * @file    logger.c
+ * @brief   Ring buffer RAM lock-free mono-producteur / mono-consommateur.
+ *          task_proc ajoute les entrées, le chemin de commit les vide vers
+ *          la FRAM, sans mutex ni section critique.
+ *          Codec compact (keyframes + deltas) pour le stockage FRAM.
+ *          Journal FRAM découpé en segments à en-tête (seq, ts) et blocs à
+ *          marqueur de commit : cohérent après coupure d'alim, boot en temps
+ *          borné, lectures par plage de temps en O(log n).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "logger.h"
+#include "crc_utils.h"
+#include "fram_spi.h"
+#include <string.h>
+
+#if !SIM_TARGET
+  #include "FreeRTOS.h"
+  #include "semphr.h"
+#endif
+
+/* Indexation par masque : la capacité doit être une puissance de 2 */
+#define RING_MASK   ((uint32_t)LOGGER_RING_CAPACITY - 1U)
+typedef char logger_cap_pow2_check[((LOGGER_RING_CAPACITY & RING_MASK) == 0U) ? 1 : -1];
+
+/* Barrières acquire/release sur les index
+ * Wiki : le producteur publie head APRES avoir écrit l'entrée (release),
+ *        le consommateur lit head AVANT de lire l'entrée (acquire).
+ *        Idem dans l'autre sens pour tail (libération des cases).
+ */
+#if SIM_TARGET
+  #include <stdatomic.h>
+  typedef atomic_uint_fast32_t ring_idx_t;
+  #define IDX_LOAD_RLX(p)      ((uint32_t)atomic_load_explicit((p), memory_order_relaxed))
+  #define IDX_LOAD_ACQ(p)      ((uint32_t)atomic_load_explicit((p), memory_order_acquire))
+  #define IDX_STORE_REL(p, v)  atomic_store_explicit((p), (v), memory_order_release)
+#else
+  /* Cortex-M4 mono-coeur : accès 32 bits atomiques, un DMB ordonne données/index */
+  typedef volatile uint32_t ring_idx_t;
+  static inline uint32_t idx_load_acq(const ring_idx_t *p) { uint32_t v = *p; __DMB(); return v; }
+  static inline void     idx_store_rel(ring_idx_t *p, uint32_t v) { __DMB(); *p = v; }
+  #define IDX_LOAD_RLX(p)      (*(p))
+  #define IDX_LOAD_ACQ(p)      idx_load_acq(p)
+  #define IDX_STORE_REL(p, v)  idx_store_rel((p), (v))
+#endif
+
+/* Lot d'entrées lues dans le ring par le chemin de commit */
+#define COMMIT_BATCH   16U
+
+/* Payload max d'un bloc : en-têtes segment/bloc, bourrage (3), CRC-32 (4) et terminateur (1) retirés du slot */
+#define BLK_PAYLOAD_MAX   (FRAM_SLOT_SIZE - SEG_HDR_SIZE - LOGGER_BLK_HDR_SIZE - 3U - 4U - 1U)
+
+/* Journal : FRAM_JOURNAL_BASE..fin découpé en segments (un par slot), un bloc ne chevauche jamais
+ * deux segments. Segment = en-tête (magic | seq | ts du 1er bloc | CRC-8) puis blocs.
+ * Commit d'un bloc : écrit avec magic = 0x00, suivi d'un octet nul (terminateur), puis magic posé
+ * seul une fois le bloc entier en FRAM. Une coupure laisse donc soit un bloc complet, soit 0x00.
+ * Index (en-tête FRAM) : copie (seq, ts) par segment pour les outils, réparée au boot.
+ */
+#define SEG_MAGIC         0x5EU
+#define SEG_HDR_SIZE      LOGGER_SEG_HDR_SIZE
+#define JRNL_SLOTS        ((FRAM_SIZE_BYTES - FRAM_JOURNAL_BASE) / FRAM_SLOT_SIZE)
+#define IDX_ENTRY_SIZE    10U
+#define IDX_BYTES         (JRNL_SLOTS * IDX_ENTRY_SIZE)
+#define SLOT_ADDR(i)      (FRAM_JOURNAL_BASE + (uint32_t)(i) * FRAM_SLOT_SIZE)
+#define SLOT_END(i)       (SLOT_ADDR(i) + FRAM_SLOT_SIZE)
+#define RDBUF_SIZE        ((IDX_BYTES > FRAM_SLOT_SIZE) ? IDX_BYTES : FRAM_SLOT_SIZE)
+typedef char logger_idx_fits_check[((FRAM_INDEX_BASE + IDX_BYTES) <= FRAM_JOURNAL_BASE) ? 1 : -1];
+typedef char logger_stage_fits_check[((FRAM_SLOT_SIZE - SEG_HDR_SIZE) <= FRAM_STAGE_SIZE) ? 1 : -1];
+
+typedef struct {
+    uint32_t seq;        // numéro du segment (croissant), 0 = invalide
+    uint32_t ts_first;   // horodatage de la 1re entrée du segment
+} idx_entry_t;
+
+/* Accès journal partagés entre task_log (commit) et task_cli (lectures) */
+#if SIM_TARGET
+  #define JRNL_LOCK()
+  #define JRNL_UNLOCK()
+#else
+  static SemaphoreHandle_t s_mtxJrnl = NULL;
+  static StaticSemaphore_t s_mtxJrnlBuf;
+  #define JRNL_LOCK()      (void)xSemaphoreTake(s_mtxJrnl, portMAX_DELAY)
+  #define JRNL_UNLOCK()    (void)xSemaphoreGive(s_mtxJrnl)
+#endif
+
+/* ---------- État (scope fichier) ---------- */
+/* Index libres (non masqués) : head - tail = nombre d'entrées, sans ambiguïté plein/vide */
+static log_entry_t s_ring[LOGGER_RING_CAPACITY];
+static ring_idx_t  s_head;      /* écrit par le producteur uniquement   */
+static ring_idx_t  s_tail;      /* écrit par le consommateur uniquement */
+static ring_idx_t  s_dropped;   /* écrit par le producteur uniquement   */
+
+/* Chemin de commit (consommateur) */
+static log_entry_t s_batch[COMMIT_BATCH];
+static size_t      s_batch_n;   /* entrées valides dans s_batch     */
+static size_t      s_batch_i;   /* prochaine entrée à encoder       */
+
+/* Journal FRAM (sous JRNL_LOCK) */
+static idx_entry_t s_idx[JRNL_SLOTS];   /* miroir RAM des en-têtes de segments      */
+static uint32_t    s_seq;               /* seq du segment de tête (0 : journal vide) */
+static uint32_t    s_slot;              /* slot du segment de tête                  */
+static uint32_t    s_wr_addr;           /* prochaine adresse d'écriture FRAM        */
+static uint32_t    s_pend_addr;         /* bloc écrit dont le magic reste à poser (0 : aucun) */
+static uint32_t    s_ts_offset;         /* rend l'horodatage monotone entre boots    */
+static uint8_t     s_rdbuf[RDBUF_SIZE];    /* index/segment (boot) ou segment (lectures) */
+
+static void jrnl_recover(void);
+
+/* API */
+void Logger_Init(void)
+{
+	/* A appeler avant le démarrage du scheduler, après Fram_Init() */
+	IDX_STORE_REL(&s_head, 0U);
+	IDX_STORE_REL(&s_tail, 0U);
+	IDX_STORE_REL(&s_dropped, 0U);
+	s_batch_n = 0U;
+	s_batch_i = 0U;
+
+#if !SIM_TARGET
+	s_mtxJrnl = xSemaphoreCreateMutexStatic(&s_mtxJrnlBuf);
+	configASSERT(s_mtxJrnl);
+#endif
+	jrnl_recover();
+}
+
+bool Logger_Append(const log_entry_t *e)
+{
+	uint32_t head = IDX_LOAD_RLX(&s_head);          /* notre propre index */
+	uint32_t tail = IDX_LOAD_ACQ(&s_tail);          /* case libérée par le consommateur */
+
+	if ((uint32_t)(head - tail) >= (uint32_t)LOGGER_RING_CAPACITY) {
+		/* Ring plein : on garde l'historique non commité, la nouvelle entrée est perdue */
+		IDX_STORE_REL(&s_dropped, IDX_LOAD_RLX(&s_dropped) + 1U);
+		return false;
+	}
+
+	log_entry_t *slot = &s_ring[head & RING_MASK];
+	*slot = *e;
+	slot->ts_ms += s_ts_offset;
+	slot->crc8   = Logger_EntryCrc(slot);
+	IDX_STORE_REL(&s_head, head + 1U);              /* publication de l'entrée */
+	return true;
+}
+
+size_t Logger_Drain(log_entry_t *dst, size_t max)
+{
+	uint32_t tail  = IDX_LOAD_RLX(&s_tail);
+	uint32_t head  = IDX_LOAD_ACQ(&s_head);
+	uint32_t avail = head - tail;
+	size_t   n     = (avail < max) ? (size_t)avail : max;
+
+	/* Copie en au plus deux blocs contigus (avant/après le repli du ring) */
+	uint32_t first = tail & RING_MASK;
+	size_t   run   = (size_t)LOGGER_RING_CAPACITY - first;
+	if (run > n) {
+		run = n;
+	}
+	for (size_t i = 0; i < run; i++) {
+		dst[i] = s_ring[first + i];
+	}
+	for (size_t i = run; i < n; i++) {
+		dst[i] = s_ring[i - run];
+	}
+
+	IDX_STORE_REL(&s_tail, tail + (uint32_t)n);     /* libère les cases lues */
+	return n;
+}
+
+/* ---------- Codec FRAM ----------
+ * Wiki : format d'un buffer encodé = suite de groupes
+ *   KEY  ts dt t rh tmcu vin door flags      (entrée complète, varints)
+ *   DELTA|REPEAT ...                         (jusqu'à LOGGER_KEYFRAME_INTERVAL entrées)
+ *   GRP_END crc8                             (CRC-8 des octets KEY..dernier jeton)
+ * Un groupe est décodable seul : point d'entrée possible pour index/recovery.
+ */
+#define TAG_REPEAT        0x80U    /* 1nnnnnnn : n+1 entrées identiques, même écart */
+#define TAG_KEY           0x40U    /* keyframe                                      */
+#define TAG_GRP_END       0x41U    /* fin de groupe + CRC-8                         */
+#define TAG_DELTA_MASK    0x3FU    /* 00mmmmmm : champs présents (DELTA_*)          */
+#define DELTA_DT          (1U << 0)
+#define DELTA_T           (1U << 1)
+#define DELTA_RH          (1U << 2)
+#define DELTA_TMCU        (1U << 3)
+#define DELTA_VIN         (1U << 4)
+#define DELTA_DOOR_FLAGS  (1U << 5)
+#define REPEAT_MAX        128U
+#define VARINT_MAX        5U
+
+static inline uint32_t zz_enc(int32_t v)
+{
+	return (v < 0) ? (((~(uint32_t)v) << 1) | 1U) : ((uint32_t)v << 1);
+}
+
+static inline int32_t zz_dec(uint32_t v)
+{
+	return (v & 1U) ? (int32_t)~(v >> 1) : (int32_t)(v >> 1);
+}
+
+static size_t put_varint(uint8_t *p, uint32_t v)
+{
+	size_t n = 0;
+	while (v >= 0x80U) {
+		p[n++] = (uint8_t)(v | 0x80U);
+		v >>= 7;
+	}
+	p[n++] = (uint8_t)v;
+	return n;
+}
+
+static bool get_varint(const uint8_t *buf, size_t len, size_t *pos, uint32_t *v)
+{
+	uint32_t r = 0;
+	for (uint32_t i = 0; i < VARINT_MAX; i++) {
+		if (*pos >= len) {
+			return false;
+		}
+		uint8_t b = buf[(*pos)++];
+		r |= (uint32_t)(b & 0x7FU) << (7U * i);
+		if ((b & 0x80U) == 0U) {
+			*v = r;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool skip_varints(const uint8_t *buf, size_t len, size_t *pos, uint32_t count)
+{
+	uint32_t dummy;
+	while (count--) {
+		if (!get_varint(buf, len, pos, &dummy)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Nombre de varints d'un jeton DELTA (bits DT..VIN) */
+static uint32_t delta_varints(uint8_t mask)
+{
+	uint32_t n = 0;
+	for (uint8_t m = mask & (DELTA_DOOR_FLAGS - 1U); m != 0U; m &= (uint8_t)(m - 1U)) {
+		n++;
+	}
+	return n;
+}
+
+/* Parcourt un groupe sans le décoder : position du GRP_END, false si tronqué */
+static bool grp_scan(const uint8_t *buf, size_t len, size_t pos, size_t *end)
+{
+	pos++;                                              /* TAG_KEY */
+	if (!skip_varints(buf, len, &pos, 6U) || (len - pos) < 2U) {
+		return false;
+	}
+	pos += 2U;                                          /* door, flags */
+	while (pos < len) {
+		uint8_t tag = buf[pos];
+		if (tag == TAG_GRP_END) {
+			*end = pos;
+			return (len - pos) >= 2U;
+		}
+		pos++;
+		if ((tag & TAG_REPEAT) != 0U) {
+			continue;
+		}
+		if ((tag & ~TAG_DELTA_MASK) != 0U || tag == 0U) {
+			return false;                               /* jeton inconnu */
+		}
+		if (!skip_varints(buf, len, &pos, delta_varints(tag))) {
+			return false;
+		}
+		if ((tag & DELTA_DOOR_FLAGS) != 0U) {
+			if ((len - pos) < 2U) {
+				return false;
+			}
+			pos += 2U;
+		}
+	}
+	return false;
+}
+
+uint8_t Logger_EntryCrc(const log_entry_t *e)
+{
+	/* Sérialisation little-endian explicite : indépendante du padding de la struct */
+	uint8_t b[14];
+	b[0]  = (uint8_t)e->ts_ms;            b[1]  = (uint8_t)(e->ts_ms >> 8);
+	b[2]  = (uint8_t)(e->ts_ms >> 16);    b[3]  = (uint8_t)(e->ts_ms >> 24);
+	b[4]  = (uint8_t)e->t_cC;             b[5]  = (uint8_t)((uint16_t)e->t_cC >> 8);
+	b[6]  = (uint8_t)e->rh_pm;            b[7]  = (uint8_t)(e->rh_pm >> 8);
+	b[8]  = (uint8_t)e->tmcu_cC;          b[9]  = (uint8_t)((uint16_t)e->tmcu_cC >> 8);
+	b[10] = (uint8_t)e->vin_mV;           b[11] = (uint8_t)(e->vin_mV >> 8);
+	b[12] = e->door;                      b[13] = e->flags;
+	return Crc8_Compute(b, sizeof(b));
+}
+
+void Logger_EncBegin(logger_enc_t *enc)
+{
+	enc->prev      = (log_entry_t){0};
+	enc->dt_ms     = 0U;
+	enc->since_key = 0U;
+	enc->grp_pos   = -1;
+	enc->run_pos   = -1;
+}
+
+bool Logger_EncPut(logger_enc_t *enc, const log_entry_t *e, uint8_t *buf, size_t cap, size_t *pos)
+{
+	size_t p = *pos;
+	if (p > cap || (cap - p) < LOGGER_REC_MAX) {
+		return false;
+	}
+
+	const log_entry_t *pv = &enc->prev;
+	uint32_t dt = (enc->grp_pos >= 0) ? (e->ts_ms - pv->ts_ms) : enc->dt_ms;
+
+	if (enc->grp_pos < 0 || enc->since_key >= LOGGER_KEYFRAME_INTERVAL) {
+		/* Keyframe : état complet, le groupe se décode sans contexte */
+		Logger_EncEnd(enc, buf, &p);
+		enc->grp_pos = (int32_t)p;
+		buf[p++] = TAG_KEY;
+		p += put_varint(&buf[p], e->ts_ms);
+		p += put_varint(&buf[p], dt);
+		p += put_varint(&buf[p], zz_enc(e->t_cC));
+		p += put_varint(&buf[p], e->rh_pm);
+		p += put_varint(&buf[p], zz_enc(e->tmcu_cC));
+		p += put_varint(&buf[p], e->vin_mV);
+		buf[p++] = e->door;
+		buf[p++] = e->flags;
+		enc->since_key = 0U;
+	} else {
+		uint8_t mask = 0U;
+		if (dt != enc->dt_ms)                                  mask |= DELTA_DT;
+		if (e->t_cC != pv->t_cC)                               mask |= DELTA_T;
+		if (e->rh_pm != pv->rh_pm)                             mask |= DELTA_RH;
+		if (e->tmcu_cC != pv->tmcu_cC)                         mask |= DELTA_TMCU;
+		if (e->vin_mV != pv->vin_mV)                           mask |= DELTA_VIN;
+		if (e->door != pv->door || e->flags != pv->flags)      mask |= DELTA_DOOR_FLAGS;
+
+		if (mask == 0U) {
+			/* RLE : prolonge le jeton de répétition courant si possible */
+			if (enc->run_pos >= 0 && (buf[enc->run_pos] & (uint8_t)~TAG_REPEAT) < (REPEAT_MAX - 1U)) {
+				buf[enc->run_pos]++;
+			} else {
+				enc->run_pos = (int32_t)p;
+				buf[p++] = TAG_REPEAT;
+			}
+		} else {
+			buf[p++] = mask;
+			if (mask & DELTA_DT)   p += put_varint(&buf[p], dt);
+			if (mask & DELTA_T)    p += put_varint(&buf[p], zz_enc((int32_t)e->t_cC - pv->t_cC));
+			if (mask & DELTA_RH)   p += put_varint(&buf[p], zz_enc((int32_t)e->rh_pm - pv->rh_pm));
+			if (mask & DELTA_TMCU) p += put_varint(&buf[p], zz_enc((int32_t)e->tmcu_cC - pv->tmcu_cC));
+			if (mask & DELTA_VIN)  p += put_varint(&buf[p], zz_enc((int32_t)e->vin_mV - pv->vin_mV));
+			if (mask & DELTA_DOOR_FLAGS) {
+				buf[p++] = e->door;
+				buf[p++] = e->flags;
+			}
+			enc->run_pos = -1;
+		}
+	}
+
+	enc->since_key++;
+	enc->prev  = *e;
+	enc->dt_ms = dt;
+	*pos = p;
+	return true;
+}
+
+void Logger_EncEnd(logger_enc_t *enc, uint8_t *buf, size_t *pos)
+{
+	if (enc->grp_pos < 0) {
+		return;
+	}
+	size_t  p   = *pos;
+	uint8_t crc = Crc8_Compute(&buf[enc->grp_pos], p - (size_t)enc->grp_pos);
+	buf[p++] = TAG_GRP_END;
+	buf[p++] = crc;
+	enc->grp_pos = -1;
+	enc->run_pos = -1;
+	*pos = p;
+}
+
+void Logger_DecBegin(logger_dec_t *dec)
+{
+	dec->prev    = (log_entry_t){0};
+	dec->dt_ms   = 0U;
+	dec->grp_pos = 0U;
+	dec->run     = 0U;
+	dec->in_grp  = false;
+}
+
+bool Logger_DecNext(logger_dec_t *dec, const uint8_t *buf, size_t len, size_t *pos, log_entry_t *out)
+{
+	log_entry_t *pv = &dec->prev;
+	size_t p = *pos;
+	uint32_t v = 0;
+
+	if (dec->run != 0U) {
+		dec->run--;
+		pv->ts_ms += dec->dt_ms;
+		pv->crc8 = Logger_EntryCrc(pv);
+		*out = *pv;
+		return true;
+	}
+
+	for (;;) {
+		if (p >= len) {
+			return false;
+		}
+		uint8_t tag = buf[p];
+
+		if (tag == TAG_GRP_END) {
+			p += 2U;                                    /* CRC déjà vérifié à la keyframe */
+			dec->in_grp = false;
+			continue;
+		}
+
+		if (tag == TAG_KEY) {
+			/* Groupe validé en entier avant d'émettre sa première entrée */
+			size_t end;
+			if (!grp_scan(buf, len, p, &end) || Crc8_Compute(&buf[p], end - p) != buf[end + 1U]) {
+				return false;
+			}
+			dec->grp_pos = p++;
+			(void)get_varint(buf, len, &p, &v);  pv->ts_ms   = v;
+			(void)get_varint(buf, len, &p, &v);  dec->dt_ms  = v;
+			(void)get_varint(buf, len, &p, &v);  pv->t_cC    = (int16_t)zz_dec(v);
+			(void)get_varint(buf, len, &p, &v);  pv->rh_pm   = (uint16_t)v;
+			(void)get_varint(buf, len, &p, &v);  pv->tmcu_cC = (int16_t)zz_dec(v);
+			(void)get_varint(buf, len, &p, &v);  pv->vin_mV  = (uint16_t)v;
+			pv->door  = buf[p++];
+			pv->flags = buf[p++];
+			dec->in_grp = true;
+			break;
+		}
+
+		if (!dec->in_grp) {
+			return false;                               /* delta sans keyframe */
+		}
+		p++;
+
+		if ((tag & TAG_REPEAT) != 0U) {
+			dec->run = (uint8_t)(tag & (uint8_t)~TAG_REPEAT);
+			pv->ts_ms += dec->dt_ms;
+			break;
+		}
+
+		/* DELTA : bornes déjà contrôlées par grp_scan */
+		if (tag & DELTA_DT)   { (void)get_varint(buf, len, &p, &v); dec->dt_ms = v; }
+		pv->ts_ms += dec->dt_ms;
+		if (tag & DELTA_T)    { (void)get_varint(buf, len, &p, &v); pv->t_cC    = (int16_t)(pv->t_cC + zz_dec(v)); }
+		if (tag & DELTA_RH)   { (void)get_varint(buf, len, &p, &v); pv->rh_pm   = (uint16_t)(pv->rh_pm + zz_dec(v)); }
+		if (tag & DELTA_TMCU) { (void)get_varint(buf, len, &p, &v); pv->tmcu_cC = (int16_t)(pv->tmcu_cC + zz_dec(v)); }
+		if (tag & DELTA_VIN)  { (void)get_varint(buf, len, &p, &v); pv->vin_mV  = (uint16_t)(pv->vin_mV + zz_dec(v)); }
+		if (tag & DELTA_DOOR_FLAGS) {
+			pv->door  = buf[p++];
+			pv->flags = buf[p++];
+		}
+		break;
+	}
+
+	pv->crc8 = Logger_EntryCrc(pv);
+	*out = *pv;
+	*pos = p;
+	return true;
+}
+
+/* ---------- Blocs journal / commit ---------- */
+/* Complète l'en-tête/bourrage/CRC d'un bloc dont le payload fait len octets, retourne sa taille */
+static size_t blk_seal(uint8_t *blk, size_t len)
+{
+	uint8_t *payload = &blk[LOGGER_BLK_HDR_SIZE];
+	while ((len & 3U) != 0U) {
+		payload[len++] = 0x00U;                         /* jeton nul = fin de données */
+	}
+
+	blk[0] = LOGGER_BLK_MAGIC;
+	blk[1] = LOGGER_BLOCK_CRC32 ? LOGGER_BLK_F_CRC32 : 0x00U;
+	blk[2] = (uint8_t)len;
+	blk[3] = (uint8_t)(len >> 8);
+	size_t total = LOGGER_BLK_HDR_SIZE + len;
+
+#if LOGGER_BLOCK_CRC32
+	uint32_t crc = Crc32_Compute(payload, len);
+	blk[total++] = (uint8_t)crc;
+	blk[total++] = (uint8_t)(crc >> 8);
+	blk[total++] = (uint8_t)(crc >> 16);
+	blk[total++] = (uint8_t)(crc >> 24);
+#endif
+	return total;
+}
+
+/* Taille d'un bloc d'après son en-tête seul, 0 si non commité ou en-tête invalide */
+static size_t blk_size(const uint8_t *hdr)
+{
+	if (hdr[0] != LOGGER_BLK_MAGIC) {
+		return 0U;
+	}
+	size_t len = (size_t)hdr[2] | ((size_t)hdr[3] << 8);
+	if ((len & 3U) != 0U) {
+		return 0U;
+	}
+	return LOGGER_BLK_HDR_SIZE + len + (((hdr[1] & LOGGER_BLK_F_CRC32) != 0U) ? 4U : 0U);
+}
+
+scn_err_t Logger_CheckBlock(const uint8_t *blk, size_t avail, size_t *blk_len)
+{
+	if (avail < LOGGER_BLK_HDR_SIZE) {
+		return ERR_FRAM_CRC;
+	}
+	size_t total = blk_size(blk);
+	if (total == 0U || total > avail) {
+		return ERR_FRAM_CRC;
+	}
+
+	size_t         len     = (size_t)blk[2] | ((size_t)blk[3] << 8);
+	const uint8_t *payload = &blk[LOGGER_BLK_HDR_SIZE];
+	if ((blk[1] & LOGGER_BLK_F_CRC32) != 0U) {
+		/* Une seule passe sur le bloc */
+		const uint8_t *t = &payload[len];
+		uint32_t stored = (uint32_t)t[0] | ((uint32_t)t[1] << 8) | ((uint32_t)t[2] << 16) | ((uint32_t)t[3] << 24);
+		if (Crc32_Compute(payload, len) != stored) {
+			return ERR_FRAM_CRC;
+		}
+	} else {
+		/* Repli : décodage complet, chaque groupe vérifié par son CRC-8 */
+		logger_dec_t dec;
+		log_entry_t  e;
+		size_t       pos = 0U;
+		Logger_DecBegin(&dec);
+		while (Logger_DecNext(&dec, payload, len, &pos, &e)) {
+		}
+		while (pos < len && payload[pos] == TAG_GRP_END) {
+			pos += 2U;
+		}
+		if (pos < len && payload[pos] != 0x00U) {
+			return ERR_FRAM_CRC;                        /* arrêt avant le bourrage : groupe invalide */
+		}
+	}
+
+	*blk_len = total;
+	return SCN_OK;
+}
+
+/* (seq, ts_first) + CRC-8 : format commun aux en-têtes de segment et à l'index */
+static void seqts_pack(uint8_t *b, uint32_t seq, uint32_t ts_first)
+{
+	b[0] = (uint8_t)seq;        b[1] = (uint8_t)(seq >> 8);
+	b[2] = (uint8_t)(seq >> 16);  b[3] = (uint8_t)(seq >> 24);
+	b[4] = (uint8_t)ts_first;   b[5] = (uint8_t)(ts_first >> 8);
+	b[6] = (uint8_t)(ts_first >> 16); b[7] = (uint8_t)(ts_first >> 24);
+	b[8] = Crc8_Compute(b, 8U);
+}
+
+static void seqts_parse(const uint8_t *b, idx_entry_t *ie)
+{
+	if (Crc8_Compute(b, 8U) != b[8]) {
+		ie->seq = 0U;
+		ie->ts_first = 0U;
+		return;
+	}
+	ie->seq      = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+	ie->ts_first = (uint32_t)b[4] | ((uint32_t)b[5] << 8) | ((uint32_t)b[6] << 16) | ((uint32_t)b[7] << 24);
+}
+
+static scn_err_t idx_write(uint32_t slot, uint32_t seq, uint32_t ts_first)
+{
+	uint8_t b[IDX_ENTRY_SIZE];
+	seqts_pack(b, seq, ts_first);
+	b[9] = 0x00U;
+	return Fram_Write(FRAM_INDEX_BASE + slot * IDX_ENTRY_SIZE, b, sizeof(b));
+}
+
+static void seg_parse(const uint8_t *b, idx_entry_t *ie)
+{
+	if (b[0] != SEG_MAGIC) {
+		ie->seq = 0U;
+		ie->ts_first = 0U;
+		return;
+	}
+	seqts_parse(&b[1], ie);
+}
+
+/* Ouvre un segment sur un slot de l'ancien tour :
+ * 1er bloc de l'ancien tour effacé, puis nouvel en-tête (une coupure entre les deux
+ * laisse l'ancien segment vide ou un en-tête au CRC faux), puis copie dans l'index.
+ */
+static scn_err_t seg_open(uint32_t slot, uint32_t seq, uint32_t ts_first)
+{
+	uint8_t b[SEG_HDR_SIZE];
+	b[0] = 0x00U;
+	scn_err_t err = Fram_Write(SLOT_ADDR(slot) + SEG_HDR_SIZE, b, 1U);
+
+	s_idx[slot].seq      = 0U;
+	s_idx[slot].ts_first = 0U;
+	if (err == SCN_OK) {
+		b[0] = SEG_MAGIC;
+		seqts_pack(&b[1], seq, ts_first);
+		err = Fram_Write(SLOT_ADDR(slot), b, sizeof(b));
+	}
+	if (err == SCN_OK) {
+		s_idx[slot].seq      = seq;
+		s_idx[slot].ts_first = ts_first;
+		err = idx_write(slot, seq, ts_first);
+	}
+	return err;
+}
+
+/* Bloc commité à l'offset off d'un segment lu dans s_rdbuf (en-tête seul, sans CRC), 0 sinon */
+static size_t seg_hop(size_t off)
+{
+	if (off + LOGGER_BLK_HDR_SIZE > FRAM_SLOT_SIZE) {
+		return 0U;
+	}
+	size_t blk = blk_size(&s_rdbuf[off]);
+	return (off + blk <= FRAM_SLOT_SIZE) ? blk : 0U;
+}
+
+/* Décode les blocs valides de s_rdbuf à partir de off ; dernier horodatage dans *ts_last */
+static void seg_last_ts(size_t off, uint32_t *ts_last)
+{
+	size_t blk;
+	while (Logger_CheckBlock(&s_rdbuf[off], FRAM_SLOT_SIZE - off, &blk) == SCN_OK) {
+		logger_dec_t dec;
+		log_entry_t  e;
+		size_t       pos = 0U;
+		Logger_DecBegin(&dec);
+		while (Logger_DecNext(&dec, &s_rdbuf[off + LOGGER_BLK_HDR_SIZE], blk - LOGGER_BLK_HDR_SIZE, &pos, &e)) {
+			*ts_last = e.ts_ms;
+		}
+		off += blk;
+	}
+}
+
+/* Boot en temps borné, quel que soit le remplissage :
+ * en-têtes de segments seuls pour trouver tête (seq max) et queue, index réparé là où il
+ * diverge, puis le segment de tête est parcouru d'en-tête de bloc en en-tête de bloc
+ * (magic = marqueur de commit) ; seul le dernier bloc est vérifié et décodé.
+ */
+static void jrnl_recover(void)
+{
+	uint8_t     b[SEG_HDR_SIZE];
+	idx_entry_t ie;
+
+	s_seq  = 0U;
+	s_slot = 0U;
+	s_wr_addr   = SLOT_ADDR(0) + SEG_HDR_SIZE;
+	s_pend_addr = 0U;
+	s_ts_offset = 0U;
+
+	for (uint32_t i = 0; i < JRNL_SLOTS; i++) {
+		if (Fram_Read(SLOT_ADDR(i), b, SEG_HDR_SIZE) != SCN_OK) {
+			b[0] = 0x00U;                               /* illisible : segment ignoré */
+		}
+		seg_parse(b, &s_idx[i]);
+		if (s_idx[i].seq > s_seq) {
+			s_seq  = s_idx[i].seq;
+			s_slot = i;
+		}
+	}
+
+	if (Fram_Read(FRAM_INDEX_BASE, s_rdbuf, IDX_BYTES) == SCN_OK) {
+		for (uint32_t i = 0; i < JRNL_SLOTS; i++) {
+			seqts_parse(&s_rdbuf[i * IDX_ENTRY_SIZE], &ie);
+			if (ie.seq != s_idx[i].seq || ie.ts_first != s_idx[i].ts_first) {
+				(void)idx_write(i, s_idx[i].seq, s_idx[i].ts_first);
+			}
+		}
+	}
+	if (s_seq == 0U) {
+		return;                                         /* journal vierge */
+	}
+
+	uint32_t ts_last = s_idx[s_slot].ts_first;
+	if (Fram_Read(SLOT_ADDR(s_slot), s_rdbuf, FRAM_SLOT_SIZE) != SCN_OK) {
+		s_wr_addr   = SLOT_END(s_slot);                 /* illisible : on repart au segment suivant */
+		s_ts_offset = ts_last + 1U;
+		return;
+	}
+
+	size_t off  = SEG_HDR_SIZE;
+	size_t last = 0U;
+	size_t blk;
+	while ((blk = seg_hop(off)) != 0U) {
+		last = off;
+		off += blk;
+	}
+	s_wr_addr = SLOT_ADDR(s_slot) + (uint32_t)off;
+
+	if (last != 0U) {
+		if (Logger_CheckBlock(&s_rdbuf[last], FRAM_SLOT_SIZE - last, &blk) != SCN_OK) {
+			last = SEG_HDR_SIZE;                        /* dernier bloc altéré : segment entier décodé */
+		}
+		seg_last_ts(last, &ts_last);
+	}
+	s_ts_offset = ts_last + 1U;
+}
+
+/* Pose le magic du bloc écrit précédemment (attend la fin de son DMA) */
+static scn_err_t jrnl_seal_pending(void)
+{
+	if (s_pend_addr == 0U) {
+		return SCN_OK;
+	}
+	uint8_t magic = LOGGER_BLK_MAGIC;
+	scn_err_t err = Fram_Write(s_pend_addr, &magic, 1U);
+	if (err == SCN_OK) {
+		s_pend_addr = 0U;                               /* sinon : nouvel essai au prochain commit */
+	}
+	return err;
+}
+
+/* Réserve la place d'un bloc ; ouvre le segment suivant si besoin */
+static scn_err_t jrnl_reserve(size_t len, uint32_t ts_first)
+{
+	if (s_seq != 0U && (s_wr_addr + len) <= SLOT_END(s_slot)) {
+		return SCN_OK;
+	}
+	uint32_t next = (s_seq == 0U) ? 0U : ((s_slot + 1U) % JRNL_SLOTS);
+	s_slot    = next;
+	s_seq++;
+	s_wr_addr = SLOT_ADDR(next) + SEG_HDR_SIZE;
+	scn_err_t err = seg_open(next, s_seq, ts_first);
+	if (err != SCN_OK) {
+		s_wr_addr = SLOT_END(next);                     /* segment inutilisable : le suivant sera ouvert */
+	}
+	return err;
+}
+
+scn_err_t Logger_Commit(void)
+{
+	JRNL_LOCK();
+	/* Bloc non scellé d'un commit précédent en échec */
+	scn_err_t err = jrnl_seal_pending();
+
+	/* Une page de staging par tour : encodage de la suivante pendant le DMA de la précédente */
+	while (err == SCN_OK) {
+		uint8_t     *page    = Fram_StageBuffer();
+		uint8_t     *payload = &page[LOGGER_BLK_HDR_SIZE];
+		size_t       len     = 0U;
+		uint32_t     ts_first = 0U;
+		logger_enc_t enc;
+		Logger_EncBegin(&enc);
+
+		for (;;) {
+			if (s_batch_i == s_batch_n) {
+				s_batch_n = Logger_Drain(s_batch, COMMIT_BATCH);
+				s_batch_i = 0U;
+				if (s_batch_n == 0U) {
+					break;
+				}
+			}
+			if (len == 0U) {
+				ts_first = s_batch[s_batch_i].ts_ms;
+			}
+			if (!Logger_EncPut(&enc, &s_batch[s_batch_i], payload, BLK_PAYLOAD_MAX, &len)) {
+				break;                                  /* page pleine : reste dans s_batch */
+			}
+			s_batch_i++;
+		}
+		Logger_EncEnd(&enc, payload, &len);
+
+		if (len == 0U) {
+			break;                                      /* ring vide */
+		}
+		len = blk_seal(page, len);
+		page[0] = 0x00U;                                /* magic posé après le DMA */
+
+		err = jrnl_seal_pending();
+		if (err == SCN_OK) {
+			err = jrnl_reserve(len, ts_first);
+		}
+		if (err != SCN_OK) {
+			break;
+		}
+		/* Terminateur dans la même rafale : l'octet suivant reste à 0x00 jusqu'au prochain bloc */
+		size_t burst = len;
+		if ((s_wr_addr + len) < SLOT_END(s_slot)) {
+			page[burst++] = 0x00U;
+		}
+		err = Fram_StageSubmit(s_wr_addr, burst);
+		if (err == SCN_OK) {
+			s_pend_addr = s_wr_addr;
+			s_wr_addr  += (uint32_t)len;
+		} else {
+			s_wr_addr = SLOT_END(s_slot);               /* rafale incertaine : segment clos */
+		}
+	}
+
+	if (err == SCN_OK) {
+		err = jrnl_seal_pending();
+	}
+	scn_err_t ferr = Fram_Flush();
+	JRNL_UNLOCK();
+	return (err != SCN_OK) ? err : ferr;
+}
+
+size_t Logger_ReadFrom(uint32_t ts_from, log_entry_t *dst, size_t max)
+{
+	uint8_t order[JRNL_SLOTS];
+	size_t  n   = 0U;
+	size_t  got = 0U;
+
+	JRNL_LOCK();
+	if (s_seq == 0U) {
+		JRNL_UNLOCK();
+		return 0U;
+	}
+
+	/* Segments valides de la queue à la tête (seq croissants => ts croissants) */
+	for (uint32_t k = 1U; k <= JRNL_SLOTS; k++) {
+		uint32_t i = (s_slot + k) % JRNL_SLOTS;
+		if (s_idx[i].seq != 0U) {
+			order[n++] = (uint8_t)i;
+		}
+	}
+
+	/* Horodatages ms sur 32 bits : repliement après ~49,7 jours. Comparaisons en
+	 * arithmétique série, relativement à la 1re entrée de la queue : l'ordre reste
+	 * celui des seq tant que le journal couvre moins de 2^31 ms (~24,8 jours).
+	 * ts_from antérieur à la queue : lecture depuis le début du journal.
+	 */
+	uint32_t base = s_idx[order[0]].ts_first;
+	uint32_t from = ts_from - base;
+	if ((int32_t)from < 0) {
+		from = 0U;
+	}
+
+	/* Recherche dichotomique : dernier segment dont la 1re entrée est <= ts_from */
+	size_t lo = 0U, hi = n;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2U;
+		if (s_idx[order[mid]].ts_first - base <= from) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (size_t k = (lo != 0U) ? (lo - 1U) : 0U; k < n && got < max; k++) {
+		if (Fram_Read(SLOT_ADDR(order[k]), s_rdbuf, FRAM_SLOT_SIZE) != SCN_OK) {
+			break;
+		}
+		size_t off = SEG_HDR_SIZE;
+		size_t blk;
+		while (got < max && Logger_CheckBlock(&s_rdbuf[off], FRAM_SLOT_SIZE - off, &blk) == SCN_OK) {
+			logger_dec_t dec;
+			log_entry_t  e;
+			size_t       pos = 0U;
+			Logger_DecBegin(&dec);
+			while (got < max && Logger_DecNext(&dec, &s_rdbuf[off + LOGGER_BLK_HDR_SIZE],
+			                                   blk - LOGGER_BLK_HDR_SIZE, &pos, &e)) {
+				if (e.ts_ms - base >= from) {
+					dst[got++] = e;
+				}
+			}
+			off += blk;
+		}
+	}
+	JRNL_UNLOCK();
+	return got;
+}
+
+scn_err_t Logger_ExportSegment(uint32_t *cursor, uint8_t *dst, size_t max, size_t *len)
+{
+	uint32_t  best = 0U;
+	scn_err_t err  = SCN_OK;
+
+	*len = 0U;
+	JRNL_LOCK();
+	/* Segment le plus ancien non encore exporté */
+	for (uint32_t i = 0; i < JRNL_SLOTS; i++) {
+		uint32_t seq = s_idx[i].seq;
+		if (seq > *cursor && (best == 0U || seq < s_idx[best - 1U].seq)) {
+			best = i + 1U;
+		}
+	}
+	if (best != 0U) {
+		err = Fram_Read(SLOT_ADDR(best - 1U), s_rdbuf, FRAM_SLOT_SIZE);
+	}
+	if (best != 0U && err == SCN_OK) {
+		/* Tronqué après le dernier bloc commité (la tête peut être en cours d'écriture) */
+		size_t n = SEG_HDR_SIZE;
+		size_t blk;
+		while ((blk = seg_hop(n)) != 0U) {
+			n += blk;
+		}
+		if (n <= max) {
+			memcpy(dst, s_rdbuf, n);
+			*cursor = s_idx[best - 1U].seq;
+			*len    = n;
+		} else {
+			err = ERR_BUF_SIZE;
+		}
+	}
+	JRNL_UNLOCK();
+	return err;
+}
+
+/* ---------- Diagnostics ---------- */
+uint32_t Logger_Count(void)
+{
+	uint32_t tail = IDX_LOAD_ACQ(&s_tail);
+	uint32_t head = IDX_LOAD_ACQ(&s_head);
+	return head - tail;
+}
+
+uint32_t Logger_Dropped(void)
+{
+	return IDX_LOAD_ACQ(&s_dropped);
+}
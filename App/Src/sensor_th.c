@@ -0,0 +1,759 @@
+/**
+ * @file    sensor_th.c
+ * @brief   Driver température / humidité I2C (SHT31 ou HDC1080, détecté au boot).
+ *          Chaque capteur est décrit par un th_drv_t : séquences I2C (détection,
+ *          configuration, déclenchement, lecture) et constantes de conversion
+ *          précalculées ; le chemin de mesure ne teste jamais le modèle.
+ *          Commande et lecture partent en IT (quelques octets : le DMA
+ *          n'apporterait rien) ; la fin de transfert est signalée par sémaphore
+ *          depuis les callbacks HAL, avec timeout. Pendant une conversion
+ *          (jusqu'à 15,5 ms sur SHT31) la tâche dort : bus et CPU restent libres.
+ *          SHT31 périodique : le capteur mesure seul (ART, 4 Hz), une mesure ne
+ *          coûte plus qu'un FETCH DATA (commande + lecture en repeated start).
+ *          HDC1080 : mode séquentiel, T et HR sur un seul déclenchement.
+ *          SIM_TARGET : bus simulé avec capteurs émulés, horloge virtuelle et
+ *          injection de NACK / blocage bus / CRC faux.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "sensor_th.h"
+#include "crc_utils.h"
+#include <string.h>
+
+#if !SIM_TARGET
+  #include "FreeRTOS.h"
+  #include "task.h"
+  #include "semphr.h"
+  extern I2C_HandleTypeDef I2C_BUS;
+#endif
+
+/* Étape I2C : commande puis mots 16 bits MSB first.
+ *   cmd seule  : écriture, puis conv_ms d'attente (conversion ou prise en compte)
+ *   mots seuls : lecture
+ *   les deux   : écriture + lecture en un transfert (repeated start)
+ */
+typedef struct {
+	uint8_t cmd[3];
+	uint8_t cmd_len;
+	uint8_t words;
+	uint8_t conv_ms;
+} th_step_t;
+
+/* Driver capteur. Conversion : T[cC] = t_off + raw * t_k / 2^32, HR[‰] = raw * rh_k / 2^32 */
+typedef struct {
+	th_model_t       model;
+	uint8_t          word_len;     /* 2, ou 3 avec CRC-8 (poly 0x31, init 0xFF)          */
+	th_step_t        probe;        /* présence : ACK (words = 0) ou identifiant lu        */
+	uint16_t         probe_id;
+	const th_step_t *init;         /* configuration : premier Trigger, puis après panne   */
+	uint8_t          init_len;
+	th_step_t        trigger;      /* lancement de conversion (cmd_len = 0 : autonome)    */
+	th_step_t        fetch;        /* lecture T puis HR                                   */
+	int32_t          t_off;
+	uint32_t         t_k;
+	uint32_t         rh_k;
+} th_drv_t;
+
+#define TH_Q32(num, den)   ((uint32_t)((((uint64_t)(num) << 32) + (den) / 2U) / (den)))
+#define TH_SEQ_MAX         4U      /* configuration (2 max) + déclenchement + lecture */
+
+/* SHT31 : Break en tête de configuration (sortie d'un mode périodique laissé par un reboot MCU) */
+#if SENSOR_TH_MODE == SENSOR_TH_MODE_PERIODIC
+static const th_step_t k_sht31_init[] = {
+	{ { 0x30U, 0x93U }, 2U, 0U, 1U  },   /* Break                                      */
+	{ { 0x2BU, 0x32U }, 2U, 0U, 16U },   /* ART haute répétabilité, 1re mesure 15,5 ms */
+};
+static const th_drv_t k_sht31 = {
+	.model = TH_MODEL_SHT31, .word_len = 3U,
+	.probe   = { { 0x30U, 0x93U }, 2U, 0U, 1U },             /* Break acquitté, quel que soit le mode */
+	.init    = k_sht31_init, .init_len = 2U,
+	.trigger = { { 0U }, 0U, 0U, 0U },                        /* conversion autonome */
+	.fetch   = { { 0xE0U, 0x00U }, 2U, 2U, 0U },             /* FETCH DATA          */
+	.t_off = -4500, .t_k = TH_Q32(17500U, 65535U), .rh_k = TH_Q32(1000U, 65535U),
+};
+#else
+static const th_step_t k_sht31_init[] = {
+	{ { 0x30U, 0x93U }, 2U, 0U, 1U },    /* Break */
+};
+static const th_drv_t k_sht31 = {
+	.model = TH_MODEL_SHT31, .word_len = 3U,
+	.probe   = { { 0x30U, 0x93U }, 2U, 0U, 1U },
+	.init    = k_sht31_init, .init_len = 1U,
+	.trigger = { { 0x24U, 0x00U }, 2U, 0U, 16U },            /* single shot haute répétabilité, sans stretching */
+	.fetch   = { { 0U }, 0U, 2U, 0U },
+	.t_off = -4500, .t_k = TH_Q32(17500U, 65535U), .rh_k = TH_Q32(1000U, 65535U),
+};
+#endif
+
+static const th_step_t k_hdc1080_init[] = {
+	{ { 0x02U, 0x10U, 0x00U }, 3U, 0U, 0U },   /* Configuration : MODE=1 (T puis HR), 14 bits */
+};
+static const th_drv_t k_hdc1080 = {
+	.model = TH_MODEL_HDC1080, .word_len = 2U,
+	.probe   = { { 0xFFU }, 1U, 1U, 0U }, .probe_id = 0x1050U,   /* Device ID (0x40 est une adresse courante) */
+	.init    = k_hdc1080_init, .init_len = 1U,
+	.trigger = { { 0x00U }, 1U, 0U, 14U },                    /* T+HR : 6,35 + 6,5 ms */
+	.fetch   = { { 0U }, 0U, 2U, 0U },
+	.t_off = -4000, .t_k = TH_Q32(16500U, 65536U), .rh_k = TH_Q32(1000U, 65536U),
+};
+
+/* Ordre de détection */
+static const struct {
+	const th_drv_t *drv;
+	uint16_t        addr;
+} k_probe[] = {
+	{ &k_sht31,   SHT31_I2C_ADDR     },
+	{ &k_sht31,   SHT31_I2C_ADDR_ALT },
+	{ &k_hdc1080, HDC1080_I2C_ADDR   },
+};
+
+/* ---------- État (scope fichier) ---------- */
+static const th_drv_t  *s_drv;                   /* capteur retenu (NULL : aucun)          */
+static uint16_t         s_addr;
+static const th_step_t *s_seq[TH_SEQ_MAX];       /* étapes de la mesure en cours           */
+static uint8_t          s_nseq;
+static uint8_t          s_nsetup;                /* étapes de configuration en tête        */
+static uint8_t          s_step;
+static th_state_t       s_state;
+static uint32_t         s_t_cmd;                 /* émission de la dernière commande       */
+static uint8_t          s_rx[6];                 /* buffer de lecture IT (2 mots + CRC)    */
+static uint16_t         s_raw[2];                /* T puis HR, bruts                       */
+static uint8_t          s_nraw;
+static bool             s_setup_ok;              /* capteur configuré                      */
+static uint8_t          s_nack_run;              /* mesures NACKées consécutives           */
+static th_stats_t       s_stats;
+
+/* ---------- Accès bus ---------- */
+#if SIM_TARGET
+
+/* Capteurs émulés : durées typiques, sous les max datasheet attendus par le driver */
+#define SIM_SHT_CONV_MS    13U
+#define SIM_SHT_ART_MS     250U
+#define SIM_HDC_CONV_MS    6U      /* par grandeur */
+
+typedef struct {
+	bool     pending;              /* conversion lancée, résultat non lu    */
+	uint32_t ready;                /* fin de conversion                     */
+	bool     periodic;             /* SHT31 : mode périodique actif         */
+	bool     fetch;                /* SHT31 : FETCH DATA reçu               */
+	uint32_t t0;                   /* SHT31 : première mesure périodique    */
+	uint32_t last;                 /* SHT31 : dernière mesure périodique lue */
+	uint8_t  ptr;                  /* HDC1080 : registre pointé             */
+	uint16_t cfg;                  /* HDC1080 : registre Configuration      */
+} sim_dev_t;
+
+static uint32_t       s_sim_now;               /* horloge virtuelle (ms)         */
+static uint8_t        s_sim_present = TH_SIM_SHT31;
+static int16_t        s_sim_t_cC    = 2000;    /* grandeurs vues par les capteurs */
+static uint16_t       s_sim_rh_pm   = 500U;
+static th_sim_fault_t s_sim_fault;
+static uint8_t        s_sim_fault_n;           /* transferts encore affectés     */
+static scn_err_t      s_sim_done;              /* issue du transfert en cours    */
+static bool           s_sim_hang;              /* transfert sans IT de fin       */
+static sim_dev_t      s_sim_sht[2];            /* 0x44, 0x45                     */
+static sim_dev_t      s_sim_hdc;
+
+static uint16_t sim_clamp(int32_t v)
+{
+	return (uint16_t)((v < 0) ? 0 : ((v > 0xFFFF) ? 0xFFFF : v));
+}
+
+static bool sim_busy(const sim_dev_t *d)
+{
+	return d->pending && (int32_t)(s_sim_now - d->ready) < 0;
+}
+
+static void sim_put(uint8_t *buf, uint8_t len, uint8_t word_len, const uint16_t *w)
+{
+	for (uint8_t i = 0; (i + 1U) * word_len <= len; i++) {
+		uint8_t *p = &buf[i * word_len];
+		p[0] = (uint8_t)(w[i] >> 8);
+		p[1] = (uint8_t)w[i];
+		if (word_len == 3U) {
+			p[2] = Crc8_Compute(p, 2U);
+		}
+	}
+}
+
+/* SHT31 émulé */
+static scn_err_t sim_sht_write(sim_dev_t *d, const uint8_t *buf, uint8_t len)
+{
+	if (sim_busy(d)) {
+		return ERR_I2C_NACK;                       /* conversion en cours : adresse NACKée */
+	}
+	uint16_t cmd = (len == 2U) ? (uint16_t)((buf[0] << 8) | buf[1]) : 0U;
+	if (cmd == 0x3093U) {                          /* Break */
+		d->periodic = false;
+		d->pending  = false;
+		return SCN_OK;
+	}
+	if (d->periodic) {
+		d->fetch = (cmd == 0xE000U);               /* seul FETCH DATA accepté en périodique */
+		return d->fetch ? SCN_OK : ERR_I2C_NACK;
+	}
+	if (cmd == 0x2B32U) {
+		d->periodic = true;
+		d->fetch    = false;
+		d->t0       = s_sim_now + SIM_SHT_CONV_MS;
+		d->last     = UINT32_MAX;
+		return SCN_OK;
+	}
+	if (cmd != 0x2400U) {
+		return ERR_I2C_NACK;
+	}
+	d->ready   = s_sim_now + SIM_SHT_CONV_MS;
+	d->pending = true;
+	return SCN_OK;
+}
+
+static scn_err_t sim_sht_read(sim_dev_t *d, uint8_t *buf, uint8_t len)
+{
+	if (d->periodic) {
+		uint32_t id = (uint32_t)(s_sim_now - d->t0) / SIM_SHT_ART_MS;
+		if (!d->fetch || (int32_t)(s_sim_now - d->t0) < 0 || id == d->last) {
+			return ERR_I2C_NACK;                   /* pas de mesure nouvelle depuis le dernier fetch */
+		}
+		d->fetch = false;
+		d->last  = id;
+	} else {
+		if (!d->pending || sim_busy(d)) {
+			return ERR_I2C_NACK;                   /* rien à lire ou conversion non finie */
+		}
+		d->pending = false;
+	}
+	uint16_t w[2] = {
+		sim_clamp(((int32_t)s_sim_t_cC + 4500) * 65535 / 17500),
+		sim_clamp((int32_t)s_sim_rh_pm * 65535 / 1000),
+	};
+	sim_put(buf, len, 3U, w);
+	return SCN_OK;
+}
+
+/* HDC1080 émulé */
+static scn_err_t sim_hdc_write(sim_dev_t *d, const uint8_t *buf, uint8_t len)
+{
+	if (sim_busy(d)) {
+		return ERR_I2C_NACK;
+	}
+	if (len == 3U && buf[0] == 0x02U) {
+		d->cfg = (uint16_t)((buf[1] << 8) | buf[2]);
+		return SCN_OK;
+	}
+	if (len != 1U || (buf[0] > 0x01U && buf[0] < 0xFEU)) {
+		return ERR_I2C_NACK;
+	}
+	d->ptr = buf[0];
+	if (d->ptr <= 0x01U) {
+		d->ready   = s_sim_now + (((d->cfg & 0x1000U) && d->ptr == 0x00U) ? 2U : 1U) * SIM_HDC_CONV_MS;
+		d->pending = true;
+	}
+	return SCN_OK;
+}
+
+static scn_err_t sim_hdc_read(sim_dev_t *d, uint8_t *buf, uint8_t len)
+{
+	uint16_t w[2];
+	if (d->ptr >= 0xFEU) {
+		w[0] = (d->ptr == 0xFEU) ? 0x5449U : 0x1050U;   /* Manufacturer / Device ID */
+	} else {
+		if (!d->pending || sim_busy(d)) {
+			return ERR_I2C_NACK;
+		}
+		d->pending = false;
+		uint16_t t  = (uint16_t)(sim_clamp(((int32_t)s_sim_t_cC + 4000) * 65536 / 16500) & 0xFFFCU);
+		uint16_t rh = (uint16_t)(sim_clamp((int32_t)s_sim_rh_pm * 65536 / 1000) & 0xFFFCU);
+		bool     seq = ((d->cfg & 0x1000U) != 0U);
+		w[0] = (seq || d->ptr == 0x00U) ? t : rh;
+		w[1] = rh;
+	}
+	sim_put(buf, len, 2U, w);
+	return SCN_OK;
+}
+
+/* Aiguillage par adresse : aucun capteur à cette adresse -> NACK */
+static scn_err_t sim_write(uint16_t addr, const uint8_t *buf, uint8_t len)
+{
+	if (addr == SHT31_I2C_ADDR && (s_sim_present & TH_SIM_SHT31)) {
+		return sim_sht_write(&s_sim_sht[0], buf, len);
+	}
+	if (addr == SHT31_I2C_ADDR_ALT && (s_sim_present & TH_SIM_SHT31_ALT)) {
+		return sim_sht_write(&s_sim_sht[1], buf, len);
+	}
+	if (addr == HDC1080_I2C_ADDR && (s_sim_present & TH_SIM_HDC1080)) {
+		return sim_hdc_write(&s_sim_hdc, buf, len);
+	}
+	return ERR_I2C_NACK;
+}
+
+static scn_err_t sim_read(uint16_t addr, uint8_t *buf, uint8_t len)
+{
+	if (addr == SHT31_I2C_ADDR && (s_sim_present & TH_SIM_SHT31)) {
+		return sim_sht_read(&s_sim_sht[0], buf, len);
+	}
+	if (addr == SHT31_I2C_ADDR_ALT && (s_sim_present & TH_SIM_SHT31_ALT)) {
+		return sim_sht_read(&s_sim_sht[1], buf, len);
+	}
+	if (addr == HDC1080_I2C_ADDR && (s_sim_present & TH_SIM_HDC1080)) {
+		return sim_hdc_read(&s_sim_hdc, buf, len);
+	}
+	return ERR_I2C_NACK;
+}
+
+static th_sim_fault_t sim_fault_take(void)
+{
+	if (s_sim_fault_n == 0U) {
+		return TH_SIM_NONE;
+	}
+	s_sim_fault_n--;
+	return s_sim_fault;
+}
+
+static scn_err_t bus_init(void)
+{
+	s_sim_hang = false;                            /* les capteurs, eux, gardent leur état */
+	return SCN_OK;
+}
+
+static scn_err_t bus_tx(uint16_t addr, const uint8_t *buf, uint8_t len)
+{
+	th_sim_fault_t f = sim_fault_take();
+	s_sim_hang = (f == TH_SIM_HANG);
+	if (!s_sim_hang) {
+		s_sim_done = (f == TH_SIM_NACK) ? ERR_I2C_NACK : sim_write(addr, buf, len);
+	}
+	return SCN_OK;
+}
+
+static scn_err_t bus_rx(uint16_t addr, uint8_t *buf, uint8_t len)
+{
+	th_sim_fault_t f = sim_fault_take();
+	s_sim_hang = (f == TH_SIM_HANG);
+	if (!s_sim_hang) {
+		s_sim_done = (f == TH_SIM_NACK) ? ERR_I2C_NACK : sim_read(addr, buf, len);
+		if (s_sim_done == SCN_OK && f == TH_SIM_CRC) {
+			buf[1] ^= 0x01U;
+		}
+	}
+	return SCN_OK;
+}
+
+static scn_err_t bus_fetch(uint16_t addr, const uint8_t *cmd, uint8_t cmd_len, uint8_t *buf, uint8_t len)
+{
+	th_sim_fault_t f = sim_fault_take();
+	s_sim_hang = (f == TH_SIM_HANG);
+	if (!s_sim_hang) {
+		s_sim_done = (f == TH_SIM_NACK) ? ERR_I2C_NACK : sim_write(addr, cmd, cmd_len);
+		if (s_sim_done == SCN_OK) {
+			s_sim_done = sim_read(addr, buf, len);
+		}
+		if (s_sim_done == SCN_OK && f == TH_SIM_CRC) {
+			buf[1] ^= 0x01U;
+		}
+	}
+	return SCN_OK;
+}
+
+static scn_err_t bus_wait(uint32_t timeout_ms)
+{
+	if (s_sim_hang) {
+		s_sim_hang = false;
+		s_sim_now += timeout_ms;                   /* sémaphore jamais donné */
+		return ERR_I2C_TIMEOUT;
+	}
+	return s_sim_done;
+}
+
+static uint32_t now_ms(void)
+{
+	return s_sim_now;
+}
+
+static void delay_ms(uint32_t ms)
+{
+	s_sim_now += ms;
+}
+
+void SensorTh_SimPresent(uint8_t mask)
+{
+	s_sim_present = mask;
+}
+
+void SensorTh_SimSetEnv(int16_t t_cC, uint16_t rh_pm)
+{
+	s_sim_t_cC  = t_cC;
+	s_sim_rh_pm = rh_pm;
+}
+
+void SensorTh_SimFault(th_sim_fault_t fault, uint8_t n)
+{
+	s_sim_fault   = fault;
+	s_sim_fault_n = n;
+}
+
+uint32_t SensorTh_SimNowMs(void)
+{
+	return s_sim_now;
+}
+
+void SensorTh_SimAdvance(uint32_t ms)
+{
+	s_sim_now += ms;
+}
+
+#else
+
+static SemaphoreHandle_t  s_semDone = NULL;   /* donné par les callbacks I2C (IT) */
+static StaticSemaphore_t  s_semDoneBuf;
+static volatile scn_err_t s_xfer_err;         /* issue du dernier transfert        */
+
+static scn_err_t bus_init(void)
+{
+	if (s_semDone == NULL) {
+		s_semDone = xSemaphoreCreateBinaryStatic(&s_semDoneBuf);
+		configASSERT(s_semDone);
+	}
+	return SCN_OK;
+}
+
+/* Purge d'un don tardif (IT arrivée après un timeout) avant un nouveau transfert */
+static void bus_arm(void)
+{
+	(void)xSemaphoreTake(s_semDone, 0);
+	s_xfer_err = SCN_OK;
+}
+
+static scn_err_t bus_tx(uint16_t addr, const uint8_t *buf, uint8_t len)
+{
+	bus_arm();
+	return (HAL_I2C_Master_Transmit_IT(&I2C_BUS, addr, (uint8_t *)buf, len) == HAL_OK) ? SCN_OK : ERR_I2C_BUS;
+}
+
+static scn_err_t bus_rx(uint16_t addr, uint8_t *buf, uint8_t len)
+{
+	bus_arm();
+	return (HAL_I2C_Master_Receive_IT(&I2C_BUS, addr, buf, len) == HAL_OK) ? SCN_OK : ERR_I2C_BUS;
+}
+
+/* Commande 8/16 bits puis lecture en repeated start : séquence "mémoire" de la HAL */
+static scn_err_t bus_fetch(uint16_t addr, const uint8_t *cmd, uint8_t cmd_len, uint8_t *buf, uint8_t len)
+{
+	uint16_t reg  = (cmd_len == 2U) ? (uint16_t)((cmd[0] << 8) | cmd[1]) : cmd[0];
+	uint16_t size = (cmd_len == 2U) ? I2C_MEMADD_SIZE_16BIT : I2C_MEMADD_SIZE_8BIT;
+
+	bus_arm();
+	return (HAL_I2C_Mem_Read_IT(&I2C_BUS, addr, reg, size, buf, len) == HAL_OK) ? SCN_OK : ERR_I2C_BUS;
+}
+
+static scn_err_t bus_wait(uint32_t timeout_ms)
+{
+	if (xSemaphoreTake(s_semDone, pdMS_TO_TICKS(timeout_ms)) == pdTRUE) {
+		return s_xfer_err;
+	}
+	/* Fin jamais signalée (SDA/SCL bloqués, IT perdue) : périphérique réinitialisé */
+	(void)HAL_I2C_DeInit(&I2C_BUS);
+	(void)HAL_I2C_Init(&I2C_BUS);
+	return ERR_I2C_TIMEOUT;
+}
+
+static uint32_t now_ms(void)
+{
+	return (uint32_t)xTaskGetTickCount() * TICK_MS;
+}
+
+static void delay_ms(uint32_t ms)
+{
+	vTaskDelay(pdMS_TO_TICKS(ms) + 1U);            /* +1 : le tick en cours est déjà entamé */
+}
+
+/* Callbacks HAL (contexte IT I2C1_EV / I2C1_ER) */
+static void xfer_done_isr(scn_err_t err)
+{
+	BaseType_t woken = pdFALSE;
+	s_xfer_err = err;
+	xSemaphoreGiveFromISR(s_semDone, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C_BUS.Instance) {
+		xfer_done_isr(SCN_OK);
+	}
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C_BUS.Instance) {
+		xfer_done_isr(SCN_OK);
+	}
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C_BUS.Instance) {
+		xfer_done_isr(SCN_OK);
+	}
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c->Instance == I2C_BUS.Instance) {
+		xfer_done_isr(((HAL_I2C_GetError(hi2c) & HAL_I2C_ERROR_AF) != 0U) ? ERR_I2C_NACK : ERR_I2C_BUS);
+	}
+}
+
+#endif /* SIM_TARGET */
+
+/* ---------- Exécution d'une séquence d'étapes ---------- */
+static void seq_add(const th_step_t *st)
+{
+	if (st->cmd_len != 0U || st->words != 0U) {
+		s_seq[s_nseq++] = st;
+	}
+}
+
+static scn_err_t step_start(void)
+{
+	const th_step_t *st = s_seq[s_step];
+	uint8_t          rx = (uint8_t)(st->words * s_drv->word_len);
+	scn_err_t        err;
+
+	s_t_cmd = now_ms();
+	s_stats.xfers++;
+	s_stats.bytes += (st->cmd_len != 0U) ? 1U + st->cmd_len : 0U;   /* adresse + commande */
+	s_stats.bytes += (st->words != 0U) ? 1U + rx : 0U;              /* adresse + données  */
+
+	if (st->words == 0U) {
+		err     = bus_tx(s_addr, st->cmd, st->cmd_len);
+		s_state = TH_CMD;
+	} else if (st->cmd_len == 0U) {
+		err     = bus_rx(s_addr, s_rx, rx);
+		s_state = TH_READ;
+	} else {
+		err     = bus_fetch(s_addr, st->cmd, st->cmd_len, s_rx, rx);
+		s_state = TH_READ;
+	}
+	return err;
+}
+
+/* Étape suivante, ou fin de séquence */
+static scn_err_t step_next(void)
+{
+	if (++s_step == s_nsetup) {
+		s_setup_ok = true;
+	}
+	if (s_step < s_nseq) {
+		return step_start();
+	}
+	s_state = TH_IDLE;
+	return SCN_OK;
+}
+
+/* Attente après commande : la tâche est suspendue, le scheduler garde la main */
+static void conv_wait(uint32_t conv_ms)
+{
+	uint32_t el = now_ms() - s_t_cmd;
+	if (el < conv_ms) {
+		delay_ms(conv_ms - el);
+	}
+}
+
+static scn_err_t words_get(const th_step_t *st)
+{
+	for (uint8_t i = 0; i < st->words; i++) {
+		const uint8_t *w = &s_rx[i * s_drv->word_len];
+		if (s_drv->word_len == 3U && Crc8_Compute(w, 2U) != w[2]) {
+			return ERR_SENSOR_CRC;
+		}
+		s_raw[s_nraw++] = (uint16_t)((w[0] << 8) | w[1]);
+	}
+	return SCN_OK;
+}
+
+/* Déroule la séquence à partir de l'étape courante (tâche bloquée, jamais le CPU) */
+static scn_err_t seq_run(void)
+{
+	scn_err_t err = SCN_OK;
+
+	while (err == SCN_OK && s_state != TH_IDLE) {
+		const th_step_t *st = s_seq[s_step];
+
+		if (s_state == TH_CMD) {
+			err = bus_wait(SENSOR_TH_I2C_TIMEOUT_MS);
+			if (err == SCN_OK) {
+				s_state = TH_CONV;
+				conv_wait(st->conv_ms);
+				err = step_next();
+			}
+		} else {                                   /* TH_READ */
+			err = bus_wait(SENSOR_TH_I2C_TIMEOUT_MS);
+			if (err == SCN_OK) {
+				err = words_get(st);
+			}
+			if (err == SCN_OK) {
+				err = step_next();
+			}
+		}
+	}
+	s_state = TH_IDLE;
+	return err;
+}
+
+static void count_err(scn_err_t err)
+{
+	switch (err) {
+	case ERR_I2C_NACK:    s_stats.nacks++;      break;
+	case ERR_I2C_TIMEOUT: s_stats.timeouts++;   break;
+	case ERR_SENSOR_CRC:  s_stats.crc_errors++; break;
+	default:              s_stats.bus_errors++; break;
+	}
+}
+
+/* Échec de mesure : reconfiguration si le capteur a pu perdre son mode (timeout, erreur bus),
+ * nouvelle détection après NACK répétés. Un NACK isolé = mesure périodique pas encore prête ;
+ * un CRC faux = parasite sur la ligne, le capteur n'est pas en cause.
+ */
+static void fail(scn_err_t err)
+{
+	count_err(err);
+	if (err == ERR_I2C_TIMEOUT || err == ERR_I2C_BUS) {
+		s_setup_ok = false;
+	} else if (err == ERR_I2C_NACK && ++s_nack_run >= SENSOR_TH_NACK_RESETUP) {
+		s_drv      = NULL;
+		s_addr     = 0U;
+		s_nack_run = 0U;
+	}
+	s_state = TH_IDLE;
+}
+
+static scn_err_t measure_start(void)
+{
+	s_nseq   = 0U;
+	s_step   = 0U;
+	s_nraw   = 0U;
+	s_nsetup = 0U;
+	if (!s_setup_ok) {
+		for (uint8_t i = 0; i < s_drv->init_len; i++) {
+			seq_add(&s_drv->init[i]);
+		}
+		s_nsetup = s_nseq;
+		s_stats.setups++;
+	}
+	seq_add(&s_drv->trigger);
+	seq_add(&s_drv->fetch);
+	return step_start();
+}
+
+/* API */
+scn_err_t SensorTh_Init(void)
+{
+	s_drv      = NULL;
+	s_addr     = 0U;
+	s_state    = TH_IDLE;
+	s_setup_ok = false;
+	s_nack_run = 0U;
+	memset(&s_stats, 0, sizeof(s_stats));
+	return bus_init();
+}
+
+scn_err_t SensorTh_Probe(void)
+{
+	scn_err_t err = ERR_I2C_NACK;
+
+	s_stats.probes++;
+	for (uint8_t i = 0; i < sizeof(k_probe) / sizeof(k_probe[0]); i++) {
+		s_drv  = k_probe[i].drv;
+		s_addr = k_probe[i].addr;
+		s_nseq = 0U;
+		s_step = 0U;
+		s_nraw = 0U;
+		s_nsetup = 0xFFU;                          /* pas de configuration dans la détection */
+		seq_add(&s_drv->probe);
+
+		err = step_start();
+		err = (err == SCN_OK) ? seq_run() : err;
+		s_state = TH_IDLE;
+		if (err == SCN_OK && s_drv->probe.words != 0U && s_raw[0] != s_drv->probe_id) {
+			err = ERR_I2C_NACK;                    /* autre composant à cette adresse */
+		}
+		if (err == SCN_OK) {
+			s_setup_ok = false;
+			s_nack_run = 0U;
+			return SCN_OK;
+		}
+		count_err(err);
+	}
+	s_drv  = NULL;
+	s_addr = 0U;
+	return err;
+}
+
+th_model_t SensorTh_Model(void)
+{
+	return (s_drv != NULL) ? s_drv->model : TH_MODEL_NONE;
+}
+
+uint16_t SensorTh_Addr(void)
+{
+	return s_addr;
+}
+
+scn_err_t SensorTh_Trigger(void)
+{
+	if (s_state != TH_IDLE) {
+		return ERR_I2C_BUS;                        /* mesure précédente non collectée */
+	}
+	if (s_drv == NULL) {
+		scn_err_t err = SensorTh_Probe();
+		if (err != SCN_OK) {
+			return err;
+		}
+	}
+	scn_err_t err = measure_start();
+	if (err != SCN_OK) {
+		fail(err);
+	}
+	return err;
+}
+
+scn_err_t SensorTh_Collect(th_sample_t *out)
+{
+	if (s_state == TH_IDLE) {
+		return ERR_I2C_BUS;                        /* aucun Trigger en attente */
+	}
+
+	scn_err_t err = seq_run();
+	if (err != SCN_OK) {
+		fail(err);
+		return err;
+	}
+	s_nack_run = 0U;
+
+	/* Conversion sans test de modèle : constantes Q32 du driver */
+	out->t_cC  = (int16_t)(s_drv->t_off + (int32_t)(((uint64_t)s_raw[0] * s_drv->t_k + 0x80000000ULL) >> 32));
+	out->rh_pm = (uint16_t)(((uint64_t)s_raw[1] * s_drv->rh_k + 0x80000000ULL) >> 32);
+	return SCN_OK;
+}
+
+scn_err_t SensorTh_Read(th_sample_t *out)
+{
+	scn_err_t err = SensorTh_Trigger();
+	return (err == SCN_OK) ? SensorTh_Collect(out) : err;
+}
+
+th_state_t SensorTh_State(void)
+{
+	return s_state;
+}
+
+void SensorTh_GetStats(th_stats_t *st)
+{
+	*st = s_stats;
+}
+
+void SensorTh_ResetStats(void)
+{
+	memset(&s_stats, 0, sizeof(s_stats));
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    telem.c
+ * @brief   Télémétrie en virgule fixe : conversions journal et TLV CAN.
+ *          Valeurs entières de bout en bout : ni float ni mise à l'échelle
+ *          entre l'acquisition, la FRAM et le bus.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "telem.h"
+
+/* Copié par valeur dans les queues : la taille compte */
+typedef char telem_size_check[(sizeof(telem_t) == 16U) ? 1 : -1];
+
+void Telem_ToLog(const telem_t *t, log_entry_t *e)
+{
+	e->ts_ms   = t->ts_ms;
+	e->t_cC    = t->t_cC;
+	e->rh_pm   = t->rh_pm;
+	e->tmcu_cC = t->tmcu_cC;
+	e->vin_mV  = t->vin_mV;
+	e->door    = t->door;
+	e->flags   = t->flags;
+	e->crc8    = 0U;
+}
+
+size_t Telem_TlvSize(uint8_t id)
+{
+	switch (id) {
+	case TELEM_TLV_TEMP:
+	case TELEM_TLV_HUM:
+	case TELEM_TLV_TMCU:
+	case TELEM_TLV_VIN:
+		return 2U;
+	case TELEM_TLV_DOOR:
+	case TELEM_TLV_FLAGS:
+		return 1U;
+	default:
+		return 0U;
+	}
+}
+
+size_t Telem_TlvPut(const telem_t *t, uint8_t id, uint8_t *dst)
+{
+	uint16_t v;
+	switch (id) {
+	case TELEM_TLV_TEMP:  v = (uint16_t)t->t_cC;    break;
+	case TELEM_TLV_HUM:   v = t->rh_pm;             break;
+	case TELEM_TLV_TMCU:  v = (uint16_t)t->tmcu_cC; break;
+	case TELEM_TLV_VIN:   v = t->vin_mV;            break;
+	case TELEM_TLV_DOOR:  dst[0] = t->door;  return 1U;
+	case TELEM_TLV_FLAGS: dst[0] = t->flags; return 1U;
+	default:              return 0U;
+	}
+	dst[0] = (uint8_t)v;
+	dst[1] = (uint8_t)(v >> 8);
+	return 2U;
+}
+
+bool Telem_TlvGet(telem_t *t, uint8_t id, const uint8_t *src, size_t len)
+{
+	size_t n = Telem_TlvSize(id);
+	if (n == 0U || len < n) {
+		return false;
+	}
+	uint16_t v = (uint16_t)src[0];
+	if (n == 2U) {
+		v = (uint16_t)(v | ((uint16_t)src[1] << 8));
+	}
+	switch (id) {
+	case TELEM_TLV_TEMP:  t->t_cC    = (int16_t)v; break;
+	case TELEM_TLV_HUM:   t->rh_pm   = v;          break;
+	case TELEM_TLV_TMCU:  t->tmcu_cC = (int16_t)v; break;
+	case TELEM_TLV_VIN:   t->vin_mV  = v;          break;
+	case TELEM_TLV_DOOR:  t->door    = (uint8_t)v; break;
+	default:              t->flags   = (uint8_t)v; break;
+	}
+	return true;
+}
@@ -7,7 +7,14 @@
  * 	Auteur : BAQUEY Lucas (contact@syloria.fr)
  */
 
-#include "main.h"   // pour les handles générés (I2C, TIM, etc.)
+/* Build target HW or simulation */
+#ifndef SIM_TARGET
+  #define SIM_TARGET 0
+#endif
+
+#if !SIM_TARGET
+  #include "main.h"   // pour les handles générés (I2C, TIM, etc.)
+#endif
 
 /* Horloge RTOS (ms/tick) */
 #define TICK_MS                      1
@@ -19,36 +26,113 @@
 #define PERIOD_BLINK_ALARM_MS        500    // LED état alarme : 2 Hz
 #define COMMIT_MS                    10000  // flush logger -> FRAM
 
-/* Seuils temperature (°C) */
-#define TEMP_HIGH_C                  4.0f   // cible chaîne du froid d'après le site www.techni-froid.fr
-#define TEMP_LOW_C                   0.0f
-#define TEMP_HYST_C                  0.5f
-#define ALARM_DWELL_MS               5000   // T hors plage >5s => alarme
+/* Tâches (pile en mots, priorité) : piles statiques, aucun tas RTOS */
+#define TASK_DEFAULT_STACK_WORDS     128                      // defaultTask CubeMX (osThreadStaticDef)
+#define TASK_LOG_STACK_WORDS         256
+#define TASK_LOG_PRIO                (tskIDLE_PRIORITY + 1)   // commit FRAM en tâche de fond
+#define TASK_ACQ_STACK_WORDS         256
+#define TASK_ACQ_PRIO                (tskIDLE_PRIORITY + 3)   // cadence de mesure : gigue < 10 ms
+#define TASK_PROC_STACK_WORDS        256
+#define TASK_PROC_PRIO               (tskIDLE_PRIORITY + 2)   // filtrage / alarmes, après l'acquisition
+#define TASK_CAN_STACK_WORDS         256
+#define TASK_CAN_PRIO                (tskIDLE_PRIORITY + 2)   // remplit les files TX ; les mailboxes se rechargent sous IT
+
+/* Objets RTOS statiques : profondeur des queues et budget RAM total (bilan dans core_init.c) */
+#define Q_TELEM_LEN                  16     // telem_t (16 octets) : 16 s d'avance de task_acq
+#define RTOS_RAM_BUDGET              15360U // ancienne réserve heap_4 (configTOTAL_HEAP_SIZE)
+
+/* Seuils temperature (centi-°C, mêmes unités que telem_t : comparaisons entières) */
+#define TEMP_HIGH_cC                 400    // 4,00 °C : cible chaîne du froid d'après le site www.techni-froid.fr
+#define TEMP_LOW_cC                  0      // 0,00 °C
+#define TEMP_HYST_cC                 50     // 0,50 °C
+#define ALARM_DWELL_MS               5000   // T hors plage >5s => alarme (et dans la plage >5s => retombée)
+
+/* Filtrage (task_proc) : EMA alpha = 1/2^shift, constante de temps ~2^shift mesures */
+#define FILTER_EMA_SHIFT_TH          2      // T/HR : ~4 s à 1 Hz, suit une ouverture de porte
+#define FILTER_EMA_SHIFT_ADC         3      // Vin/Tmcu : déjà suréchantillonnés, variations lentes
 
 /* Reseau / IO */
 #define NODE_ID                      0x12	// identifiant du noeud sur le bus
 #define CAN_BAUD                     250000 // debit can 250kbps
+#define CAN_HANDLE                   hcan1  // handle CubeMX (bxCAN1, PD0/PD1)
 #define UART_BAUD                    115200 // debit console UART
 
+/* CAN : files d'émission logicielles par priorité (can_tx), en trames */
+#define CANTX_Q_ALARM                8      // transitions d'alarme / porte
+#define CANTX_Q_TELEM                8      // télémétrie : état complet = 4 trames
+#define CANTX_Q_BULK                 4      // export journal : avance bornée par STmin, jamais prioritaire
+
+/* CAN : télémétrie par exception (task_can). Évaluée toutes les PERIOD_CAN_MS, émise si un
+ * champ s'écarte de la dernière valeur émise de plus que sa bande morte, si l'état d'alarme
+ * ou la porte change, et en entier à chaque heartbeat. 0 : télémétrie complète à PERIOD_CAN_MS.
+ */
+#ifndef CAN_TELEM_RBE
+  #define CAN_TELEM_RBE              1
+#endif
+#define PERIOD_CAN_HB_MS             10000  // heartbeat : état complet (présence du noeud)
+#define CAN_DB_TEMP_cC               10     // 0,10 °C
+#define CAN_DB_HUM_pm                10     // 1,0 %HR
+#define CAN_DB_TMCU_cC               100    // 1,00 °C
+#define CAN_DB_VIN_mV                100    // 0,1 V
+
+/* CAN : transfert segmenté (export journal) */
+#define CANP_XFER_BS                 8      // CF par bloc avant FC (0 : une seule FC)
+#define CANP_XFER_STMIN_MS           2      // écart min entre CF : plancher émetteur et valeur de nos FC
+#define CANP_XFER_TIMEOUT_MS         1000   // attente max d'une FC (N_Bs) ou d'une CF (N_Cr)
+#define CANP_XFER_WFT_MAX            8      // FC WAIT consécutives tolérées
+
 /* ADC (Vin sur PA1 + Temp MCU) */
 #define VIN_ADC_CH                   ADC_CHANNEL_1	// PA1
-#define VIN_DIV_RTOP_OHM             100000.0f      // 100k
-#define VIN_DIV_RBOT_OHM             10000.0f		// 10k
-#define VIN_VREF_mV                  3300.0f
-#define VIN_ADC_MAX                  4095.0f
-/* Helper: Vin[V] = (adc/4095)*Vref * (Rtop+Rbot)/Rbot */
+#define VIN_DIV_RTOP_OHM             100000U        // 100k
+#define VIN_DIV_RBOT_OHM             10000U         // 10k
+/* Ratiométrique : Vin[mV] = 3300 * VREFINT_CAL / vrefint * adc/4095 * (Rtop+Rbot)/Rbot
+ * (VDDA déduite de VREFINT et de sa valeur d'usine, plus de Vref supposée à 3,3 V)
+ */
+#define ADC_HANDLE                   hadc1           // handle CubeMX
+#define ADC_TRIG_TIM                 htim3           // TRGO 10 Hz : un scan Vin/Tmcu/VREFINT
+#define ADC_OVS                      4               // conversions par voie et par scan (rangs de MX_ADC1_Init)
 
 /* Capteurs I2C */
 #define I2C_BUS                      hi2c1           // handle CubeMX
-#define SHT31_I2C_ADDR               (0x44 << 1)     // alternatif: 0x45
-#define HDC1080_I2C_ADDR             (0x40 << 1)
+#define SHT31_I2C_ADDR               (0x44 << 1)     // ADDR à la masse
+#define SHT31_I2C_ADDR_ALT           (0x45 << 1)     // ADDR à VDD
+#define HDC1080_I2C_ADDR             (0x40 << 1)     // capteur détecté au boot (SHT31 prioritaire)
+#define SENSOR_TH_I2C_TIMEOUT_MS     5               // fin d'un transfert IT (commande ou lecture)
+#define SENSOR_TH_MODE_SINGLE        0               // SHT31 : commande + conversion attendue à chaque mesure
+#define SENSOR_TH_MODE_PERIODIC      1               // SHT31 : conversion autonome ART (4 Hz), lecture par FETCH DATA
+#ifndef SENSOR_TH_MODE
+  #define SENSOR_TH_MODE             SENSOR_TH_MODE_PERIODIC   // HDC1080 : toujours lecture combinée T+HR
+#endif
+#define SENSOR_TH_NACK_RESETUP       3               // NACK consécutifs avant nouvelle détection du capteur
+
+/* FRAM SPI (MB85RS256B) */
+#define FRAM_SPI                     hspi1           // handle CubeMX
+#define FRAM_CS_GPIO_Port            GPIOB
+#define FRAM_CS_Pin                  GPIO_PIN_5
+#define FRAM_SIZE_BYTES              32768U          // 256 Kbit
+#define FRAM_STAGE_SIZE              512U            // buffer de staging DMA (x2)
+#define FRAM_DMA_TIMEOUT_MS          50U
+#define FRAM_INDEX_BASE              0x0000U         // index clairsemé du journal (en-tête)
+#define FRAM_JOURNAL_BASE            0x0400U         // zone journal (en-tête réservé avant)
+#define FRAM_SLOT_SIZE               512U            // granularité de l'index journal (62 slots)
+
+/* FRAM virtuelle (SIM_TARGET) : image + compteurs d'usure dans un fichier mappé */
+#define FRAM_SIM_FILE                "scn_fram.bin"  // surchargé par la variable d'env. SCN_FRAM_FILE
+#define FRAM_SIM_SPI_HZ              21000000U       // SPI1 : APB2 84 MHz / 4
+#define FRAM_SIM_CS_NS               1500U           // surcoût par transaction (CS + appel HAL)
+#ifndef FRAM_SIM_REALTIME
+  #define FRAM_SIM_REALTIME          0               // 1 : durée bus réellement attendue (DMA compris)
+#endif
 
 /* GPIO / PWM / IO */
 #define LED_GPIO_Port                GPIOG
 #define LED_Pin                      GPIO_PIN_13
 
 #define DOOR_GPIO_Port               GPIOA
-#define DOOR_Pin                     GPIO_PIN_0
+#define DOOR_Pin                     GPIO_PIN_0      // EXTI0, deux fronts
+#define DOOR_DEBOUNCE_MS             20U             // silence après le dernier rebond avant prise en compte
+#define DOOR_DEB_TIM                 htim7           // handle CubeMX (one-pulse)
+#define DOOR_DEB_TIM_HZ              10000U          // horloge compteur : 84 MHz / 8400
 
 #define RELAY_GPIO_Port              GPIOD
 #define RELAY_Pin                    GPIO_PIN_2
@@ -57,10 +141,7 @@
 #define BUZZER_TIM_CHANNEL           TIM_CHANNEL_1   // PD12 -> TIM4_CH1
 
 /* Journalisation */
-#define LOGGER_RING_CAPACITY         512             // entrées en RAM
+#define LOGGER_RING_CAPACITY         512             // entrées en RAM (puissance de 2)
 #define LOGGER_CRC8_POLY             0x31            // x^8+x^5+x^4+1
-
-/* Build target HW or simulation */
-#ifndef SIM_TARGET
-  #define SIM_TARGET 0
-#endif
+#define LOGGER_KEYFRAME_INTERVAL     64              // entrées entre deux keyframes (codec FRAM)
+#define LOGGER_BLOCK_CRC32           1               // CRC-32 par bloc FRAM en plus des CRC-8 de groupe
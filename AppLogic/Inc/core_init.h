@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
@@ -26,14 +29,41 @@ extern "C" {
 #define EVT_SYS_DOOR_OPEN        (1U << 2)
 #define EVT_SYS_COMMIT_REQ      (1U << 3)
 
+/* Diffusion aux abonnés par notification directe (xTaskNotify eSetBits) : valeur reçue =
+ * bits EVT_SYS_* levés depuis la dernière attente, et EVT_FELL(bits) pour ceux retombés.
+ * L'ordre d'une levée et d'une retombée cumulées se déduit de l'état courant (event group).
+ * EVT_CAN_RX : posé par l'IT RX dans la même notification de task_can (pas une transition).
+ */
+#define EVT_CAN_RX               (1UL << 30)    // trames CAN en attente (CanRx_Get)
+#define EVT_FELL(bits)           ((uint32_t)(bits) << 16)
+#define EVT_SUBS_MAX             4U
+
+/* Ligne du bilan RAM statique des objets RTOS */
+typedef struct {
+    const char *name;
+    uint32_t    bytes;      // pile + bloc de contrôle, ou stockage + bloc de contrôle
+} core_ram_t;
 
 /* API de lifecycle */
 void Core_Init(void);   /* crée queues/timers/tasks */
 void Core_Start(void);  /* arme les timers si besoin */
 
+/* Publication d'un changement d'état : event group + notification des abonnés.
+ * Signal : demande sans état (EVT_SYS_COMMIT_REQ), notification des abonnés seulement.
+ * Subscribe avant le démarrage du scheduler (depuis les TaskX_Start) ; la notification de
+ * la tâche abonnée lui est alors réservée.
+ */
+void     Core_EvtSubscribe(TaskHandle_t task, uint32_t mask);
+void     Core_EvtPublish(uint32_t bits, bool set);
+void     Core_EvtPublishFromISR(uint32_t bits, bool set, BaseType_t *woken);
+void     Core_EvtSignal(uint32_t bits);
+uint32_t Core_EvtWait(TickType_t timeout);     // côté abonné : bits reçus (0 : timeout)
+
+/* Bilan RAM (vérifié à la compilation contre RTOS_RAM_BUDGET) : nombre de lignes */
+size_t   Core_RamReport(const core_ram_t **rows, uint32_t *total);
+
 /* Getters d’objets FreeRTOS (static + getters pour tests unitaires riches)*/
 QueueHandle_t     Core_GetTelemQueue(void);		// File télémétrie brute (task_acq) -> traitement (task_proc)
-QueueHandle_t     Core_GetEventsQueue(void);	// File d'événements/flags (task_proc ) -> diffusion (task_can/cli)
 TimerHandle_t     Core_GetCommitTimer(void);	// Timer logiciel de commit périodique (logger RAM -> FRAM)
 EventGroupHandle_t Core_GetSysEvents(void);		// Groupe événements système (états/alertes)
 
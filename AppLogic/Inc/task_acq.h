@@ -0,0 +1,22 @@
+/**
+ * @file    task_acq.h
+ * @brief   Tâche d'acquisition capteurs (T/HR I2C, Vin/Tmcu ADC, porte).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TaskAcq_Start(QueueHandle_t qTelem);
+
+#ifdef __cplusplus
+}
+#endif
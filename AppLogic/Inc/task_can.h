@@ -0,0 +1,27 @@
+/**
+ * @file    task_can.h
+ * @brief   Tâche CAN : alarmes, télémétrie périodique et export du journal,
+ *          émis par les files à priorité de can_tx.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TaskCan_Start(EventGroupHandle_t evtSys);
+
+/* Export du journal sur CANP_FN_XFER_TX (classe bulk) ; false si un export est déjà en cours */
+bool TaskCan_ExportStart(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file    task_log.h
+ * @brief   Tâche de commit du journal (ring RAM -> FRAM SPI).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void TaskLog_Start(void);
+
+#ifdef __cplusplus
+}
+#endif
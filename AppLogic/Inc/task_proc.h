@@ -0,0 +1,51 @@
+/**
+ * @file    task_proc.h
+ * @brief   Tâche de traitement : filtrage des mesures (rejet des pics, lissage,
+ *          calibration par voie) puis journalisation.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "telem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Voies filtrées (champs de telem_t) */
+typedef enum {
+    PROC_CH_T = 0,      // t_cC
+    PROC_CH_RH,         // rh_pm
+    PROC_CH_TMCU,       // tmcu_cC
+    PROC_CH_VIN,        // vin_mV
+    PROC_CH_COUNT
+} proc_ch_t;
+
+void TaskProc_Start(QueueHandle_t qTelem);
+
+/* Compensation d'une voie : y = x * gain_q14 / 2^14 + offset (unités de la voie).
+ * Appelable depuis une autre tâche (CLI, commande CAN) ; effet dès la mesure suivante.
+ */
+void TaskProc_SetCal(proc_ch_t ch, int32_t offset, int32_t gain_q14);
+void TaskProc_GetCal(proc_ch_t ch, int32_t *offset, int32_t *gain_q14);
+
+/* Seuils d'alarme (centi-°C), appliqués avant la mesure ou l'échéance suivante sans réinitialiser
+ * l'état de l'alarme. Refusés (false) si hyst < 0 ou si low + 2 * hyst > high.
+ * Get : derniers seuils demandés (ceux de config.h au démarrage).
+ */
+bool TaskProc_SetThresholds(int16_t high_cC, int16_t low_cC, int16_t hyst_cC);
+void TaskProc_GetThresholds(int16_t *high_cC, int16_t *low_cC, int16_t *hyst_cC);
+
+/* Dernière mesure filtrée, flags d'alarme compris (false : aucune mesure encore traitée) */
+bool TaskProc_GetLatest(telem_t *out);
+
+#ifdef __cplusplus
+}
+#endif
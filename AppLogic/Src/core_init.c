@@ -8,65 +8,120 @@
 */
 
 #include "core_init.h"
-#include "task_blink.h"
 #include "task_acq.h"
 #include "task_proc.h"
 #include "task_can.h"
-#include "task_cli.h"
-
-typedef struct {
-    float    t_c;       // température air
-    float    rh_pct;    // humidité %
-    float    t_mcu_c;   // temp MCU
-    float    vin_v;     // tension entrée
-    uint8_t  door;      // 0/1
-    uint32_t flags;     // bits divers (ex: out-of-range, capteur HS...)
-} telem_t;
-
-typedef uint32_t event_t;  // bitmask d'événements système
+#include "task_log.h"
+#include "telem.h"
+#include "door.h"
 
 /* ---------- Objets FreeRTOS (scope fichier) ---------- */
 static QueueHandle_t      s_qTelem  = NULL;  /* task_acq -> task_proc */
-static QueueHandle_t      s_qEvents = NULL;  /* task_proc -> can/cli  */
 static TimerHandle_t      s_tCommit = NULL;  /* commit logger -> FRAM */
 static EventGroupHandle_t s_evtSys  = NULL;  /* états/alertes système */
 
+/* Stockage statique (aucun tas RTOS) */
+static uint8_t            s_qTelemBuf[Q_TELEM_LEN * sizeof(telem_t)];
+static StaticQueue_t      s_qTelemCb;
+static StaticTimer_t      s_tCommitCb;
+static StaticEventGroup_t s_evtSysCb;
+
+/* ---------- Bilan RAM des objets RTOS ----------
+ * Une ligne par objet, tailles tirées des mêmes constantes que les buffers
+ * (ici, dans les task_*.c, dans freertos.c et dans les drivers). Le total est
+ * vérifié à la compilation contre RTOS_RAM_BUDGET ; les lignes sont listées
+ * à chaque build des tests hôte (Tests/ram_report.c, via Core_RamReport).
+ */
+#define RAM_TASK(words)     ((words) * sizeof(StackType_t) + sizeof(StaticTask_t))
+#define RAM_QUEUE(n, sz)    ((n) * (sz) + sizeof(StaticQueue_t))
+
+/* Copie de DaemonTaskMessage_t (privé à timers.c, FreeRTOS 10.3.1) : union des paramètres
+ * timer et d'appel différé (INCLUDE_xTimerPendFunctionCall, requis par les event groups
+ * depuis une ISR). 16 octets sur Cortex-M ; à revoir si le noyau change de version.
+ */
+typedef struct {
+	BaseType_t id;
+	union {
+		struct { TickType_t value; void *timer; } tmr;
+		struct { PendedFunction_t fn; void *p1; uint32_t p2; } cb;
+	} u;
+} ram_tmr_msg_t;
+#define RAM_TMR_MSG         sizeof(ram_tmr_msg_t)
+
+typedef char ram_tmr_msg_check[(tskKERNEL_VERSION_MAJOR == 10 && INCLUDE_xTimerPendFunctionCall == 1) ? 1 : -1];
+
+#define RTOS_RAM_OBJECTS(X)                                                              \
+	X("task idle",     RAM_TASK(configMINIMAL_STACK_SIZE))                               \
+	X("task tmr svc",  RAM_TASK(configTIMER_TASK_STACK_DEPTH))                           \
+	X("q tmr svc",     RAM_QUEUE(configTIMER_QUEUE_LENGTH, RAM_TMR_MSG))                 \
+	X("task default",  RAM_TASK(TASK_DEFAULT_STACK_WORDS))                               \
+	X("task log",      RAM_TASK(TASK_LOG_STACK_WORDS))                                   \
+	X("task acq",      RAM_TASK(TASK_ACQ_STACK_WORDS))                                   \
+	X("task proc",     RAM_TASK(TASK_PROC_STACK_WORDS))                                  \
+	X("task can",      RAM_TASK(TASK_CAN_STACK_WORDS))                                   \
+	X("q telem",       RAM_QUEUE(Q_TELEM_LEN, sizeof(telem_t)))                          \
+	X("evt sys",       sizeof(StaticEventGroup_t))                                       \
+	X("tmr commit",    sizeof(StaticTimer_t))                                            \
+	X("mtx journal",   sizeof(StaticSemaphore_t))                                        \
+	X("sem fram dma",  sizeof(StaticSemaphore_t))                                        \
+	X("sem i2c th",    sizeof(StaticSemaphore_t))
+
+#define RAM_ROW(name, bytes)    { (name), (uint32_t)(bytes) },
+#define RAM_SUM(name, bytes)    + (bytes)
+
+static const core_ram_t k_ram[] = { RTOS_RAM_OBJECTS(RAM_ROW) };
+#define RTOS_RAM_TOTAL          (0U RTOS_RAM_OBJECTS(RAM_SUM))
+
+typedef char rtos_ram_check[(RTOS_RAM_TOTAL <= RTOS_RAM_BUDGET) ? 1 : -1];
+
+/* Abonnés aux changements d'état (figés au démarrage du scheduler) */
+typedef char evt_fell_check[(((EVT_SYS_ALARM_ACTIVE | EVT_SYS_SENSOR_FAULT | EVT_SYS_DOOR_OPEN |
+                               EVT_SYS_COMMIT_REQ) >> 16) == 0U) ? 1 : -1];
+
+static struct {
+	TaskHandle_t task;
+	uint32_t     mask;
+} s_subs[EVT_SUBS_MAX];
+static uint8_t s_nsubs = 0U;
+
 /* Callbacks
  * Wiki : déclencher périodiquement le “flush” du logger (vider le ring RAM vers la FRAM) toutes COMMIT_MS
 */
 static void commit_cb(TimerHandle_t xTimer)
 {
 	(void)xTimer;
-	/* Déclenche un “flush” asynchrone du logger via EventGroup. */
-	xEventGroupSetBits(s_evtSys, EVT_SYS_COMMIT_REQ);
+	/* Déclenche un “flush” asynchrone du logger : notification de task_log (abonnée). */
+	Core_EvtSignal(EVT_SYS_COMMIT_REQ);
 }
 
 /* API */
 void Core_Init(void)
 {
-	/* Création des queues */
-	s_qTelem  = xQueueCreate(16, sizeof(telem_t));
-	s_qEvents = xQueueCreate(16, sizeof(event_t));
-    configASSERT(s_qTelem && s_qEvents); // A modifier en Prod car on ne sait pas laquelle est Null
+	/* Création des queues (stockage statique : ne peut pas échouer, handles = &cb) */
+	s_qTelem  = xQueueCreateStatic(Q_TELEM_LEN, sizeof(telem_t), s_qTelemBuf, &s_qTelemCb);
+    configASSERT(s_qTelem);
 
     /* Event group */
-       s_evtSys = xEventGroupCreate();
-       configASSERT(s_evtSys); // A modifier en Prod
+       s_evtSys = xEventGroupCreateStatic(&s_evtSysCb);
+       configASSERT(s_evtSys);
 
        /* Timer logiciel de commit périodique */
-       s_tCommit = xTimerCreate("commit",
-                                pdMS_TO_TICKS(COMMIT_MS),
-                                pdTRUE, /* auto-reload */
-                                NULL,
-                                commit_cb);
+       s_tCommit = xTimerCreateStatic("commit",
+                                      pdMS_TO_TICKS(COMMIT_MS),
+                                      pdTRUE, /* auto-reload */
+                                      NULL,
+                                      commit_cb,
+                                      &s_tCommitCb);
        configASSERT(s_tCommit);
 
+       /* Porte : état initial publié, puis changements depuis l'ISR (objets ci-dessus requis) */
+       (void)Door_Init();
+
        /* Démarrage des tâches applicatives */
-       TaskBlink_Start();
        TaskAcq_Start(s_qTelem);
-       TaskProc_Start(s_qTelem, s_qEvents, s_evtSys);
-       TaskCan_Start(s_qEvents, s_evtSys);
-       TaskCli_Start();
+       TaskProc_Start(s_qTelem);
+       TaskCan_Start(s_evtSys);
+       TaskLog_Start();
 }
 
 void Core_Start(void)
@@ -75,8 +130,75 @@ void Core_Start(void)
    xTimerStart(s_tCommit, 0);
 }
 
+/* ---------- Evénements ---------- */
+void Core_EvtSubscribe(TaskHandle_t task, uint32_t mask)
+{
+	configASSERT(task != NULL && s_nsubs < EVT_SUBS_MAX);
+	s_subs[s_nsubs].task = task;
+	s_subs[s_nsubs].mask = mask;
+	s_nsubs++;
+}
+
+static void evt_notify(uint32_t bits, uint32_t val)
+{
+	for (uint8_t i = 0U; i < s_nsubs; i++) {
+		if ((s_subs[i].mask & bits) != 0U) {
+			(void)xTaskNotify(s_subs[i].task, val, eSetBits);
+		}
+	}
+}
+
+void Core_EvtPublish(uint32_t bits, bool set)
+{
+	if (set) {
+		(void)xEventGroupSetBits(s_evtSys, bits);
+	} else {
+		(void)xEventGroupClearBits(s_evtSys, bits);
+	}
+	evt_notify(bits, set ? bits : EVT_FELL(bits));
+}
+
+void Core_EvtPublishFromISR(uint32_t bits, bool set, BaseType_t *woken)
+{
+	uint32_t val = set ? bits : EVT_FELL(bits);
+
+	/* Appliqué par le daemon timer : configTIMER_TASK_PRIORITY au-dessus des abonnés,
+	 * l'event group est à jour quand ils lisent leur notification.
+	 */
+	if (set) {
+		(void)xEventGroupSetBitsFromISR(s_evtSys, bits, woken);
+	} else {
+		(void)xEventGroupClearBitsFromISR(s_evtSys, bits);
+	}
+	for (uint8_t i = 0U; i < s_nsubs; i++) {
+		if ((s_subs[i].mask & bits) != 0U) {
+			(void)xTaskNotifyFromISR(s_subs[i].task, val, eSetBits, woken);
+		}
+	}
+}
+
+void Core_EvtSignal(uint32_t bits)
+{
+	evt_notify(bits, bits);
+}
+
+uint32_t Core_EvtWait(TickType_t timeout)
+{
+	uint32_t val = 0U;
+
+	(void)xTaskNotifyWait(0U, UINT32_MAX, &val, timeout);
+	return val;
+}
+
+/* ---------- Bilan RAM ---------- */
+size_t Core_RamReport(const core_ram_t **rows, uint32_t *total)
+{
+	*rows  = k_ram;
+	*total = RTOS_RAM_TOTAL;
+	return sizeof(k_ram) / sizeof(k_ram[0]);
+}
+
 /* ---------- Getters ---------- */
 QueueHandle_t Core_GetTelemQueue(void)      { return s_qTelem;  }
-QueueHandle_t Core_GetEventsQueue(void)     { return s_qEvents; }
 TimerHandle_t Core_GetCommitTimer(void)     { return s_tCommit; }
 EventGroupHandle_t Core_GetSysEvents(void)  { return s_evtSys;  }
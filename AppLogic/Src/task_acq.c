@@ -0,0 +1,77 @@
+/**
+ * @file    task_acq.c
+ * @brief   Tâche d'acquisition : un telem_t toutes les PERIOD_ACQ_MS vers s_qTelem.
+ *          Cadence par vTaskDelayUntil (pas de dérive) ; la mesure T/HR est
+ *          déclenchée en début de cycle et collectée après la lecture ADC/porte,
+ *          la tâche dormant pendant la conversion du capteur.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "task_acq.h"
+#include "core_init.h"
+#include "telem.h"
+#include "sensor_th.h"
+#include "adc_utils.h"
+#include "door.h"
+
+static QueueHandle_t      s_qTelem = NULL;
+static StackType_t        s_stack[TASK_ACQ_STACK_WORDS];
+static StaticTask_t       s_tcb;
+
+static void task_acq(void *arg)
+{
+	(void)arg;
+
+	/* Détection du capteur T/HR (bus utilisable seulement une fois le scheduler lancé) */
+	(void)SensorTh_Probe();
+	TickType_t wake = xTaskGetTickCount();
+
+	for (;;) {
+		telem_t     t = { 0 };
+		th_sample_t th;
+		adc_raw_t   raw;
+
+		t.ts_ms = (uint32_t)wake * TICK_MS;
+
+		/* Conversion capteur lancée d'abord : elle recouvre le reste du cycle */
+		scn_err_t err = SensorTh_Trigger();
+
+		AdcUtils_GetRaw(&raw);
+		if (raw.scans == 0U) {
+			t.flags |= TELEM_F_ADC_FAULT;
+		} else {
+			t.vin_mV  = AdcUtils_VinmV(&raw);
+			t.tmcu_cC = AdcUtils_TmcucC(&raw);
+		}
+		/* État anti-rebondi tenu par l'IT porte : pas de lecture GPIO dans le cycle */
+		t.door = Door_IsOpen() ? 1U : 0U;
+
+		if (err == SCN_OK) {
+			err = SensorTh_Collect(&th);
+		}
+		if (err == SCN_OK) {
+			t.t_cC  = th.t_cC;
+			t.rh_pm = th.rh_pm;
+		} else {
+			t.flags |= TELEM_F_TH_FAULT;
+		}
+
+		(void)xQueueSend(s_qTelem, &t, 0);         /* file pleine : mesure perdue, pas de retard */
+		vTaskDelayUntil(&wake, pdMS_TO_TICKS(PERIOD_ACQ_MS));
+	}
+}
+
+/* API */
+void TaskAcq_Start(QueueHandle_t qTelem)
+{
+	s_qTelem = qTelem;
+
+	(void)SensorTh_Init();
+	(void)AdcUtils_Start();
+
+	TaskHandle_t h = xTaskCreateStatic(task_acq, "acq", TASK_ACQ_STACK_WORDS, NULL, TASK_ACQ_PRIO,
+	                                   s_stack, &s_tcb);
+	configASSERT(h != NULL);
+}
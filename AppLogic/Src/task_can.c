@@ -0,0 +1,234 @@
+/**
+ * @file    task_can.c
+ * @brief   Tâche CAN : produit les trames, can_tx les émet.
+ *          - transitions notifiées (alarme, défaut capteur, porte) -> classe
+ *            alarme, une trame par transition ;
+ *          - état (mesure filtrée + seuils) évalué toutes les PERIOD_CAN_MS ->
+ *            classe télémétrie : par exception (écart > bande morte CAN_DB_*,
+ *            transition d'alarme / porte) avec heartbeat complet toutes les
+ *            PERIOD_CAN_HB_MS, ou complet à chaque période (CAN_TELEM_RBE = 0) ;
+ *            TLV packés au plus serré ;
+ *          - export du journal (segments ISO-TP) -> classe bulk, cadencé par
+ *            STmin et par la place libre dans sa file.
+ *          Réception (can_rx) : seuls les ID de la table de can_proto passent
+ *          les filtres ; commandes (FIFO urgente), seuils (TLV 0x10..0x12) et
+ *          FC de l'export.
+ *          La tâche dort sur sa notification (transitions par Core_EvtPublish,
+ *          EVT_CAN_RX posé par l'IT RX) jusqu'à la prochaine échéance ; elle ne
+ *          touche jamais aux mailboxes (rechargées sous IT par can_tx).
+ *
+ *          Trame alarme (CANP_FN_ALARM) : [0] bits EVT_SYS_* changés,
+ *          [1] leur nouvel état, [2] état courant (event group), puis
+ *          TLV TEMP + FLAGS de la dernière mesure (8 octets au total).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "task_can.h"
+#include "task_proc.h"
+#include "core_init.h"
+#include "can_tx.h"
+#include "can_rx.h"
+#include "can_proto.h"
+#include "telem.h"
+#include <string.h>
+
+#define CAN_EVT_MASK    (EVT_SYS_ALARM_ACTIVE | EVT_SYS_SENSOR_FAULT | EVT_SYS_DOOR_OPEN)
+
+/* Etat complet (4 trames) dans la file télémétrie */
+typedef char task_can_q_check[(CANTX_Q_TELEM >= 4) ? 1 : -1];
+/* Transitions publiées depuis une ISR : event group appliqué (daemon) avant que la tâche ne lise */
+typedef char task_can_evt_check[(configTIMER_TASK_PRIORITY > TASK_CAN_PRIO) ? 1 : -1];
+
+static EventGroupHandle_t s_evtSys  = NULL;
+static StackType_t        s_stack[TASK_CAN_STACK_WORDS];
+static StaticTask_t       s_tcb;
+
+static canp_export_t      s_export;
+static canp_report_t      s_rep;            /* valeurs TLV déjà transmises à la gateway, heartbeat */
+static volatile bool      s_export_req;
+
+/* Echéance atteinte (compteur ms libre, débordement toléré) */
+static inline bool due(uint32_t now, uint32_t t)
+{
+	return (int32_t)(now - t) >= 0;
+}
+
+static inline uint32_t now_ms(void)
+{
+	return (uint32_t)xTaskGetTickCount() * TICK_MS;
+}
+
+static void frame_init(can_frame_t *f, uint8_t fn)
+{
+	f->id  = CANP_ID(fn, NODE_ID);
+	f->dlc = 0U;
+	memset(f->data, 0, sizeof(f->data));
+}
+
+/* Etat publié : dernière mesure filtrée et seuils d'alarme (false : aucune mesure encore) */
+static bool can_state(canp_state_t *st)
+{
+	TaskProc_GetThresholds(&st->thigh_cC, &st->tlow_cC, &st->hyst_cC);
+	return TaskProc_GetLatest(&st->t);
+}
+
+/* ---------- Producteurs ---------- */
+static void can_send_event(uint8_t bits, uint8_t state)
+{
+	can_frame_t  f;
+	canp_state_t st;
+
+	frame_init(&f, CANP_FN_ALARM);
+	f.data[0] = bits;
+	f.data[1] = (uint8_t)(state & bits);
+	f.data[2] = state;
+	f.dlc     = 3U;
+	if (can_state(&st)) {
+		(void)CanProto_TlvAppend(&f, &st, TELEM_TLV_TEMP);
+		(void)CanProto_TlvAppend(&f, &st, TELEM_TLV_FLAGS);
+	}
+	(void)CanTx_Send(CANTX_PRIO_ALARM, &f);         /* file pleine : comptée dans CanTx_GetStats */
+	CanProto_ReportSync(&s_rep);                    /* télémétrie exacte au prochain cycle */
+}
+
+/* Transitions cumulées depuis la dernière attente. Un bit levé et retombé (ou l'inverse) compte
+ * deux transitions : la première est celle qui ne mène pas à l'état courant. L'ordre entre bits
+ * différents notifiés ensemble n'est pas conservé (trame [2] : état courant complet).
+ */
+static void can_on_events(uint32_t val)
+{
+	uint8_t up   = (uint8_t)(val & CAN_EVT_MASK);
+	uint8_t down = (uint8_t)((val >> 16) & CAN_EVT_MASK);
+	uint8_t both = (uint8_t)(up & down);
+	uint8_t cur  = (uint8_t)(xEventGroupGetBits(s_evtSys) & CAN_EVT_MASK);
+
+	if ((both & (uint8_t)~cur) != 0U) {
+		can_send_event((uint8_t)(both & ~cur), (uint8_t)(cur | both));      /* levés puis retombés */
+	}
+	if ((both & cur) != 0U) {
+		can_send_event((uint8_t)(both & cur), (uint8_t)(cur & ~both));      /* retombés puis relevés */
+	}
+	if ((up | down) != 0U) {
+		can_send_event((uint8_t)(up | down), cur);
+	}
+}
+
+/* Champs à émettre selon la politique de s_rep, TLV packés directement dans les trames */
+static void can_send_telem(uint32_t now)
+{
+	can_frame_t  f[CANP_TLV_COUNT];
+	canp_state_t st;
+
+	if (!can_state(&st)) {
+		return;
+	}
+	size_t n = CanProto_ReportPoll(&s_rep, &st, now, CANP_ID(CANP_FN_TELEM, NODE_ID), f, CANP_TLV_COUNT);
+	for (size_t i = 0U; i < n; i++) {
+		if (CanTx_Send(CANTX_PRIO_TELEM, &f[i]) != SCN_OK) {
+			CanProto_TlvForget(&s_rep.tlv);             /* trame perdue : tout l'état au cycle suivant */
+		}
+	}
+}
+
+static void can_export_poll(uint32_t now)
+{
+	can_frame_t f;
+
+	if (s_export_req) {
+		s_export_req = false;
+		CanProto_ExportBegin(&s_export, now);
+	}
+	/* Une trame produite n'est jamais perdue : on ne la demande que si la file bulk a de la place */
+	while (s_export.active && CanTx_Free(CANTX_PRIO_BULK) > 0U && CanProto_ExportPoll(&s_export, now, &f)) {
+		(void)CanTx_Send(CANTX_PRIO_BULK, &f);
+	}
+}
+
+/* ---------- Réception ---------- */
+static void can_on_rx(const can_frame_t *f, uint32_t now)
+{
+	switch (f->id >> 7) {
+	case CANP_FN_CMD:
+		if (f->dlc >= 1U && f->data[0] == CANP_CMD_EXPORT) {
+			(void)TaskCan_ExportStart();
+		} else if (f->dlc >= 1U && f->data[0] == CANP_CMD_SNAPSHOT) {
+			CanProto_TlvForget(&s_rep.tlv);
+		}
+		break;
+	case CANP_FN_CFG: {
+		canp_state_t st;
+		uint32_t     seen;
+		TaskProc_GetThresholds(&st.thigh_cC, &st.tlow_cC, &st.hyst_cC);
+		/* Seuils absents de la trame : valeurs courantes ; trame mal formée ignorée */
+		if (CanProto_UnpackTlv(f, &st, &seen) && (seen & CANP_TLV_THRESH) != 0U) {
+			(void)TaskProc_SetThresholds(st.thigh_cC, st.tlow_cC, st.hyst_cC);
+		}
+		break;
+	}
+	case CANP_FN_XFER_RX:
+		CanProto_ExportOnFc(&s_export, f, now);
+		break;
+	default:
+		break;                                          /* ID de la table sans traitement */
+	}
+}
+
+/* ---------- Tâche ---------- */
+static void task_can(void *arg)
+{
+	(void)arg;
+	uint32_t t_telem = now_ms();
+
+	CanProto_ReportInit(&s_rep, CAN_TELEM_RBE ? CANP_REPORT_EXCEPTION : CANP_REPORT_PERIODIC, NODE_ID, t_telem);
+
+	for (;;) {
+		uint32_t now  = now_ms();
+		uint32_t wait = due(now, t_telem) ? 0U : t_telem - now;
+
+		if (s_export.active && wait > CANP_XFER_STMIN_MS) {
+			wait = CANP_XFER_STMIN_MS;                  /* cadence des CF */
+		}
+
+		can_on_events(Core_EvtWait((TickType_t)((wait + TICK_MS - 1U) / TICK_MS)));
+
+		now = now_ms();
+		can_frame_t rx;
+		while (CanRx_Get(&rx)) {
+			can_on_rx(&rx, now);
+		}
+		if (due(now, t_telem)) {
+			t_telem += PERIOD_CAN_MS;
+			if (due(now, t_telem)) {
+				t_telem = now + PERIOD_CAN_MS;          /* retard > une période : pas de rafale de rattrapage */
+			}
+			can_send_telem(now);
+		}
+		can_export_poll(now);
+	}
+}
+
+/* API */
+void TaskCan_Start(EventGroupHandle_t evtSys)
+{
+	s_evtSys = evtSys;
+
+	TaskHandle_t h = xTaskCreateStatic(task_can, "can", TASK_CAN_STACK_WORDS, NULL, TASK_CAN_PRIO,
+	                                   s_stack, &s_tcb);
+	configASSERT(h != NULL);
+	Core_EvtSubscribe(h, CAN_EVT_MASK);
+
+	CanRx_SetWake(h, EVT_CAN_RX);
+	(void)CanRx_Init();              /* filtres avant HAL_CAN_Start (CanTx_Init) */
+	(void)CanTx_Init();              /* refus : aucune trame ne part, pertes visibles dans les stats */
+}
+
+bool TaskCan_ExportStart(void)
+{
+	if (s_export.active || s_export_req) {
+		return false;
+	}
+	s_export_req = true;             /* pris en compte au prochain réveil (<= PERIOD_CAN_MS) */
+	return true;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file    task_log.c
+ * @brief   Tâche de commit du journal : abonnée à EVT_SYS_COMMIT_REQ (signal du
+ *          timer commit_cb), vide alors le ring RAM vers la FRAM par rafales DMA.
+ *          Seul consommateur du ring du logger.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "task_log.h"
+#include "core_init.h"
+#include "logger.h"
+#include "fram_spi.h"
+#include "crc_utils.h"
+
+static StackType_t        s_stack[TASK_LOG_STACK_WORDS];
+static StaticTask_t       s_tcb;
+
+static void task_log(void *arg)
+{
+	(void)arg;
+
+	for (;;) {
+		/* Bloquée jusqu'à la prochaine demande de commit (notification vidée en sortie) */
+		if ((Core_EvtWait(portMAX_DELAY) & EVT_SYS_COMMIT_REQ) != 0U) {
+			(void)Logger_Commit();
+		}
+	}
+}
+
+/* API */
+void TaskLog_Start(void)
+{
+	configASSERT(Crc8_SelfTest());   /* variante CRC8_IMPL cohérente avec la référence */
+	configASSERT(Crc32_SelfTest());  /* unité CRC (ou fallback) conforme à la valeur ST */
+	(void)Fram_Init();
+	Logger_Init();                   /* relit l'index FRAM : tête du journal */
+
+	TaskHandle_t h = xTaskCreateStatic(task_log, "log", TASK_LOG_STACK_WORDS, NULL, TASK_LOG_PRIO,
+	                                   s_stack, &s_tcb);
+	configASSERT(h != NULL);
+	Core_EvtSubscribe(h, EVT_SYS_COMMIT_REQ);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file    task_proc.c
+ * @brief   Tâche de traitement : bloquée sur s_qTelem, chaque telem_t passe
+ *          par une voie de filtrage (médiane 5 -> EMA -> calibration) par
+ *          grandeur, alimente l'alarme température, puis est journalisée.
+ *          Une voie en défaut n'alimente pas son filtre et repart à neuf à
+ *          la mesure valide suivante.
+ *          L'attente sur la queue est bornée par l'échéance de l'alarme
+ *          (dwell) : aucun réveil périodique, la tâche ne tourne que sur
+ *          une mesure ou une échéance.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "task_proc.h"
+#include "core_init.h"
+#include "telem.h"
+#include "filter.h"
+#include "alarm.h"
+#include "logger.h"
+
+static QueueHandle_t      s_qTelem  = NULL;
+static StackType_t        s_stack[TASK_PROC_STACK_WORDS];
+static StaticTask_t       s_tcb;
+
+static filter_chan_t      s_chan[PROC_CH_COUNT];   /* propres à la tâche */
+static filter_cal_t       s_cal[PROC_CH_COUNT];    /* calibration demandée (CAN, CLI), copiée par la tâche */
+static alarm_t            s_alarm;
+static telem_t            s_last;           /* dernière mesure filtrée (task_can) */
+static bool               s_have_last;
+static alarm_cfg_t        s_cfg_new;        /* seuils demandés (CAN, CLI), appliqués par la tâche */
+static bool               s_cfg_pending;
+
+static inline int16_t sat_i16(int32_t v)
+{
+	return (int16_t)((v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : v));
+}
+
+static inline uint16_t sat_u16(int32_t v)
+{
+	return (uint16_t)((v > (int32_t)UINT16_MAX) ? (int32_t)UINT16_MAX : ((v < 0) ? 0 : v));
+}
+
+static void proc_filter(telem_t *t)
+{
+	if ((t->flags & TELEM_F_TH_FAULT) != 0U) {
+		Filter_ChanReset(&s_chan[PROC_CH_T]);
+		Filter_ChanReset(&s_chan[PROC_CH_RH]);
+	} else {
+		t->t_cC  = sat_i16(Filter_Chan(&s_chan[PROC_CH_T], t->t_cC));
+		t->rh_pm = sat_u16(Filter_Chan(&s_chan[PROC_CH_RH], t->rh_pm));
+	}
+
+	if ((t->flags & TELEM_F_ADC_FAULT) != 0U) {
+		Filter_ChanReset(&s_chan[PROC_CH_TMCU]);
+		Filter_ChanReset(&s_chan[PROC_CH_VIN]);
+	} else {
+		t->tmcu_cC = sat_i16(Filter_Chan(&s_chan[PROC_CH_TMCU], t->tmcu_cC));
+		t->vin_mV  = sat_u16(Filter_Chan(&s_chan[PROC_CH_VIN], t->vin_mV));
+	}
+}
+
+/* Diffusion d'un changement d'état d'alarme (event group, abonnés) */
+static void proc_alarm_ev(alarm_ev_t ev)
+{
+	if (ev != ALARM_EV_NONE) {
+		Core_EvtPublish(EVT_SYS_ALARM_ACTIVE, ev == ALARM_EV_RAISE);
+	}
+}
+
+/* Attente sur la queue : jusqu'à l'échéance d'alarme arrondie au tick supérieur, sinon illimitée */
+static TickType_t proc_wait(uint32_t now_ms)
+{
+	uint32_t wait_ms;
+
+	if (!Alarm_Deadline(&s_alarm, now_ms, &wait_ms)) {
+		return portMAX_DELAY;
+	}
+	return (TickType_t)((wait_ms + TICK_MS - 1U) / TICK_MS);
+}
+
+static void task_proc(void *arg)
+{
+	(void)arg;
+
+	for (;;) {
+		telem_t     t;
+		log_entry_t e;
+
+		BaseType_t got = xQueueReceive(s_qTelem, &t, proc_wait((uint32_t)xTaskGetTickCount() * TICK_MS));
+		uint32_t   now = (uint32_t)xTaskGetTickCount() * TICK_MS;
+
+		taskENTER_CRITICAL();          /* seuils changés entre deux pas de l'alarme, jamais pendant */
+		if (s_cfg_pending) {
+			s_alarm.cfg   = s_cfg_new;
+			s_cfg_pending = false;
+		}
+		taskEXIT_CRITICAL();
+
+		proc_alarm_ev(Alarm_Poll(&s_alarm, now));
+		if (got != pdPASS) {
+			continue;                  /* échéance seule */
+		}
+
+		taskENTER_CRITICAL();          /* calibration modifiable depuis une autre tâche : copie seule */
+		for (uint8_t ch = 0U; ch < PROC_CH_COUNT; ch++) {
+			s_chan[ch].cal = s_cal[ch];
+		}
+		taskEXIT_CRITICAL();
+		proc_filter(&t);
+
+		if ((t.flags & TELEM_F_TH_FAULT) == 0U) {
+			proc_alarm_ev(Alarm_Sample(&s_alarm, t.t_cC, now));
+			if (t.t_cC > s_alarm.cfg.high_cC) {
+				t.flags |= TELEM_F_T_HIGH;
+			} else if (t.t_cC < s_alarm.cfg.low_cC) {
+				t.flags |= TELEM_F_T_LOW;
+			}
+		}
+
+		taskENTER_CRITICAL();
+		s_last      = t;
+		s_have_last = true;
+		taskEXIT_CRITICAL();
+
+		Telem_ToLog(&t, &e);
+		(void)Logger_Append(&e);       /* ring plein : compté par Logger_Dropped() */
+	}
+}
+
+/* API */
+void TaskProc_Start(QueueHandle_t qTelem)
+{
+	s_qTelem  = qTelem;
+
+	Filter_ChanInit(&s_chan[PROC_CH_T],    FILTER_EMA_SHIFT_TH);
+	Filter_ChanInit(&s_chan[PROC_CH_RH],   FILTER_EMA_SHIFT_TH);
+	Filter_ChanInit(&s_chan[PROC_CH_TMCU], FILTER_EMA_SHIFT_ADC);
+	Filter_ChanInit(&s_chan[PROC_CH_VIN],  FILTER_EMA_SHIFT_ADC);
+	for (uint8_t ch = 0U; ch < PROC_CH_COUNT; ch++) {
+		s_cal[ch] = s_chan[ch].cal;
+	}
+	Alarm_Init(&s_alarm, NULL);
+	s_cfg_new = s_alarm.cfg;
+
+	TaskHandle_t h = xTaskCreateStatic(task_proc, "proc", TASK_PROC_STACK_WORDS, NULL, TASK_PROC_PRIO,
+	                                   s_stack, &s_tcb);
+	configASSERT(h != NULL);
+}
+
+void TaskProc_SetCal(proc_ch_t ch, int32_t offset, int32_t gain_q14)
+{
+	if ((unsigned)ch >= PROC_CH_COUNT) {
+		return;
+	}
+	taskENTER_CRITICAL();
+	s_cal[ch].offset   = offset;
+	s_cal[ch].gain_q14 = gain_q14;
+	taskEXIT_CRITICAL();
+}
+
+void TaskProc_GetCal(proc_ch_t ch, int32_t *offset, int32_t *gain_q14)
+{
+	if ((unsigned)ch >= PROC_CH_COUNT) {
+		return;
+	}
+	taskENTER_CRITICAL();
+	*offset   = s_cal[ch].offset;
+	*gain_q14 = s_cal[ch].gain_q14;
+	taskEXIT_CRITICAL();
+}
+
+bool TaskProc_GetLatest(telem_t *out)
+{
+	taskENTER_CRITICAL();
+	bool ok = s_have_last;
+	*out    = s_last;
+	taskEXIT_CRITICAL();
+	return ok;
+}
+
+bool TaskProc_SetThresholds(int16_t high_cC, int16_t low_cC, int16_t hyst_cC)
+{
+	/* Plage de retour (low + hyst .. high - hyst) non vide */
+	if (hyst_cC < 0 || (int32_t)low_cC + 2 * (int32_t)hyst_cC > (int32_t)high_cC) {
+		return false;
+	}
+	taskENTER_CRITICAL();
+	s_cfg_new.high_cC = high_cC;
+	s_cfg_new.low_cC  = low_cC;
+	s_cfg_new.hyst_cC = hyst_cC;
+	s_cfg_pending     = true;
+	taskEXIT_CRITICAL();
+	return true;
+}
+
+void TaskProc_GetThresholds(int16_t *high_cC, int16_t *low_cC, int16_t *hyst_cC)
+{
+	taskENTER_CRITICAL();
+	*high_cC = s_cfg_new.high_cC;
+	*low_cC  = s_cfg_new.low_cC;
+	*hyst_cC = s_cfg_new.hyst_cC;
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,133 @@
+/**
+ * @file    bench_can_tlv.c
+ * @brief   Trames CAN par jeu d'état : rangement serré de PackTlv contre un
+ *          remplissage dans l'ordre des id, puis trace de chambre froide à
+ *          10 Hz en télémétrie périodique et par exception (trames par cycle) ;
+ *          coût d'un PackTlv complet.
+ *          Usage : bench_can_tlv [heures de trace]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_proto.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAMES_MAX     CANP_TLV_COUNT
+#define PACK_ROUNDS    1000000U
+
+static const uint8_t k_ids[CANP_TLV_COUNT] = {
+	TELEM_TLV_TEMP, TELEM_TLV_HUM, TELEM_TLV_TMCU, TELEM_TLV_VIN, TELEM_TLV_DOOR, TELEM_TLV_FLAGS,
+	CANP_TLV_THIGH, CANP_TLV_TLOW, CANP_TLV_HYST,
+};
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Référence : TLV dans l'ordre des id, trame suivante dès que le suivant ne tient plus */
+static size_t pack_in_order(const canp_state_t *s, uint32_t mask, can_frame_t *f)
+{
+	size_t nf = 0U;
+
+	for (size_t i = 0U; i < CANP_TLV_COUNT; i++) {
+		if ((mask & CANP_TLV_BIT(k_ids[i])) == 0U) {
+			continue;
+		}
+		if (nf == 0U || !CanProto_TlvAppend(&f[nf - 1U], s, k_ids[i])) {
+			memset(&f[nf], 0, sizeof(f[nf]));
+			(void)CanProto_TlvAppend(&f[nf++], s, k_ids[i]);
+		}
+	}
+	return nf;
+}
+
+/* Chambre froide : consigne 2 °C, dégivrage toutes les 6 h, porte 30 s toutes les 10 min */
+static void trace_step(canp_state_t *s, uint32_t ms, uint32_t *seed)
+{
+	uint32_t min  = ms / 60000U;
+	int32_t  t    = 200 + (((ms / 1000U) % 21600U < 1200U) ? 600 : 0);
+	bool     door = (ms % 600000U) < 30000U;
+
+	t += door ? 250 : 0;
+	s->t.t_cC    = (int16_t)(t + (int32_t)(test_rnd(seed) % 7U) - 3);
+	s->t.rh_pm   = (uint16_t)(850U + min % 20U + test_rnd(seed) % 5U);
+	s->t.tmcu_cC = (int16_t)(2800 + (int32_t)(test_rnd(seed) % 41U) - 20);
+	s->t.vin_mV  = (uint16_t)(24000U + test_rnd(seed) % 61U - 30U);
+	s->t.door    = door ? 1U : 0U;
+	s->t.flags   = (s->t.t_cC > TEMP_HIGH_cC) ? TELEM_F_T_HIGH : 0U;
+}
+
+static double run_report(canp_report_mode_t mode, uint32_t hours)
+{
+	canp_report_t r;
+	canp_state_t  s;
+	can_frame_t   f[FRAMES_MAX];
+	uint32_t      seed   = 24U;
+	uint64_t      frames = 0U, cycles = 0U;
+
+	memset(&s, 0, sizeof(s));
+	s.thigh_cC = TEMP_HIGH_cC;
+	s.tlow_cC  = TEMP_LOW_cC;
+	s.hyst_cC  = TEMP_HYST_cC;
+	CanProto_ReportInit(&r, mode, NODE_ID, 0U);
+	for (uint32_t ms = 0U; ms < hours * 3600000U; ms += PERIOD_CAN_MS) {
+		bool door = s.t.door != 0U;
+		trace_step(&s, ms, &seed);
+		if ((s.t.door != 0U) != door) {
+			CanProto_ReportSync(&r);
+		}
+		frames += CanProto_ReportPoll(&r, &s, ms, CANP_ID(CANP_FN_TELEM, NODE_ID), f, FRAMES_MAX);
+		cycles++;
+	}
+	return (double)frames / (double)cycles;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t         hours = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 6U;
+	uint32_t         seed  = 23U;
+	canp_state_t     s;
+	canp_tlv_cache_t c;
+	can_frame_t      f[FRAMES_MAX];
+	volatile size_t  sink = 0U;
+
+	memset(&s, 0, sizeof(s));
+	memset(&c, 0, sizeof(c));
+	trace_step(&s, 0U, &seed);
+	s.thigh_cC = TEMP_HIGH_cC;
+
+	/* Jeu complet et télémétrie seule */
+	size_t all_p  = CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_ALL, 0U, f, FRAMES_MAX);
+	size_t all_o  = pack_in_order(&s, CANP_TLV_ALL, f);
+	size_t tel_p  = CanProto_PackTlv(&s, &c, CANP_TLV_TELEM, CANP_PACK_ALL, 0U, f, FRAMES_MAX);
+	size_t tel_o  = pack_in_order(&s, CANP_TLV_TELEM, f);
+
+	uint64_t t0 = now_ns();
+	for (uint32_t i = 0U; i < PACK_ROUNDS; i++) {
+		s.t.t_cC = (int16_t)i;
+		sink += CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_ALL, 0U, f, FRAMES_MAX);
+	}
+	uint64_t ns = (now_ns() - t0) / PACK_ROUNDS;
+
+	double per = run_report(CANP_REPORT_PERIODIC, hours);
+	double exc = run_report(CANP_REPORT_EXCEPTION, hours);
+
+	printf("trames par jeu : complet %u (dans l'ordre des id %u), télémétrie %u (%u) ; PackTlv complet %u ns\n",
+	       (unsigned)all_p, (unsigned)all_o, (unsigned)tel_p, (unsigned)tel_o, (unsigned)ns);
+	printf("trace %u h à %u ms : %.2f trames / cycle en périodique, %.3f par exception\n",
+	       hours, PERIOD_CAN_MS, per, exc);
+	CHECK_EQ(all_p, 4);
+	CHECK_EQ(tel_p, 2);
+	CHECK(all_p <= all_o && tel_p < tel_o);
+	CHECK(sink > 0U);
+	CHECK(per >= (double)tel_p);
+	CHECK(exc < per / 4.0);
+	TEST_END();
+}
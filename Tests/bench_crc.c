@@ -0,0 +1,74 @@
+/**
+ * @file    bench_crc.c
+ * @brief   Débit des variantes CRC-8 (bit à bit, table, slice-by-4) et du
+ *          CRC-32 logiciel sur des blocs de la taille d'un slot FRAM.
+ *          Sur hôte, l'ordre de grandeur entre variantes seul est significatif.
+ *          Usage : bench_crc [Mo traités par variante]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "crc_utils.h"
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_BLOCK    FRAM_SLOT_SIZE
+
+typedef uint8_t (*crc8_fn_t)(uint8_t crc, const uint8_t *data, size_t len);
+
+static uint8_t s_buf[BENCH_BLOCK];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Mo/s ; le CRC final est rendu pour que la boucle ne soit pas éliminée */
+static uint32_t run8(crc8_fn_t fn, uint32_t blocks, volatile uint8_t *sink)
+{
+	uint8_t  crc = CRC8_INIT;
+	uint64_t t0  = now_ns();
+	for (uint32_t i = 0U; i < blocks; i++) {
+		crc = fn(crc, s_buf, sizeof(s_buf));
+	}
+	uint64_t dt = now_ns() - t0;
+	*sink = crc;
+	return (uint32_t)(((uint64_t)blocks * sizeof(s_buf) * 1000ULL) / ((dt > 0U) ? dt : 1U));
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t         mb     = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 16U;
+	uint32_t         blocks = (uint32_t)(((uint64_t)mb << 20) / sizeof(s_buf));
+	uint32_t         seed   = 1U;
+	volatile uint8_t s8;
+	volatile uint32_t s32;
+
+	for (size_t i = 0U; i < sizeof(s_buf); i++) {
+		s_buf[i] = (uint8_t)test_rnd(&seed);
+	}
+
+	uint32_t bit   = run8(Crc8_UpdateBitwise, blocks / 8U + 1U, &s8);
+	uint32_t tab   = run8(Crc8_UpdateTable, blocks, &s8);
+	uint32_t slice = run8(Crc8_UpdateSlice4, blocks, &s8);
+
+	uint64_t t0 = now_ns();
+	uint32_t c  = 0U;
+	for (uint32_t i = 0U; i < blocks; i++) {
+		c ^= Crc32_Compute(s_buf, sizeof(s_buf));
+	}
+	uint64_t dt = now_ns() - t0;
+	s32 = c;
+	(void)s32;
+	uint32_t c32 = (uint32_t)(((uint64_t)blocks * sizeof(s_buf) * 1000ULL) / ((dt > 0U) ? dt : 1U));
+
+	printf("CRC blocs de %u o : CRC-8 bit à bit %u Mo/s, table %u Mo/s, slice-by-4 %u Mo/s ; CRC-32 logiciel %u Mo/s\n",
+	       (unsigned)sizeof(s_buf), bit, tab, slice, c32);
+	CHECK(tab > bit);                              /* la table doit battre la référence */
+	CHECK(slice > 0U && c32 > 0U);
+	TEST_END();
+}
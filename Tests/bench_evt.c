@@ -0,0 +1,128 @@
+/**
+ * @file    bench_evt.c
+ * @brief   Diffusion des changements d'état : couche d'abonnement réelle
+ *          (core_init.c, notifications directes) contre l'ancienne file
+ *          d'événements (event group + xQueueSend, un consommateur), sur le
+ *          noyau FreeRTOS du dépôt en port hôte (rtos_host/, scheduler non
+ *          démarré : coût des API seules, sans commutation de contexte).
+ *          RAM des deux variantes tirée des lignes RTOS_RAM_OBJECTS
+ *          (Core_RamReport, tailles hôte : pointeurs 64 bits).
+ *          Usage : bench_evt [publications]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "core_init.h"
+#include <stdlib.h>
+#include <time.h>
+
+/* Ancienne file s_qEvents (retirée) : un event_t par transition, consommée par task_can seule */
+typedef uint32_t event_t;
+#define EVT_SET             (1UL << 31)
+#define Q_EVENTS_LEN        16U
+#define RAM_QUEUE(n, sz)    ((n) * (sz) + sizeof(StaticQueue_t))
+
+static StaticTask_t  s_tcb[EVT_SUBS_MAX];
+static StackType_t   s_stack[EVT_SUBS_MAX][configMINIMAL_STACK_SIZE];
+static StaticQueue_t s_qCb;
+static uint8_t       s_qBuf[Q_EVENTS_LEN * sizeof(event_t)];
+
+static void sub_task(void *arg)
+{
+	(void)arg;
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Abonnés créés par priorité croissante : le dernier est la tâche courante, celle qui attend */
+static void subscribe(uint32_t from, uint32_t to)
+{
+	for (uint32_t i = from; i < to; i++) {
+		TaskHandle_t t = xTaskCreateStatic(sub_task, "sub", configMINIMAL_STACK_SIZE, NULL,
+		                                   1U + i, s_stack[i], &s_tcb[i]);
+		Core_EvtSubscribe(t, EVT_SYS_DOOR_OPEN | EVT_SYS_ALARM_ACTIVE);
+	}
+}
+
+/* Publication -> attente côté tâche courante ; ns par événement */
+static uint64_t run_notify(uint32_t rounds, uint32_t *bad)
+{
+	uint64_t t0 = now_ns();
+
+	for (uint32_t i = 0U; i < rounds; i++) {
+		bool set = (i & 1U) == 0U;
+		Core_EvtPublish(EVT_SYS_DOOR_OPEN, set);
+		uint32_t val = Core_EvtWait(0U);
+		*bad += (val != (set ? EVT_SYS_DOOR_OPEN : EVT_FELL(EVT_SYS_DOOR_OPEN))) ? 1U : 0U;
+	}
+	return (now_ns() - t0) / rounds;
+}
+
+/* Ancien chemin : bit d'état, transition datée dans la file, lecture par le consommateur */
+static uint64_t run_queue(QueueHandle_t q, uint32_t rounds, uint32_t *bad)
+{
+	EventGroupHandle_t evt = Core_GetSysEvents();
+	uint64_t           t0  = now_ns();
+
+	for (uint32_t i = 0U; i < rounds; i++) {
+		bool    set = (i & 1U) == 0U;
+		event_t ev  = EVT_SYS_DOOR_OPEN | (set ? EVT_SET : 0U);
+		event_t got = 0U;
+
+		if (set) {
+			(void)xEventGroupSetBits(evt, EVT_SYS_DOOR_OPEN);
+		} else {
+			(void)xEventGroupClearBits(evt, EVT_SYS_DOOR_OPEN);
+		}
+		*bad += (xQueueSend(q, &ev, 0U) != pdPASS) ? 1U : 0U;
+		*bad += (xQueueReceive(q, &got, 0U) != pdPASS || got != ev) ? 1U : 0U;
+	}
+	return (now_ns() - t0) / rounds;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t         rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000000U;
+	uint32_t         bad    = 0U;
+	const core_ram_t *rows;
+	uint32_t         total;
+
+	Core_Init();
+	QueueHandle_t q = xQueueCreateStatic(Q_EVENTS_LEN, sizeof(event_t), s_qBuf, &s_qCb);
+	CHECK(q != NULL);
+
+	/* Un abonné puis EVT_SUBS_MAX : la file n'a qu'un consommateur quel que soit le nombre */
+	subscribe(0U, 1U);
+	uint64_t ns_q   = run_queue(q, rounds, &bad);
+	uint64_t ns_n1  = run_notify(rounds, &bad);
+	subscribe(1U, EVT_SUBS_MAX);
+	uint64_t ns_nx  = run_notify(rounds, &bad);
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(Core_EvtWait(0U), 0);
+	CHECK_EQ(xEventGroupGetBits(Core_GetSysEvents()) & EVT_SYS_DOOR_OPEN, 0);
+
+	/* RAM : notifications sans stockage (valeur dans le TCB, déjà comptée), file en plus */
+	size_t   n     = Core_RamReport(&rows, &total);
+	uint32_t q_ram = (uint32_t)RAM_QUEUE(Q_EVENTS_LEN, sizeof(event_t));
+	uint32_t sum   = 0U;
+	for (size_t i = 0U; i < n; i++) {
+		sum += rows[i].bytes;
+	}
+	CHECK_EQ(sum, total);
+
+	printf("publication -> attente : file %u ns, notification %u ns (1 abonné), %u ns (%u abonnés)\n",
+	       (unsigned)ns_q, (unsigned)ns_n1, (unsigned)ns_nx, (unsigned)EVT_SUBS_MAX);
+	printf("RAM objets RTOS (%u lignes, hôte) : notifications %u o, file d'événements %u o (+%u), "
+	       "une file par abonné %u o\n", (unsigned)n, total, total + q_ram, q_ram,
+	       total + EVT_SUBS_MAX * q_ram);
+	CHECK(ns_n1 < ns_q * 2U + 50U);
+	CHECK(total <= RTOS_RAM_BUDGET);
+	TEST_END();
+}
@@ -0,0 +1,34 @@
+/**
+ * @file    bench_filter.c
+ * @brief   Banc Filter_Bench sur hôte (horloge CLOCK_MONOTONIC en SIM_TARGET) :
+ *          coût moyen par échantillon d'une voie complète, meilleur de 5 passes.
+ *          Sur cible, le même appel rend des cycles DWT.
+ *          Usage : bench_filter [échantillons par passe]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "filter.h"
+#include <stdlib.h>
+
+#define BENCH_PASSES       5U
+#define BENCH_MAX_NS       2000U     /* borne large : détecte une régression grossière */
+
+int main(int argc, char **argv)
+{
+	uint32_t n    = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000U;
+	uint32_t best = UINT32_MAX;
+
+	CHECK_EQ(Filter_Bench(0U), 0);
+	for (uint32_t p = 0U; p < BENCH_PASSES; p++) {
+		uint32_t ns = Filter_Bench(n);
+		if (ns < best) {
+			best = ns;
+		}
+	}
+	printf("Filter_Chan : %u échantillons x %u passes, %u ns/échantillon\n", n, BENCH_PASSES, best);
+	CHECK(best <= BENCH_MAX_NS);
+	TEST_END();
+}
@@ -0,0 +1,154 @@
+/**
+ * @file    bench_logger_codec.c
+ * @brief   Coût du codec du journal sur les traces de test_logger_codec.c
+ *          (chambre froide, aléatoire pleine échelle, constante) : ns par
+ *          mesure en Logger_EncPut (buffers de CODEC_BUF, comme un bloc),
+ *          ns par mesure et Mo/s d'octets encodés au décodage par groupe
+ *          (Logger_DecNext), octets par mesure.
+ *          Usage : bench_logger_codec [passes]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <time.h>
+
+#define CODEC_BUF        4096U
+#define CODEC_N          3000U
+#define CODEC_CHUNKS     ((CODEC_N * LOGGER_REC_MAX) / (CODEC_BUF - LOGGER_REC_MAX) + 1U)
+#define BENCH_MAX_NS     5000U    /* borne large par mesure */
+
+typedef enum { TRACE_COLD, TRACE_RANDOM, TRACE_FLAT } trace_t;
+
+static const char *const k_names[] = { "froide", "aléatoire", "constante" };
+
+static uint32_t    s_seed;
+static log_entry_t s_tr[CODEC_N];
+static uint8_t     s_buf[CODEC_CHUNKS][CODEC_BUF];
+static size_t      s_len[CODEC_CHUNKS];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Mesure i d'une trace : mêmes générateurs que test_logger_codec.c */
+static log_entry_t trace(trace_t kind, uint32_t i)
+{
+	log_entry_t e = { 0 };
+
+	switch (kind) {
+	case TRACE_COLD:
+		e.ts_ms   = i * 1000U;
+		e.t_cC    = (int16_t)(300 + (int32_t)((i / 20U) % 60U) - 30 + (int32_t)(test_rnd(&s_seed) % 3U) - 1);
+		e.rh_pm   = (uint16_t)(550 + (i / 300U) % 5U);
+		e.tmcu_cC = 3000;
+		e.vin_mV  = (uint16_t)(24000 + (test_rnd(&s_seed) % 8U == 0U ? 10 : 0));
+		e.door    = (uint8_t)((i % 600U) < 30U);
+		e.flags   = 0U;
+		break;
+	case TRACE_RANDOM:
+		e.ts_ms   = i * 1000U + test_rnd(&s_seed) % 5000U;
+		e.t_cC    = (int16_t)test_rnd(&s_seed);
+		e.rh_pm   = (uint16_t)test_rnd(&s_seed);
+		e.tmcu_cC = (int16_t)test_rnd(&s_seed);
+		e.vin_mV  = (uint16_t)test_rnd(&s_seed);
+		e.door    = (uint8_t)test_rnd(&s_seed);
+		e.flags   = (uint8_t)test_rnd(&s_seed);
+		break;
+	default:
+		e.ts_ms   = 0xFFFF0000U + i * 250U;
+		e.t_cC    = -1800;
+		e.rh_pm   = 900;
+		e.tmcu_cC = 2700;
+		e.vin_mV  = 23950;
+		break;
+	}
+	return e;
+}
+
+/* Trace entière par buffers de CODEC_BUF ; octets produits */
+static size_t encode(size_t *chunks)
+{
+	logger_enc_t enc;
+	size_t       total = 0U;
+	uint32_t     in    = 0U;
+
+	*chunks = 0U;
+	while (in < CODEC_N) {
+		size_t pos = 0U;
+
+		Logger_EncBegin(&enc);
+		while (in < CODEC_N && Logger_EncPut(&enc, &s_tr[in], s_buf[*chunks], CODEC_BUF, &pos)) {
+			in++;
+		}
+		Logger_EncEnd(&enc, s_buf[*chunks], &pos);
+		s_len[(*chunks)++] = pos;
+		total += pos;
+	}
+	return total;
+}
+
+/* Mesures relues ; somme des horodatages pour que la boucle ne soit pas éliminée */
+static uint32_t decode(size_t chunks, volatile uint32_t *sink)
+{
+	uint32_t n   = 0U;
+	uint32_t acc = 0U;
+
+	for (size_t c = 0U; c < chunks; c++) {
+		logger_dec_t dec;
+		log_entry_t  d;
+		size_t       rp = 0U;
+
+		Logger_DecBegin(&dec);
+		while (Logger_DecNext(&dec, s_buf[c], s_len[c], &rp, &d)) {
+			acc += d.ts_ms ^ (uint32_t)d.t_cC;
+			n++;
+		}
+	}
+	*sink = acc;
+	return n;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t          passes = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 200U;
+	volatile uint32_t sink;
+
+	for (trace_t kind = TRACE_COLD; kind <= TRACE_FLAT; kind++) {
+		size_t   chunks = 0U, bytes = 0U;
+		uint32_t got    = 0U;
+
+		s_seed = 0x9E3779B9U;
+		for (uint32_t i = 0U; i < CODEC_N; i++) {
+			s_tr[i] = trace(kind, i);
+		}
+
+		uint64_t t0 = now_ns();
+		for (uint32_t p = 0U; p < passes; p++) {
+			bytes = encode(&chunks);
+		}
+		uint64_t enc_ns = (now_ns() - t0) / ((uint64_t)passes * CODEC_N);
+
+		t0 = now_ns();
+		for (uint32_t p = 0U; p < passes; p++) {
+			got = decode(chunks, &sink);
+		}
+		uint64_t dt     = now_ns() - t0;
+		uint64_t dec_ns = dt / ((uint64_t)passes * CODEC_N);
+		uint32_t dec_mb = (uint32_t)(((uint64_t)passes * bytes * 1000ULL) / ((dt > 0U) ? dt : 1U));
+		uint32_t bps    = (uint32_t)(bytes * 100U / CODEC_N);
+
+		printf("codec trace %s : %u.%02u o/mesure, EncPut %u ns/mesure, décodage %u ns/mesure (%u Mo/s)\n",
+		       k_names[kind], bps / 100U, bps % 100U, (unsigned)enc_ns, (unsigned)dec_ns, dec_mb);
+		CHECK_EQ(got, CODEC_N);
+		CHECK(bytes <= (size_t)CODEC_N * LOGGER_REC_MAX);
+		CHECK(enc_ns < BENCH_MAX_NS && dec_ns < BENCH_MAX_NS);
+	}
+	TEST_END();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file    bench_logger_ring.c
+ * @brief   Débit du ring SPSC du logger : Append + Drain sur un thread (coût
+ *          d'une entrée sans contention), puis producteur / consommateur sur
+ *          deux threads (lignes de cache des index partagées).
+ *          Usage : bench_logger_ring [entrées]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include "fram_spi.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_BATCH     16U      /* lot du chemin de commit (COMMIT_BATCH) */
+#define BENCH_MAX_NS    5000U    /* borne large par entrée */
+
+static uint32_t s_n;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *producer(void *arg)
+{
+	log_entry_t e = { 0 };
+
+	(void)arg;
+	for (uint32_t i = 0U; i < s_n; i++) {
+		e.ts_ms = i;
+		while (!Logger_Append(&e)) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	log_entry_t out[BENCH_BATCH];
+	log_entry_t e = { 0 };
+	uint32_t    got = 0U;
+	pthread_t   th;
+
+	s_n = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 4000000U;
+	remove(FRAM_SIM_FILE);
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	Logger_Init();
+
+	/* Un thread : lots de BENCH_BATCH, comme task_proc puis le commit */
+	uint64_t t0 = now_ns();
+	for (uint32_t i = 0U; i < s_n; i += BENCH_BATCH) {
+		for (uint32_t k = 0U; k < BENCH_BATCH; k++) {
+			e.ts_ms = i + k;
+			(void)Logger_Append(&e);
+		}
+		got += (uint32_t)Logger_Drain(out, BENCH_BATCH);
+	}
+	uint64_t ns1 = (now_ns() - t0) / s_n;
+	CHECK(got >= s_n);
+	CHECK_EQ(Logger_Dropped(), 0);
+	uint32_t full0 = Logger_Dropped();
+
+	/* Deux threads */
+	got = 0U;
+	t0  = now_ns();
+	CHECK_EQ(pthread_create(&th, NULL, producer, NULL), 0);
+	while (got < s_n) {
+		size_t n = Logger_Drain(out, BENCH_BATCH);
+		if (n == 0U) {
+			sched_yield();
+		}
+		got += (uint32_t)n;
+	}
+	pthread_join(th, NULL);
+	uint64_t ns2 = (now_ns() - t0) / s_n;
+
+	/* Append refusé (ring plein) : compté perdu par le logger, retenté par le producteur */
+	printf("ring %u entrées : %llu ns/entrée (1 thread, Append + Drain), %llu ns/entrée (SPSC 2 threads, %u ring plein)\n",
+	       s_n, (unsigned long long)ns1, (unsigned long long)ns2, Logger_Dropped() - full0);
+	CHECK_EQ(got, s_n);
+	CHECK(ns1 <= BENCH_MAX_NS && ns2 <= BENCH_MAX_NS);
+	TEST_END();
+}
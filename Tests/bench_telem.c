@@ -0,0 +1,120 @@
+/**
+ * @file    bench_telem.c
+ * @brief   Mesure de télémétrie copiée par valeur dans une file de
+ *          Q_TELEM_LEN (s_qTelem, task_acq -> task_proc) : ancien telem_t
+ *          float de 24 octets contre le telem_t virgule fixe de 16 octets.
+ *          Files FreeRTOS du dépôt sur le port hôte (rtos_host/) : octets
+ *          par élément et de stockage, ns par copie (envoi + réception).
+ *          Usage : bench_telem [remplissages de la file]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "telem.h"
+#include "config.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Ancien type de core_init.c (avant telem.h) */
+typedef struct {
+	float    t_c;
+	float    rh_pct;
+	float    t_mcu_c;
+	float    vin_v;
+	uint8_t  door;
+	uint32_t flags;
+} telem_float_t;
+
+typedef char telem_float_size_check[(sizeof(telem_float_t) == 24U) ? 1 : -1];
+
+static StaticQueue_t s_qCb[2];
+static uint8_t       s_qFloatBuf[Q_TELEM_LEN * sizeof(telem_float_t)];
+static uint8_t       s_qFixBuf[Q_TELEM_LEN * sizeof(telem_t)];
+static telem_float_t s_float[Q_TELEM_LEN];
+static telem_t       s_fix[Q_TELEM_LEN];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* File remplie par task_acq puis vidée par task_proc ; ns par élément (envoi + réception) */
+static uint64_t run(QueueHandle_t q, const void *src, size_t sz, uint32_t fills, uint32_t *bad,
+                    volatile uint8_t *sink)
+{
+	uint8_t  out[sizeof(telem_float_t)];
+	uint8_t  acc = 0U;
+	uint64_t t0  = now_ns();
+
+	for (uint32_t f = 0U; f < fills; f++) {
+		for (uint32_t i = 0U; i < Q_TELEM_LEN; i++) {
+			*bad += (xQueueSend(q, (const uint8_t *)src + i * sz, 0U) != pdPASS) ? 1U : 0U;
+		}
+		for (uint32_t i = 0U; i < Q_TELEM_LEN; i++) {
+			*bad += (xQueueReceive(q, out, 0U) != pdPASS) ? 1U : 0U;
+			acc  ^= out[i % sz];
+		}
+	}
+	uint64_t dt = now_ns() - t0;
+	*sink = acc;
+	return dt / ((uint64_t)fills * Q_TELEM_LEN);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t         fills = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 200000U;
+	uint32_t         seed  = 10U;
+	uint32_t         bad   = 0U;
+	volatile uint8_t sink;
+	telem_t          t;
+
+	/* Mêmes mesures dans les deux représentations */
+	for (uint32_t i = 0U; i < Q_TELEM_LEN; i++) {
+		s_fix[i].ts_ms   = i * PERIOD_ACQ_MS;
+		s_fix[i].t_cC    = (int16_t)(200 + (int32_t)(test_rnd(&seed) % 41U) - 20);
+		s_fix[i].rh_pm   = (uint16_t)(850U + test_rnd(&seed) % 20U);
+		s_fix[i].tmcu_cC = (int16_t)(2800 + (int32_t)(test_rnd(&seed) % 41U) - 20);
+		s_fix[i].vin_mV  = (uint16_t)(24000U + test_rnd(&seed) % 61U);
+		s_fix[i].door    = (uint8_t)(test_rnd(&seed) & 1U);
+		s_fix[i].flags   = 0U;
+		s_float[i].t_c     = (float)s_fix[i].t_cC / 100.0f;
+		s_float[i].rh_pct  = (float)s_fix[i].rh_pm / 10.0f;
+		s_float[i].t_mcu_c = (float)s_fix[i].tmcu_cC / 100.0f;
+		s_float[i].vin_v   = (float)s_fix[i].vin_mV / 1000.0f;
+		s_float[i].door    = s_fix[i].door;
+		s_float[i].flags   = 0U;
+	}
+
+	QueueHandle_t qf = xQueueCreateStatic(Q_TELEM_LEN, sizeof(telem_float_t), s_qFloatBuf, &s_qCb[0]);
+	QueueHandle_t qx = xQueueCreateStatic(Q_TELEM_LEN, sizeof(telem_t), s_qFixBuf, &s_qCb[1]);
+	CHECK(qf != NULL && qx != NULL);
+
+	/* Meilleur de trois passes alternées : sur hôte la gestion de file domine la copie */
+	uint64_t ns_f = UINT64_MAX, ns_x = UINT64_MAX;
+	for (uint32_t k = 0U; k < 3U; k++) {
+		uint64_t f = run(qf, s_float, sizeof(telem_float_t), fills, &bad, &sink);
+		uint64_t x = run(qx, s_fix, sizeof(telem_t), fills, &bad, &sink);
+		ns_f = (f < ns_f) ? f : ns_f;
+		ns_x = (x < ns_x) ? x : ns_x;
+	}
+	CHECK_EQ(bad, 0);
+
+	/* La file rend la mesure intacte */
+	CHECK(xQueueSend(qx, &s_fix[3], 0U) == pdPASS);
+	CHECK(xQueueReceive(qx, &t, 0U) == pdPASS);
+	CHECK(memcmp(&t, &s_fix[3], sizeof(t)) == 0);
+
+	printf("file de %u : float %u o/élément (%u o de stockage) %u ns/copie, virgule fixe %u o (%u o) %u ns/copie\n",
+	       (unsigned)Q_TELEM_LEN, (unsigned)sizeof(telem_float_t), (unsigned)sizeof(s_qFloatBuf), (unsigned)ns_f,
+	       (unsigned)sizeof(telem_t), (unsigned)sizeof(s_qFixBuf), (unsigned)ns_x);
+	CHECK_EQ(sizeof(s_qFloatBuf) - sizeof(s_qFixBuf), Q_TELEM_LEN * 8U);
+	CHECK(ns_x < ns_f * 2U + 20U);
+	TEST_END();
+}
@@ -0,0 +1,27 @@
+/**
+ * @file    ram_report.c
+ * @brief   Bilan RAM des objets RTOS (lignes RTOS_RAM_OBJECTS de core_init.c
+ *          via Core_RamReport), affiché à chaque build des tests hôte.
+ *          Tailles hôte (pointeurs 64 bits) : majorent celles de la cible,
+ *          dont le total est vérifié à la compilation contre RTOS_RAM_BUDGET.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include <stdio.h>
+#include "core_init.h"
+
+int main(void)
+{
+	const core_ram_t *rows;
+	uint32_t          total;
+	size_t            n = Core_RamReport(&rows, &total);
+
+	printf("RAM objets RTOS (hôte) :\n");
+	for (size_t i = 0U; i < n; i++) {
+		printf("  %-14s %6u o\n", rows[i].name, (unsigned)rows[i].bytes);
+	}
+	printf("  %-14s %6u o / %u o (RTOS_RAM_BUDGET)\n", "total", (unsigned)total, (unsigned)RTOS_RAM_BUDGET);
+	return (total <= RTOS_RAM_BUDGET) ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file    port.c
+ * @brief   Port FreeRTOS hôte minimal (voir portmacro.h) : pile initiale non
+ *          préparée (les tâches ne tournent jamais), démarrage du scheduler
+ *          refusé, configASSERT fatal.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+void vPortHostAssert(void)
+{
+	fprintf(stderr, "configASSERT\n");
+	abort();
+}
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+	(void)pxCode;
+	(void)pvParameters;
+	return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+	return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+}
+
+/* Fournis par freertos.c sur cible ; référencés par vTaskStartScheduler, jamais appelé */
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *words)
+{
+	(void)tcb;
+	(void)stack;
+	(void)words;
+	vPortHostAssert();
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *words)
+{
+	(void)tcb;
+	(void)stack;
+	(void)words;
+	vPortHostAssert();
+}
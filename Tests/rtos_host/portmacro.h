@@ -0,0 +1,81 @@
+/**
+ * @file    portmacro.h
+ * @brief   Port FreeRTOS hôte minimal pour les bancs : le noyau du dépôt
+ *          (Middlewares/Third_Party/FreeRTOS) compilé sur x86-64, objets
+ *          créés et API appelées depuis main, scheduler jamais démarré
+ *          (aucune commutation de contexte, sections critiques vides).
+ *          Types et tic identiques au port ARM_CM4F, sauf les pointeurs.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portPOINTER_SIZE_TYPE		uintptr_t
+
+/* Un seul fil, pas d'IT : rien à masquer ni à commuter. Seul configASSERT masque les IT
+ * (taskDISABLE_INTERRUPTS puis boucle infinie) : le banc s'arrête au lieu de boucler.
+ */
+extern void vPortHostAssert( void );
+
+#define portYIELD()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	( void ) ( xSwitchRequired )
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+
+#define portDISABLE_INTERRUPTS()					vPortHostAssert()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portSET_INTERRUPT_MASK_FROM_ISR()			0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )		( void ) ( x )
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 63UL - ( UBaseType_t ) __builtin_clzl( ( uxReadyPriorities ) ) )
+#endif
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE				__inline
+#define portFORCE_INLINE		inline __attribute__( ( always_inline ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
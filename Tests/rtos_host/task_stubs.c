@@ -0,0 +1,33 @@
+/**
+ * @file    task_stubs.c
+ * @brief   Démarrages des tâches applicatives vides pour les cibles hôte qui
+ *          lient core_init.c tel quel : Core_Init crée ses objets (file
+ *          télémétrie, event group, timer de commit) sans tâche derrière.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "task_acq.h"
+#include "task_proc.h"
+#include "task_can.h"
+#include "task_log.h"
+
+void TaskAcq_Start(QueueHandle_t qTelem)
+{
+	(void)qTelem;
+}
+
+void TaskProc_Start(QueueHandle_t qTelem)
+{
+	(void)qTelem;
+}
+
+void TaskCan_Start(EventGroupHandle_t evtSys)
+{
+	(void)evtSys;
+}
+
+void TaskLog_Start(void)
+{
+}
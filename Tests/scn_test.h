@@ -0,0 +1,47 @@
+/**
+ * @file    scn_test.h
+ * @brief   Assertions des tests hôte (SIM_TARGET) : un échec est signalé avec
+ *          fichier, ligne et valeurs, le test continue ; TEST_END() rend un
+ *          code de sortie non nul si au moins une assertion a échoué (ctest).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+static int s_test_fail;
+
+#define CHECK(c) do { \
+	if (!(c)) { \
+		s_test_fail++; \
+		fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); \
+	} \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+	long long _a = (long long)(a), _b = (long long)(b); \
+	if (_a != _b) { \
+		s_test_fail++; \
+		fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) : %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+	} \
+} while (0)
+
+#define TEST_END() do { \
+	printf("%s : %s\n", __FILE__, (s_test_fail == 0) ? "OK" : "ECHEC"); \
+	return (s_test_fail == 0) ? 0 : 1; \
+} while (0)
+
+/* xorshift32 : suites reproductibles d'un lancement à l'autre */
+static inline uint32_t test_rnd(uint32_t *s)
+{
+	uint32_t x = *s;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*s = x;
+	return x;
+}
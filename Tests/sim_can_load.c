@@ -0,0 +1,95 @@
+/**
+ * @file    sim_can_load.c
+ * @brief   Charge bus CAN de N noeuds SCN, télémétrie périodique contre
+ *          émission par exception (bande morte + heartbeat) : trames par
+ *          seconde et charge offerte (CanLoad_SimRun), puis occupation,
+ *          pertes et latences mesurées sur le bus virtuel (CanLoad_SimRunBus).
+ *          Usage : sim_can_load [noeuds max] [minutes simulées]
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_load.h"
+#include "can_bus.h"
+#include <stdlib.h>
+
+static const uint16_t k_nodes[] = { 1U, 8U, 16U, 32U, 64U, 127U };
+
+/* Pire latence et pertes sur les noeuds du dernier SimRunBus */
+static void bus_nodes(uint16_t nodes, uint32_t *p99_max, uint32_t *alarm_max)
+{
+	*p99_max   = 0U;
+	*alarm_max = 0U;
+	for (uint16_t i = 0U; i < nodes; i++) {
+		canbus_node_stats_t ns;
+		CanBus_SimGetNodeStats(i, &ns);
+		*p99_max   = (ns.lat_p99_us > *p99_max) ? ns.lat_p99_us : *p99_max;
+		*alarm_max = (ns.alarm_max_us > *alarm_max) ? ns.alarm_max_us : *alarm_max;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint16_t         max_nodes = (argc > 1) ? (uint16_t)strtoul(argv[1], NULL, 0) : CANLOAD_NODES_MAX;
+	uint32_t         minutes   = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 10U;
+	canload_cfg_t    cfg       = { .nodes = 0U, .duration_ms = minutes * 60000U, .seed = 24U };
+	canload_result_t per, exc, again, per_bus;
+
+	/* Configurations refusées */
+	CHECK(!CanLoad_SimRun(&cfg, &per));
+	cfg.nodes = CANLOAD_NODES_MAX + 1U;
+	CHECK(!CanLoad_SimRunBus(&cfg, &per));
+	cfg.nodes       = 1U;
+	cfg.duration_ms = 0U;
+	CHECK(!CanLoad_SimRun(&cfg, &per));
+	cfg.duration_ms = minutes * 60000U;
+
+	printf("%u min, CAN_BAUD %u, télémétrie toutes les %u ms, heartbeat %u ms\n",
+	       minutes, (unsigned)CAN_BAUD, (unsigned)PERIOD_CAN_MS, (unsigned)PERIOD_CAN_HB_MS);
+	printf("noeuds | périodique : trames/s  charge  sur bus  pertes | exception : trames/s  charge | bus : occup.  pertes  p99 max  alarme max\n");
+	for (size_t k = 0U; k < sizeof(k_nodes) / sizeof(k_nodes[0]) && k_nodes[k] <= max_nodes; k++) {
+		uint32_t p99, alarm;
+
+		cfg.nodes = k_nodes[k];
+		cfg.mode  = CANP_REPORT_PERIODIC;
+		CHECK(CanLoad_SimRun(&cfg, &per));
+		CHECK(CanLoad_SimRunBus(&cfg, &per_bus));
+		cfg.mode  = CANP_REPORT_EXCEPTION;
+		CHECK(CanLoad_SimRun(&cfg, &exc));
+		CHECK(CanLoad_SimRunBus(&cfg, &again));
+		bus_nodes(cfg.nodes, &p99, &alarm);
+
+		printf("%6u | %20u.%02u %6u‰ %7u‰ %7u | %19u.%02u %6u‰ | %11u‰ %7u %6u us %8u us\n", cfg.nodes,
+		       per.fps_x100 / 100U, per.fps_x100 % 100U, per.load_pm, per_bus.load_pm, per_bus.lost,
+		       exc.fps_x100 / 100U, exc.fps_x100 % 100U, exc.load_pm,
+		       again.load_pm, again.lost, p99, alarm);
+
+		/* Périodique : au moins l'état de télémétrie (2 trames) à chaque cycle de chaque noeud */
+		CHECK(per.frames_telem >= 2U * cfg.nodes * (cfg.duration_ms / PERIOD_CAN_MS));
+		/* ... segment saturé au-delà de la capacité du bus, tenu en deçà */
+		if (per.load_pm > 1000U) {
+			CHECK(per_bus.lost > 0U);
+			CHECK(per_bus.load_pm > 950U);
+		} else if (per.load_pm < 800U) {
+			CHECK_EQ(per_bus.lost, 0);
+		}
+		/* Exception : une fraction de la charge, alarmes identiques (mêmes grandeurs) */
+		CHECK(exc.fps_x100 * 4U < per.fps_x100);
+		CHECK_EQ(exc.frames_alarm, per.frames_alarm);
+		CHECK(exc.load_pm < 1000U);
+		/* Sur le bus : tout passe tant que la charge offerte est tenable */
+		CHECK_EQ(again.frames_telem, exc.frames_telem);
+		CHECK_EQ(again.lost, 0);
+		CHECK(again.load_pm + 20U >= exc.load_pm && again.load_pm <= exc.load_pm + 20U);
+	}
+
+	/* Même graine, mêmes trames */
+	cfg.nodes = 8U;
+	CHECK(CanLoad_SimRun(&cfg, &exc));
+	CHECK(CanLoad_SimRun(&cfg, &again));
+	CHECK_EQ(again.frames_telem, exc.frames_telem);
+	CHECK_EQ(again.frames_alarm, exc.frames_alarm);
+	TEST_END();
+}
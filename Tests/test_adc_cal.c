@@ -0,0 +1,115 @@
+/**
+ * @file    test_adc_cal.c
+ * @brief   Conversions ratiométriques (VREFINT) contre des vecteurs de comptes
+ *          synthétiques : VDDA de 2,9 à 3,6 V, Vin 0..30 V, capteur -20..100 °C,
+ *          valeurs d'usine variées ; repli sur les valeurs typiques si la zone
+ *          de calibration est incohérente.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "adc_utils.h"
+#include <math.h>
+
+#define CAL_VDDA_mV     3300.0     /* conditions de calibration d'usine */
+#define TS_V25_mV       760.0      /* capteur : 0,76 V à 25 °C, 2,5 mV/°C */
+#define TS_SLOPE_mV     2.5
+
+typedef struct {
+	double vref_mV;                /* VREFINT réelle de la puce */
+	double ts_off_mV;              /* écart du capteur à la valeur typique */
+} chip_t;
+
+static const chip_t k_chips[] = {
+	{ 1210.0,  0.0 },
+	{ 1190.0, -8.0 },
+	{ 1230.0, 12.0 },
+};
+static const double k_vdda[] = { 2900.0, 3000.0, 3150.0, 3300.0, 3450.0, 3600.0 };
+
+static uint16_t counts(double mv, double vdda)
+{
+	double c = mv / vdda * 4095.0 + 0.5;
+	return (uint16_t)((c > 4095.0) ? 4095.0 : c);
+}
+
+static double ts_mV(const chip_t *p, double t_C)
+{
+	return TS_V25_mV + p->ts_off_mV + TS_SLOPE_mV * (t_C - 25.0);
+}
+
+/* Valeurs d'usine de la puce, relevées comme en production (VDDA = 3,3 V, 30 et 110 °C) */
+static void chip_cal(const chip_t *p)
+{
+	AdcUtils_SimSetCal(counts(p->vref_mV, CAL_VDDA_mV), counts(ts_mV(p, 30.0), CAL_VDDA_mV),
+	                   counts(ts_mV(p, 110.0), CAL_VDDA_mV));
+}
+
+static void feed(double vin_mV, double t_C, double vdda, const chip_t *p, adc_raw_t *raw)
+{
+	double div = (double)VIN_DIV_RBOT_OHM / (double)(VIN_DIV_RTOP_OHM + VIN_DIV_RBOT_OHM);
+	AdcUtils_SimFeed(counts(vin_mV * div, vdda), counts(ts_mV(p, t_C), vdda), counts(p->vref_mV, vdda));
+	AdcUtils_GetRaw(raw);
+}
+
+int main(void)
+{
+	adc_raw_t raw;
+	double    err_vin = 0.0, err_t = 0.0, err_vdda = 0.0;
+
+	CHECK_EQ(AdcUtils_Start(), SCN_OK);
+
+	for (size_t c = 0U; c < sizeof(k_chips) / sizeof(k_chips[0]); c++) {
+		const chip_t *p = &k_chips[c];
+		chip_cal(p);
+		for (size_t v = 0U; v < sizeof(k_vdda) / sizeof(k_vdda[0]); v++) {
+			double vdda = k_vdda[v];
+
+			feed(0.0, 25.0, vdda, p, &raw);
+			err_vdda = fmax(err_vdda, fabs(AdcUtils_VddamV(&raw) - vdda));
+
+			/* Vin : erreur bornée par la quantification (demi-compte sur Vin, sur VREFINT
+			 * et sur VREFINT_CAL, ~1500 comptes chacune), quelle que soit VDDA */
+			for (double mv = 5000.0; mv <= 30000.0; mv += 500.0) {
+				double lim = mv / 1000.0 + 5.0;
+				feed(mv, 25.0, vdda, p, &raw);
+				if (mv * (double)VIN_DIV_RBOT_OHM / (double)(VIN_DIV_RTOP_OHM + VIN_DIV_RBOT_OHM) >= vdda) {
+					continue;                                         /* entrée saturée à cette VDDA */
+				}
+				double e = fabs((double)AdcUtils_VinmV(&raw) - mv);
+				err_vin = fmax(err_vin, e);
+				CHECK(e <= lim);
+			}
+			feed(0.0, 25.0, vdda, p, &raw);
+			CHECK_EQ(AdcUtils_VinmV(&raw), 0);
+
+			/* Température : recalée sur les points d'usine de la puce, VDDA compensée */
+			for (double t = -20.0; t <= 100.0; t += 5.0) {
+				feed(24000.0, t, vdda, p, &raw);
+				double e = fabs(AdcUtils_TmcucC(&raw) / 100.0 - t);
+				err_t = fmax(err_t, e);
+				CHECK(e <= 1.0);
+			}
+		}
+	}
+	printf("erreurs max : Vin %.1f mV, Tmcu %.2f °C, VDDA %.1f mV\n", err_vin, err_t, err_vdda);
+	CHECK(err_vdda <= 3.0);
+
+	/* VDDA affaissée : sans VREFINT (Vref supposée 3,3 V) l'erreur dépasserait 2 V à 24 V */
+	chip_cal(&k_chips[0]);
+	feed(24000.0, 25.0, 2900.0, &k_chips[0], &raw);
+	CHECK(fabs((double)AdcUtils_VinmV(&raw) - 24000.0) <= 30.0);
+
+	/* Zone de calibration incohérente : valeurs typiques (VREFINT 1,21 V, 0,76 V @ 25 °C) */
+	AdcUtils_SimSetCal(0xFFFFU, 0xFFFFU, 0xFFFFU);
+	feed(24000.0, 30.0, 3300.0, &k_chips[0], &raw);
+	CHECK(fabs((double)AdcUtils_VinmV(&raw) - 24000.0) <= 30.0);
+	CHECK(fabs(AdcUtils_TmcucC(&raw) / 100.0 - 30.0) <= 1.0);
+	AdcUtils_SimSetCal(1502U, 1207U, 959U);                          /* points inversés */
+	feed(24000.0, 30.0, 3300.0, &k_chips[0], &raw);
+	CHECK(fabs(AdcUtils_TmcucC(&raw) / 100.0 - 30.0) <= 1.0);
+
+	TEST_END();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file    test_adc_scan.c
+ * @brief   Scan ADC1 sur le mock du buffer DMA (AdcUtils_SimFeed) : rien avant
+ *          le premier scan, sommes de suréchantillonnage par voie, alternance
+ *          des moitiés du buffer circulaire ; conversions Vin et température
+ *          aux points de calibration et entre eux.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "adc_utils.h"
+#include <stdlib.h>
+
+#define CAL_VREF    1502U          /* VREFINT à 3,3 V (valeur d'usine simulée) */
+#define CAL_TS1     959U           /* capteur à 30 °C */
+#define CAL_TS2     1207U          /* capteur à 110 °C */
+
+/* Comptes 12 bits de l'entrée vin_mV à VDDA = 3,3 V à travers le pont */
+static uint16_t vin_counts(uint32_t vin_mV)
+{
+	uint64_t num = (uint64_t)vin_mV * VIN_DIV_RBOT_OHM * 4095U;
+	uint64_t den = (uint64_t)3300U * (VIN_DIV_RTOP_OHM + VIN_DIV_RBOT_OHM);
+	return (uint16_t)((num + den / 2U) / den);
+}
+
+int main(void)
+{
+	adc_raw_t raw;
+
+	AdcUtils_SimSetCal(CAL_VREF, CAL_TS1, CAL_TS2);
+	CHECK_EQ(AdcUtils_Start(), SCN_OK);
+
+	/* Aucun scan : pas de mesure, conversions neutres */
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(raw.scans, 0);
+	CHECK_EQ(AdcUtils_VinmV(&raw), 0);
+	CHECK_EQ(AdcUtils_VddamV(&raw), 0);
+	CHECK_EQ(AdcUtils_TmcucC(&raw), 0);
+
+	/* Sommes ADC_OVS par voie, voies non mélangées, moitiés alternées */
+	AdcUtils_SimFeed(100U, 200U, 300U);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(raw.scans, 1);
+	CHECK_EQ(raw.sum[ADC_CH_VIN], 100U * ADC_OVS);
+	CHECK_EQ(raw.sum[ADC_CH_TSENS], 200U * ADC_OVS);
+	CHECK_EQ(raw.sum[ADC_CH_VREF], 300U * ADC_OVS);
+	AdcUtils_SimFeed(4095U, 0U, 1U);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(raw.scans, 2);
+	CHECK_EQ(raw.sum[ADC_CH_VIN], 4095U * ADC_OVS);                 /* pleine échelle sans débordement */
+	CHECK_EQ(raw.sum[ADC_CH_TSENS], 0);
+	for (uint32_t i = 0U; i < 1000U; i++) {
+		AdcUtils_SimFeed((uint16_t)(i & 0xFFFU), (uint16_t)i, CAL_VREF);
+	}
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(raw.scans, 1002);
+	CHECK_EQ(raw.sum[ADC_CH_VIN], 999U * ADC_OVS);
+
+	/* Restart : compteur et dernier scan remis à zéro */
+	CHECK_EQ(AdcUtils_Start(), SCN_OK);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(raw.scans, 0);
+	CHECK_EQ(raw.sum[ADC_CH_VIN], 0);
+
+	/* Vin à VDDA nominale : 0..30 V, à un pas de quantification près (~8 mV ramené à l'entrée) */
+	for (uint32_t mv = 0U; mv <= 30000U; mv += 250U) {
+		AdcUtils_SimFeed(vin_counts(mv), CAL_TS1, CAL_VREF);
+		AdcUtils_GetRaw(&raw);
+		CHECK(abs((int)AdcUtils_VinmV(&raw) - (int)mv) <= 10);
+	}
+	AdcUtils_SimFeed(vin_counts(24000U), CAL_TS1, CAL_VREF);
+	AdcUtils_GetRaw(&raw);
+	CHECK(abs((int)AdcUtils_VddamV(&raw) - 3300) <= 1);
+
+	/* Température : exacte aux points d'usine, linéaire entre eux */
+	AdcUtils_SimFeed(0U, CAL_TS1, CAL_VREF);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(AdcUtils_TmcucC(&raw), 3000);
+	AdcUtils_SimFeed(0U, CAL_TS2, CAL_VREF);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(AdcUtils_TmcucC(&raw), 11000);
+	AdcUtils_SimFeed(0U, (CAL_TS1 + CAL_TS2) / 2U, CAL_VREF);
+	AdcUtils_GetRaw(&raw);
+	CHECK_EQ(AdcUtils_TmcucC(&raw), 7000);
+	for (uint16_t c = 900U; c < 1300U; c++) {                          /* monotone, ~32 centi-°C par compte */
+		AdcUtils_SimFeed(0U, c, CAL_VREF);
+		AdcUtils_GetRaw(&raw);
+		int16_t t0 = AdcUtils_TmcucC(&raw);
+		AdcUtils_SimFeed(0U, (uint16_t)(c + 1U), CAL_VREF);
+		AdcUtils_GetRaw(&raw);
+		int16_t t1 = AdcUtils_TmcucC(&raw);
+		CHECK(t1 > t0 && t1 - t0 <= 33);
+	}
+
+	TEST_END();
+}
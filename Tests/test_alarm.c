@@ -0,0 +1,191 @@
+/**
+ * @file    test_alarm.c
+ * @brief   Machine d'états d'alarme sur horloge virtuelle : dwell exact à la
+ *          ms, excursions courtes ignorées, retombée avec hystérésis, seuil
+ *          bas, compteur ms replié ; boucle pilotée par échéance comme
+ *          task_proc (réveil sur mesure ou sur Alarm_Deadline, jamais
+ *          périodique) : un seul événement par transition, à l'échéance.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "alarm.h"
+
+#define T_OK       200             /* milieu de plage */
+#define T_BAND     (TEMP_HIGH_cC - TEMP_HYST_cC / 2)
+#define T_HIGH     (TEMP_HIGH_cC + 1)
+#define T_LOWOUT   (TEMP_LOW_cC - 1)
+#define RUN_SAMPLES  20000U
+
+typedef struct {
+	uint32_t t;
+	int16_t  v;
+} smp_t;
+
+static smp_t    s_smp[RUN_SAMPLES];
+static uint32_t s_seed = 5U;
+
+/* Scénarios déterministes à partir de t0 (repli du compteur compris) */
+static void scenarios(uint32_t t0)
+{
+	alarm_t  a;
+	uint32_t w;
+
+	Alarm_Init(&a, NULL);
+	CHECK_EQ(Alarm_State(&a), ALARM_NORMAL);
+	CHECK(!Alarm_Deadline(&a, t0, &w));                                /* rien à attendre */
+
+	/* Dans la plage, y compris dans l'hystérésis : rien */
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t0), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_BAND, t0 + 1000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, TEMP_HIGH_cC, t0 + 2000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_NORMAL);
+
+	/* Excursion plus courte que le dwell : oubliée */
+	CHECK_EQ(Alarm_Sample(&a, T_HIGH, t0 + 3000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_PENDING);
+	CHECK(Alarm_Deadline(&a, t0 + 3000U, &w));
+	CHECK_EQ(w, ALARM_DWELL_MS);
+	CHECK_EQ(Alarm_Sample(&a, T_BAND, t0 + 3000U + ALARM_DWELL_MS - 1U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_NORMAL);
+	CHECK(!Alarm_Deadline(&a, t0 + 3000U + ALARM_DWELL_MS, &w));
+	CHECK_EQ(Alarm_Poll(&a, t0 + 3000U + ALARM_DWELL_MS), ALARM_EV_NONE);
+
+	/* Levée à l'échéance exacte, échéance non repoussée par les mesures hors plage suivantes */
+	uint32_t t1 = t0 + 20000U;
+	CHECK_EQ(Alarm_Sample(&a, T_HIGH, t1), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_HIGH + 300, t1 + 1000U), ALARM_EV_NONE);
+	CHECK(Alarm_Deadline(&a, t1 + 1000U, &w));
+	CHECK_EQ(w, ALARM_DWELL_MS - 1000U);
+	CHECK_EQ(Alarm_Poll(&a, t1 + ALARM_DWELL_MS - 1U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Poll(&a, t1 + ALARM_DWELL_MS), ALARM_EV_RAISE);
+	CHECK_EQ(Alarm_State(&a), ALARM_ACTIVE);
+	CHECK(Alarm_IsActive(&a));
+	CHECK(!Alarm_Deadline(&a, t1 + ALARM_DWELL_MS, &w));
+	CHECK_EQ(Alarm_Poll(&a, t1 + 10U * ALARM_DWELL_MS), ALARM_EV_NONE);  /* un seul événement */
+
+	/* Retour dans l'hystérésis seulement : l'alarme reste */
+	uint32_t t2 = t1 + 60000U;
+	CHECK_EQ(Alarm_Sample(&a, T_BAND, t2), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_ACTIVE);
+
+	/* Retombée interrompue (mesure dans l'hystérésis) puis complète */
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t2 + 1000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_CLEARING);
+	CHECK(Alarm_IsActive(&a));
+	CHECK_EQ(Alarm_Sample(&a, T_BAND, t2 + 3000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_ACTIVE);
+	CHECK_EQ(Alarm_Poll(&a, t2 + 1000U + ALARM_DWELL_MS), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t2 + 4000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t2 + 5000U), ALARM_EV_NONE);        /* échéance conservée */
+	CHECK(Alarm_Deadline(&a, t2 + 5000U, &w));
+	CHECK_EQ(w, ALARM_DWELL_MS - 1000U);
+
+	/* Échéance dépassée au moment d'une mesure : appliquée d'abord, un seul événement */
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t2 + 4000U + ALARM_DWELL_MS + 700U), ALARM_EV_CLEAR);
+	CHECK_EQ(Alarm_State(&a), ALARM_NORMAL);
+	CHECK(!Alarm_IsActive(&a));
+
+	/* Seuil bas, et retour hors plage pendant la retombée */
+	uint32_t t3 = t2 + 60000U;
+	CHECK_EQ(Alarm_Sample(&a, T_LOWOUT, t3), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_LOWOUT, t3 + ALARM_DWELL_MS), ALARM_EV_RAISE);
+	CHECK_EQ(Alarm_Sample(&a, T_OK, t3 + ALARM_DWELL_MS + 1000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Sample(&a, T_HIGH, t3 + ALARM_DWELL_MS + 2000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_ACTIVE);
+	CHECK_EQ(Alarm_Sample(&a, TEMP_LOW_cC + TEMP_HYST_cC, t3 + ALARM_DWELL_MS + 3000U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_CLEARING);                           /* bornes de la zone OK incluses */
+	CHECK_EQ(Alarm_Poll(&a, t3 + 2U * ALARM_DWELL_MS + 3000U), ALARM_EV_CLEAR);
+}
+
+/* Boucle de task_proc : attente bornée par la prochaine échéance, réveil sur mesure sinon */
+static void run_event_loop(uint32_t t0)
+{
+	alarm_t  a;
+	uint32_t t = t0, wakes = 0U, raises = 0U, clears = 0U;
+	bool     active = false;
+
+	/* Mesures à ~1 Hz, trous (capteur en défaut) ; plateaux de durée aléatoire */
+	int16_t v = T_OK;
+	for (uint32_t i = 0U; i < RUN_SAMPLES; i++) {
+		if (test_rnd(&s_seed) % 8U == 0U) {
+			static const int16_t lv[] = { T_OK, T_BAND, T_HIGH, T_HIGH + 200, T_LOWOUT, TEMP_LOW_cC + 10 };
+			v = lv[test_rnd(&s_seed) % (sizeof(lv) / sizeof(lv[0]))];
+		}
+		t += 900U + test_rnd(&s_seed) % 200U;
+		if (test_rnd(&s_seed) % 50U == 0U) {
+			t += test_rnd(&s_seed) % 15000U;
+		}
+		s_smp[i].t = t;
+		s_smp[i].v = v;
+	}
+
+	Alarm_Init(&a, NULL);
+	uint32_t now = t0;
+	for (uint32_t i = 0U; i < RUN_SAMPLES;) {
+		uint32_t   w;
+		alarm_ev_t ev;
+		wakes++;
+		if (Alarm_Deadline(&a, now, &w) && (int32_t)(now + w - s_smp[i].t) <= 0) {
+			now = now + w;                                           /* timeout de la file */
+			ev  = Alarm_Poll(&a, now);
+			CHECK(ev != ALARM_EV_NONE);                              /* échéance = transition visible */
+		} else {
+			now = s_smp[i].t;                                        /* mesure reçue */
+			ev  = Alarm_Sample(&a, s_smp[i].v, now);
+			i++;
+		}
+		if (ev == ALARM_EV_NONE) {
+			continue;
+		}
+
+		/* Alternance stricte, et dwell entier de mesures du bon côté juste avant l'échéance */
+		CHECK(ev == (active ? ALARM_EV_CLEAR : ALARM_EV_RAISE));
+		active = !active;
+		raises += (ev == ALARM_EV_RAISE) ? 1U : 0U;
+		clears += (ev == ALARM_EV_CLEAR) ? 1U : 0U;
+		bool armed_seen = false;
+		for (uint32_t j = 0U; j < RUN_SAMPLES; j++) {
+			int32_t age = (int32_t)(now - s_smp[j].t);
+			if (age > (int32_t)ALARM_DWELL_MS || age <= 0) {
+				continue;
+			}
+			int16_t x   = s_smp[j].v;
+			bool    out = (x > TEMP_HIGH_cC || x < TEMP_LOW_cC);
+			bool    ok  = (x >= TEMP_LOW_cC + TEMP_HYST_cC && x <= TEMP_HIGH_cC - TEMP_HYST_cC);
+			CHECK((ev == ALARM_EV_RAISE) ? out : ok);
+			armed_seen = armed_seen || (age >= (int32_t)ALARM_DWELL_MS);
+		}
+		CHECK(armed_seen);                                           /* armée exactement dwell plus tôt */
+	}
+	printf("t0 = %u : %u mesures, %u réveils, %u levées, %u retombées\n", t0, RUN_SAMPLES, wakes, raises, clears);
+	CHECK(raises > 50U);
+	CHECK(clears + 1U >= raises);
+	CHECK(wakes <= RUN_SAMPLES + raises + clears);                   /* aucun réveil sans mesure ni transition */
+}
+
+int main(void)
+{
+	alarm_cfg_t cfg;
+	alarm_t     a;
+
+	scenarios(0U);
+	scenarios(0U - 40000U);                                          /* compteur ms replié en cours de scénario */
+
+	/* Configuration explicite : seuils et dwell propres à l'instance */
+	Alarm_DefaultCfg(&cfg);
+	CHECK_EQ(cfg.dwell_ms, ALARM_DWELL_MS);
+	cfg.high_cC  = 800;
+	cfg.dwell_ms = 100U;
+	Alarm_Init(&a, &cfg);
+	CHECK_EQ(Alarm_Sample(&a, 600, 0U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_State(&a), ALARM_NORMAL);
+	CHECK_EQ(Alarm_Sample(&a, 801, 10U), ALARM_EV_NONE);
+	CHECK_EQ(Alarm_Poll(&a, 110U), ALARM_EV_RAISE);
+
+	run_event_loop(1000U);
+	run_event_loop(0U - 3600000U);
+	TEST_END();
+}
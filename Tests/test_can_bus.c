@@ -0,0 +1,383 @@
+/**
+ * @file    test_can_bus.c
+ * @brief   Bus CAN virtuel : longueur des trames contre un codeur de référence
+ *          (CRC-15 par division polynomiale, bourrage sur le flux émis),
+ *          durée exacte à CAN_BAUD, arbitrage par ID entre noeuds et entre
+ *          mailboxes d'un noeud, pas de préemption, ID en double signalé,
+ *          files pleines comptées, percentiles de latence contre un modèle
+ *          FIFO indépendant, occupation du bus.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_bus.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BIT_NS        (1000000000ULL / CAN_BAUD)
+#define FUZZ_FRAMES   20000U
+#define PCT_FRAMES    1000U
+
+static uint32_t s_seed = 25U;
+
+/* ---------- Codeur de référence ---------- */
+typedef struct {
+	uint8_t  b[160];
+	uint32_t n;
+} bits_t;
+
+static void put(bits_t *v, uint32_t x, uint32_t n)
+{
+	while (n-- > 0U) {
+		v->b[v->n++] = (uint8_t)((x >> n) & 1U);
+	}
+}
+
+/* Reste de la division de m(x).x^15 par x^15+x^14+x^10+x^8+x^7+x^4+x^3+1 */
+static uint16_t crc15_div(const bits_t *m)
+{
+	uint8_t r[160 + 15];
+
+	memcpy(r, m->b, m->n);
+	memset(&r[m->n], 0, 15U);
+	for (uint32_t i = 0U; i < m->n; i++) {
+		if (r[i] != 0U) {
+			for (uint32_t k = 0U; k <= 15U; k++) {
+				r[i + k] ^= (uint8_t)((0xC599U >> (15U - k)) & 1U);
+			}
+		}
+	}
+	uint16_t crc = 0U;
+	for (uint32_t k = 0U; k < 15U; k++) {
+		crc = (uint16_t)((crc << 1) | r[m->n + k]);
+	}
+	return crc;
+}
+
+/* Bits sur le fil, SOF..EOF + intermission ; *stuff : bits de bourrage */
+static uint32_t ref_frame_bits(const can_frame_t *f, uint32_t *stuff)
+{
+	bits_t   v = { .n = 0U };
+	uint8_t  last = 2U;
+	uint32_t run = 0U, out = 0U;
+
+	put(&v, 0U, 1U);
+	put(&v, f->id & 0x7FFU, 11U);
+	put(&v, 0U, 3U);
+	put(&v, f->dlc & 0xFU, 4U);
+	for (uint8_t i = 0U; i < ((f->dlc > 8U) ? 8U : f->dlc); i++) {
+		put(&v, f->data[i], 8U);
+	}
+	put(&v, crc15_div(&v), 15U);
+
+	*stuff = 0U;
+	for (uint32_t i = 0U; i < v.n; i++) {
+		out++;
+		run  = (v.b[i] == last) ? run + 1U : 1U;
+		last = v.b[i];
+		if (run == 5U) {
+			out++;
+			(*stuff)++;
+			last = (uint8_t)!last;                     /* le bit inséré ouvre la série suivante */
+			run  = 1U;
+		}
+	}
+	return out + 1U + 2U + 7U + CANBUS_IFS_BITS;
+}
+
+static can_frame_t mk(uint32_t id, uint8_t dlc, uint8_t fill)
+{
+	can_frame_t f;
+	f.id  = id;
+	f.dlc = dlc;
+	memset(f.data, fill, sizeof(f.data));
+	return f;
+}
+
+/* Fin d'EOF d'une trame démarrée à start_ns */
+static uint64_t eof_ns(const can_frame_t *f, uint64_t start_ns)
+{
+	return start_ns + (uint64_t)(CanBus_FrameBits(f, NULL) - CANBUS_IFS_BITS) * BIT_NS;
+}
+
+static void check_frame_bits(void)
+{
+	can_frame_t f;
+	uint32_t    st, ref_st, max_st = 0U;
+
+	/* Sans bourrage possible : 44 + 8 * DLC bits + IFS */
+	f = mk(0x555U, 0U, 0U);
+	CHECK_EQ(ref_frame_bits(&f, &ref_st) - ref_st, 44U + CANBUS_IFS_BITS);
+	for (uint8_t d = 0U; d <= 8U; d++) {
+		f = mk(0x2AAU, d, 0x55U);
+		CHECK_EQ(CanBus_FrameBits(&f, &st) - st, 44U + 8U * d + CANBUS_IFS_BITS);
+	}
+
+	/* Aléatoire, plus les motifs les plus bourrés (zéros / uns), DLC 9..15 compris */
+	for (uint32_t i = 0U; i < FUZZ_FRAMES; i++) {
+		f.id  = test_rnd(&s_seed) & 0x7FFU;
+		f.dlc = (uint8_t)(test_rnd(&s_seed) % 16U);
+		for (size_t k = 0U; k < sizeof(f.data); k++) {
+			uint32_t x = test_rnd(&s_seed);
+			f.data[k]  = (i % 3U == 0U) ? (uint8_t)x : ((x & 1U) ? 0xFFU : 0x00U);
+		}
+		if (i % 7U == 0U) {
+			f.id = (i & 8U) ? 0x7FFU : 0x000U;
+		}
+		uint32_t bits = CanBus_FrameBits(&f, &st);
+		CHECK_EQ(bits, ref_frame_bits(&f, &ref_st));
+		CHECK_EQ(st, ref_st);
+		uint8_t d = (f.dlc > 8U) ? 8U : f.dlc;
+		CHECK(st <= (34U + 8U * d - 1U) / 4U);                       /* borne de bourrage au pire */
+		max_st = (st > max_st) ? st : max_st;
+		CHECK(CanBus_FrameBits(&f, NULL) == bits);
+	}
+	CHECK(max_st >= 16U);                                            /* données uniformes : 1 bit inséré tous les 4 */
+}
+
+/* Un noeud, bus libre : fin d'EOF exacte, trames enchaînées à IFS près */
+static void check_timing(void)
+{
+	canbus_stats_t      bs;
+	canbus_node_stats_t ns;
+	can_frame_t         a = mk(CANP_ID(CANP_FN_TELEM, 1U), 8U, 0xA5U);
+	can_frame_t         b = mk(CANP_ID(CANP_FN_TELEM, 1U), 3U, 0x00U);
+
+	CHECK(!CanBus_SimInit(0U));
+	CHECK(!CanBus_SimInit(CANBUS_NODES_MAX + 1U));
+	CHECK(CanBus_SimInit(1U));
+	CHECK(!CanBus_SimSend(1U, CANTX_PRIO_TELEM, &a, 0U));           /* noeud hors bus */
+	CHECK(!CanBus_SimSend(0U, CANTX_PRIO_COUNT, &a, 0U));
+
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_TELEM, &a, 100U));
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_TELEM, &b, 100U));
+	CanBus_SimRunUntil(100U);                                        /* rien ne démarre avant t */
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.frames, 0);
+	CanBus_SimRunUntil(10000U);
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.frames, 2);
+	uint64_t end_a = eof_ns(&a, 100000U);
+	uint64_t end_b = eof_ns(&b, end_a + CANBUS_IFS_BITS * BIT_NS);
+	CHECK_EQ(bs.now_us, (end_b + CANBUS_IFS_BITS * BIT_NS) / 1000U);
+	CHECK_EQ(bs.busy_bits, CanBus_FrameBits(&a, NULL) + CanBus_FrameBits(&b, NULL));
+	CanBus_SimGetNodeStats(0U, &ns);
+	CHECK_EQ(ns.sent, 2);
+	CHECK_EQ(ns.lat_max_us, (end_b - 100000U) / 1000U);
+	CHECK_EQ(ns.hiwater, 2);
+	CanBus_SimGetNodeStats(1U, &ns);
+	CHECK_EQ(ns.sent, 0);
+}
+
+/* Noeuds prêts ensemble : ID croissants ; trame prête pendant une trame : pas de préemption */
+static void check_arbitration(void)
+{
+	enum { NODES = 16 };
+	canbus_stats_t      bs;
+	canbus_node_stats_t ns;
+	uint16_t            ids[NODES], order[NODES];
+	can_frame_t         f[NODES];
+
+	CHECK(CanBus_SimInit(NODES));
+	for (uint16_t i = 0U; i < NODES; i++) {
+		bool dup;
+		do {
+			ids[i] = (uint16_t)(1U + test_rnd(&s_seed) % 0x7FFU);
+			dup    = false;
+			for (uint16_t k = 0U; k < i; k++) {
+				dup = dup || ids[k] == ids[i];
+			}
+		} while (dup);
+		f[i] = mk(ids[i], (uint8_t)(test_rnd(&s_seed) % 9U), (uint8_t)test_rnd(&s_seed));
+		CHECK(CanBus_SimSend(i, CANTX_PRIO_TELEM, &f[i], 0U));
+	}
+	for (uint16_t i = 0U; i < NODES; i++) {                          /* tri par ID (insertion) */
+		uint16_t k = i;
+		for (; k > 0U && ids[order[k - 1U]] > ids[i]; k--) {
+			order[k] = order[k - 1U];
+		}
+		order[k] = i;
+	}
+
+	/* Alarme d'ID 0 sur le noeud du plus grand ID, 1 us après le SOF de la première trame */
+	uint16_t    late = order[NODES - 1U];
+	can_frame_t a0   = mk(0U, 2U, 0x00U);
+	CanBus_SimRunUntil(1U);
+	CHECK(CanBus_SimSend(late, CANTX_PRIO_ALARM, &a0, 1U));
+	CanBus_SimRunUntil(1000000U);
+
+	/* Trame en vol, puis l'alarme (mailbox d'ID le plus bas du noeud), puis les ID croissants */
+	uint64_t t = eof_ns(&f[order[0]], 0U);
+	CanBus_SimGetNodeStats(order[0], &ns);
+	CHECK_EQ(ns.lat_max_us, t / 1000U);
+	t = eof_ns(&a0, t + CANBUS_IFS_BITS * BIT_NS);
+	CanBus_SimGetNodeStats(late, &ns);
+	CHECK_EQ(ns.alarm_max_us, (t - 1000U) / 1000U);
+	for (uint16_t r = 1U; r < NODES; r++) {
+		t = eof_ns(&f[order[r]], t + CANBUS_IFS_BITS * BIT_NS);
+		CanBus_SimGetNodeStats(order[r], &ns);
+		CHECK_EQ(ns.lat_max_us, t / 1000U);
+	}
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.frames, NODES + 1U);
+	CHECK_EQ(bs.id_clashes, 0);
+	CHECK_EQ(bs.now_us, (t + CANBUS_IFS_BITS * BIT_NS) / 1000U);
+
+	/* Noeud seul : mailbox d'ID le plus bas, alarme avant télémétrie avant export */
+	can_frame_t al = mk(CANP_ID(CANP_FN_ALARM, 9U), 5U, 0U);
+	can_frame_t te = mk(CANP_ID(CANP_FN_TELEM, 9U), 8U, 0U);
+	can_frame_t bk = mk(CANP_ID(CANP_FN_XFER_TX, 9U), 8U, 0U);
+	CHECK(CanBus_SimInit(2U));
+	CHECK(CanBus_SimSend(1U, CANTX_PRIO_TELEM, &al, 0U));            /* bus occupé par le noeud 1 */
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_BULK, &bk, 1U));
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_TELEM, &te, 1U));
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_ALARM, &al, 1U));
+	CanBus_SimRunUntil(1000000U);
+	uint64_t t1 = eof_ns(&al, 0U) + CANBUS_IFS_BITS * BIT_NS;
+	uint64_t t2 = eof_ns(&al, t1) + CANBUS_IFS_BITS * BIT_NS;
+	uint64_t t3 = eof_ns(&te, t2) + CANBUS_IFS_BITS * BIT_NS;
+	uint64_t t4 = eof_ns(&bk, t3);
+	CanBus_SimGetNodeStats(0U, &ns);
+	CHECK_EQ(ns.alarm_max_us, (t2 - CANBUS_IFS_BITS * BIT_NS - 1000U) / 1000U);
+	CHECK_EQ(ns.lat_max_us, (t4 - 1000U) / 1000U);
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.id_clashes, 0);
+
+	/* Même ID sur deux noeuds : signalé, les deux trames passent */
+	CHECK(CanBus_SimInit(2U));
+	CHECK(CanBus_SimSend(0U, CANTX_PRIO_TELEM, &te, 0U));
+	CHECK(CanBus_SimSend(1U, CANTX_PRIO_TELEM, &te, 0U));
+	CanBus_SimRunUntil(1000000U);
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.id_clashes, 1);
+	CHECK_EQ(bs.frames, 2);
+}
+
+/* Files pleines : refus compté par classe, rien d'autre perdu */
+static void check_overflow(void)
+{
+	static const uint8_t cap[CANTX_PRIO_COUNT] = { CANTX_Q_ALARM, CANTX_Q_TELEM, CANTX_Q_BULK };
+	canbus_node_stats_t  ns;
+	can_frame_t          f = mk(CANP_ID(CANP_FN_TELEM, 3U), 8U, 0x11U);
+
+	CHECK(CanBus_SimInit(1U));
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		for (uint8_t i = 0U; i < cap[p] + 2U; i++) {
+			CHECK_EQ(CanBus_SimSend(0U, (cantx_prio_t)p, &f, 0U), i < cap[p]);
+		}
+	}
+	CanBus_SimRunUntil(1000000U);
+	CanBus_SimGetNodeStats(0U, &ns);
+	CHECK_EQ(ns.sent, CANTX_Q_ALARM + CANTX_Q_TELEM + CANTX_Q_BULK);
+	CHECK_EQ(ns.lost, 3U * 2U);
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		CHECK_EQ(ns.lost_cls[p], 2);
+	}
+	CHECK_EQ(ns.hiwater, CANTX_Q_ALARM + CANTX_Q_TELEM + CANTX_Q_BULK);
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+	return (x > y) - (x < y);
+}
+
+/* Percentile de rang r (1..n) tel que rendu : borne haute de sa classe, plafonnée au max */
+static uint32_t pct(const uint64_t *lat, uint32_t n, uint32_t r)
+{
+	uint32_t edge = (uint32_t)(lat[r - 1U] / CANBUS_HIST_US + 1U) * CANBUS_HIST_US;
+	return (edge > lat[n - 1U]) ? (uint32_t)lat[n - 1U] : edge;
+}
+
+/* Rafales aléatoires sur un noeud seul : latences du modèle FIFO, histogramme relu */
+static void check_percentiles(void)
+{
+	static uint64_t     lat[PCT_FRAMES];
+	canbus_stats_t      bs;
+	canbus_node_stats_t ns;
+	uint64_t            t_us = 0U, free_ns = 0U, busy = 0U;
+	uint32_t            n = 0U;
+
+	CHECK(CanBus_SimInit(1U));
+	while (n < PCT_FRAMES) {
+		uint32_t burst = 1U + test_rnd(&s_seed) % CANTX_Q_TELEM;
+		t_us += 4500U + test_rnd(&s_seed) % 6000U;                   /* rafale précédente écoulée (8 trames < 4,5 ms) */
+		CanBus_SimRunUntil(t_us);
+		for (uint32_t k = 0U; k < burst && n < PCT_FRAMES; k++, n++) {
+			can_frame_t f = mk(CANP_ID(CANP_FN_TELEM, 4U), (uint8_t)(test_rnd(&s_seed) % 9U), (uint8_t)test_rnd(&s_seed));
+			uint64_t    start = (t_us * 1000U > free_ns) ? t_us * 1000U : free_ns;
+			uint64_t    end   = eof_ns(&f, start);
+			CHECK(CanBus_SimSend(0U, CANTX_PRIO_TELEM, &f, t_us));
+			lat[n]  = (end - t_us * 1000U) / 1000U;
+			free_ns = end + CANBUS_IFS_BITS * BIT_NS;
+			busy   += CanBus_FrameBits(&f, NULL);
+		}
+	}
+	CanBus_SimRunUntil(t_us + 1000000U);
+	CanBus_SimGetNodeStats(0U, &ns);
+	qsort(lat, n, sizeof(lat[0]), cmp_u64);
+	CHECK_EQ(ns.sent, n);
+	CHECK_EQ(ns.lat_max_us, lat[n - 1U]);
+	CHECK_EQ(ns.lat_p50_us, pct(lat, n, (n + 1U) / 2U));
+	CHECK_EQ(ns.lat_p90_us, pct(lat, n, n - n / 10U));
+	CHECK_EQ(ns.lat_p99_us, pct(lat, n, n - n / 100U));
+	CHECK(ns.lat_p50_us <= ns.lat_p90_us && ns.lat_p90_us <= ns.lat_p99_us && ns.lat_p99_us <= ns.lat_max_us);
+	printf("latences : p50 %u us, p90 %u us, p99 %u us, max %u us\n",
+	       ns.lat_p50_us, ns.lat_p90_us, ns.lat_p99_us, ns.lat_max_us);
+
+	/* Occupation : bits émis sur le temps écoulé */
+	CanBus_SimGetStats(&bs);
+	CHECK_EQ(bs.busy_bits, busy);
+	CHECK_EQ(bs.util_pm, busy * BIT_NS * 1000U / ((t_us + 1000000U) * 1000U));
+}
+
+/* Bus saturé : occupation ~100 %, alarmes toujours servies à la trame suivante */
+static void check_saturated(void)
+{
+	enum { NODES = 8 };
+	canbus_stats_t      bs;
+	canbus_node_stats_t ns;
+	uint32_t            alarm_max = 0U, lost = 0U;
+	uint32_t            worst = 0U;
+
+	CHECK(CanBus_SimInit(NODES));
+	for (uint32_t ms = 0U; ms < 2000U; ms++) {
+		CanBus_SimRunUntil((uint64_t)ms * 1000U);
+		for (uint16_t i = 0U; i < NODES; i++) {
+			can_frame_t f = mk(CANP_ID(CANP_FN_TELEM, i + 1U), 8U, 0xFFU);
+			(void)CanBus_SimSend(i, CANTX_PRIO_TELEM, &f, (uint64_t)ms * 1000U);
+			if (test_rnd(&s_seed) % 200U == 0U) {
+				f.id = CANP_ID(CANP_FN_ALARM, i + 1U);
+				CHECK(CanBus_SimSend(i, CANTX_PRIO_ALARM, &f, (uint64_t)ms * 1000U));
+			}
+		}
+	}
+	CanBus_SimRunUntil(2000000U);
+	CanBus_SimGetStats(&bs);
+	for (uint16_t i = 0U; i < NODES; i++) {
+		CanBus_SimGetNodeStats(i, &ns);
+		alarm_max = (ns.alarm_max_us > alarm_max) ? ns.alarm_max_us : alarm_max;
+		lost     += ns.lost;
+	}
+	can_frame_t w = mk(0x7FFU, 8U, 0xFFU);
+	worst = (uint32_t)(CanBus_FrameBits(&w, NULL) * BIT_NS / 1000U);
+	printf("bus saturé : occupation %u‰, %u trames, %u perdues, alarme max %u us\n",
+	       bs.util_pm, bs.frames, lost, alarm_max);
+	CHECK(bs.util_pm >= 990U);
+	CHECK(lost > 0U);
+	CHECK(bs.stuff_bits > 0U);
+	CHECK(alarm_max <= (NODES + 1U) * worst);                       /* trame en vol + alarmes des autres noeuds */
+}
+
+int main(void)
+{
+	check_frame_bits();
+	check_timing();
+	check_arbitration();
+	check_overflow();
+	check_percentiles();
+	check_saturated();
+	TEST_END();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file    test_can_filter.c
+ * @brief   Filtres d'acceptation bxCAN générés depuis la table des ID consommés :
+ *          sur les 2048 ID standard, seuls ceux de la table passent, chacun dans
+ *          la FIFO de son urgence ; registres FR1 / FR2 relus via les champs HAL
+ *          comme les compare le matériel ; tables aléatoires (regroupement en
+ *          masque exact), débordements, injection à travers can_rx.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_proto.h"
+#include "can_rx.h"
+
+#define STD_IDS       2048U
+#define RTR_BIT       0x0010U      /* image 16 bits : STDID[15:5] RTR[4] IDE[3] */
+#define RAND_TABLES   500U
+
+static uint32_t s_seed = 22U;
+
+/* FIFO attendue pour id d'après la table, -1 si l'ID n'est pas consommé */
+static int expected_fifo(const canp_rx_id_t *rows, size_t n, uint32_t id)
+{
+	for (size_t i = 0U; i < n; i++) {
+		if (CANP_ID(rows[i].fn, rows[i].node) == id) {
+			return rows[i].fifo;
+		}
+	}
+	return -1;
+}
+
+/* Comparaison du matériel (RM0090, échelle 16 bits) à partir des champs HAL rangés en
+ * FR1 = MaskIdLow << 16 | IdLow et FR2 = MaskIdHigh << 16 | IdHigh
+ */
+static bool hw_match(const canp_filter_t *b, uint16_t img)
+{
+	canp_filter_hal_t h;
+
+	CanProto_FilterHal(b, &h);
+	CHECK_EQ(((uint32_t)h.mask_low << 16) | h.id_low, b->fr1);
+	CHECK_EQ(((uint32_t)h.mask_high << 16) | h.id_high, b->fr2);
+	if (b->list) {
+		return img == h.id_low || img == h.mask_low || img == h.id_high || img == h.mask_high;
+	}
+	return ((img ^ h.id_low) & h.mask_low) == 0U || ((img ^ h.id_high) & h.mask_high) == 0U;
+}
+
+/* Ensemble accepté = ensemble de la table, FIFO comprise ; trames distantes jamais acceptées */
+static void check_accept_set(const canp_rx_id_t *rows, size_t n, const canp_filter_t *banks, size_t nb)
+{
+	for (uint32_t id = 0U; id < STD_IDS; id++) {
+		int     want = expected_fifo(rows, n, id);
+		uint8_t fifo = 0xFFU;
+		bool    hit  = CanProto_FilterMatch(banks, nb, id, &fifo);
+		int     hw   = -1;
+
+		CHECK_EQ(hit, want >= 0);
+		if (hit) {
+			CHECK_EQ(fifo, want);
+		}
+		for (size_t i = 0U; i < nb && hw < 0; i++) {            /* premier banc touché, comme le FMI */
+			if (hw_match(&banks[i], (uint16_t)(id << 5))) {
+				hw = banks[i].fifo;
+			}
+			CHECK(!hw_match(&banks[i], (uint16_t)((id << 5) | RTR_BIT)));
+		}
+		CHECK_EQ(hw, want);
+	}
+}
+
+static void check_default_table(void)
+{
+	const canp_rx_id_t *rows;
+	canp_filter_t       banks[CANP_FILTER_BANKS_MAX];
+	size_t              n  = CanProto_RxTable(&rows);
+	size_t              nb = CanProto_FilterBuild(banks, CANP_FILTER_BANKS_MAX);
+
+	CHECK(n > 0U);
+	CHECK(nb > 0U && nb <= (n + 3U) / 4U + 2U);                      /* au pire une liste pleine par FIFO */
+	CHECK_EQ(expected_fifo(rows, n, CANP_ID(CANP_FN_CMD, NODE_ID)), CANP_RX_FIFO_URGENT);
+	CHECK_EQ(expected_fifo(rows, n, CANP_ID(CANP_FN_CFG, NODE_ID)), CANP_RX_FIFO_NORMAL);
+	CHECK_EQ(expected_fifo(rows, n, CANP_ID(CANP_FN_TELEM, NODE_ID)), -1);   /* nos propres émissions */
+	check_accept_set(rows, n, banks, nb);
+
+	/* Table par défaut sur un banc de moins que nécessaire : refusée, pas tronquée */
+	CHECK_EQ(CanProto_FilterBuild(banks, nb - 1U), 0);
+}
+
+/* Quatre ID qui ne diffèrent que de deux bits : un seul motif masqué, rien de plus */
+static void check_merge(void)
+{
+	static const canp_rx_id_t rows[] = {
+		{ 0x6U, 0x10U, CANP_RX_FIFO_NORMAL },
+		{ 0x6U, 0x11U, CANP_RX_FIFO_NORMAL },
+		{ 0x6U, 0x14U, CANP_RX_FIFO_NORMAL },
+		{ 0x6U, 0x15U, CANP_RX_FIFO_NORMAL },
+		{ 0x6U, 0x15U, CANP_RX_FIFO_NORMAL },                       /* doublon ignoré */
+	};
+	canp_filter_t banks[CANP_FILTER_BANKS_MAX];
+	size_t        nb = CanProto_FilterBuildFrom(rows, 5U, banks, CANP_FILTER_BANKS_MAX);
+
+	CHECK_EQ(nb, 1);
+	CHECK(!banks[0].list);
+	CHECK_EQ(banks[0].fifo, CANP_RX_FIFO_NORMAL);
+	check_accept_set(rows, 5U, banks, nb);
+
+	/* Trois ID seulement : pas de masque qui en accepterait un quatrième */
+	nb = CanProto_FilterBuildFrom(rows, 3U, banks, CANP_FILTER_BANKS_MAX);
+	CHECK_EQ(nb, 1);
+	CHECK(banks[0].list);
+	check_accept_set(rows, 3U, banks, nb);
+}
+
+/* Tables aléatoires : ID proches (regroupables) ou quelconques, deux FIFO */
+static void check_random(void)
+{
+	canp_rx_id_t  rows[CANP_RX_IDS_MAX + 1U];
+	canp_filter_t banks[CANP_FILTER_BANKS_MAX];
+	uint32_t      total_banks = 0U, mask_banks = 0U;
+
+	for (uint32_t t = 0U; t < RAND_TABLES; t++) {
+		size_t  n    = 1U + test_rnd(&s_seed) % CANP_RX_IDS_MAX;
+		uint8_t base = (uint8_t)(test_rnd(&s_seed) & 0x7FU);
+		bool    near = (t % 2U) == 0U;
+
+		for (size_t i = 0U; i < n; i++) {
+			rows[i].fn   = (uint8_t)(near ? (0x6U + test_rnd(&s_seed) % 2U) : test_rnd(&s_seed) % 16U);
+			rows[i].node = (uint8_t)(near ? (base ^ (test_rnd(&s_seed) & 0x0FU)) : test_rnd(&s_seed) & 0x7FU);
+			rows[i].fifo = (uint8_t)(test_rnd(&s_seed) % 2U);
+			int prev = expected_fifo(rows, i, CANP_ID(rows[i].fn, rows[i].node));
+			if (prev >= 0) {
+				rows[i].fifo = (uint8_t)prev;                     /* un ID, une seule FIFO */
+			}
+		}
+		size_t nb = CanProto_FilterBuildFrom(rows, n, banks, CANP_FILTER_BANKS_MAX);
+		CHECK(nb > 0U && nb <= (n + 3U) / 4U + 2U);
+		check_accept_set(rows, n, banks, nb);
+		total_banks += (uint32_t)nb;
+		for (size_t i = 0U; i < nb; i++) {
+			mask_banks += banks[i].list ? 0U : 1U;
+		}
+	}
+	printf("%u tables aléatoires : %u bancs dont %u en masque\n", RAND_TABLES, total_banks, mask_banks);
+	CHECK(mask_banks > 0U);
+
+	/* Table trop longue pour les tables de travail : refusée */
+	for (size_t i = 0U; i <= CANP_RX_IDS_MAX; i++) {
+		rows[i].fn   = (uint8_t)(i % 16U);
+		rows[i].node = (uint8_t)(i * 3U);
+		rows[i].fifo = CANP_RX_FIFO_NORMAL;
+	}
+	CHECK_EQ(CanProto_FilterBuildFrom(rows, CANP_RX_IDS_MAX + 1U, banks, CANP_FILTER_BANKS_MAX), 0);
+}
+
+/* can_rx : bancs programmés à l'init, trames hors table écartées sans IT, FIFO urgente servie d'abord */
+static void check_can_rx(void)
+{
+	const canp_rx_id_t *rows;
+	canrx_stats_t       st;
+	canp_filter_t       banks[CANP_FILTER_BANKS_MAX];
+	can_frame_t         f = { 0 };
+	size_t              n = CanProto_RxTable(&rows);
+	uint32_t            accepted = 0U;
+
+	CHECK_EQ(CanRx_Init(), SCN_OK);
+	CanRx_GetStats(&st);
+	CHECK_EQ(st.banks, CanProto_FilterBuild(banks, CANP_FILTER_BANKS_MAX));
+
+	for (uint32_t id = 0U; id < STD_IDS; id++) {
+		can_frame_t g;
+		int         want = expected_fifo(rows, n, id);
+		f.id  = id;
+		f.dlc = 1U;
+		CHECK_EQ(CanRx_SimInject(&f), want >= 0);
+		if (want >= 0) {
+			accepted++;
+			CHECK(CanRx_Get(&g));
+			CHECK_EQ(g.id, id);
+		}
+		CHECK(!CanRx_Get(&g));
+	}
+	CHECK_EQ(accepted, n);
+	CHECK_EQ(CanRx_SimRejected(), STD_IDS - n);
+
+	/* Commande arrivée après une configuration : lue la première */
+	can_frame_t g;
+	f.id = CANP_ID(CANP_FN_CFG, NODE_ID);
+	CHECK(CanRx_SimInject(&f));
+	f.id = CANP_ID(CANP_FN_CMD, CANP_NODE_BCAST);
+	CHECK(CanRx_SimInject(&f));
+	CHECK(CanRx_Get(&g));
+	CHECK_EQ(g.id, CANP_ID(CANP_FN_CMD, CANP_NODE_BCAST));
+	CHECK(CanRx_Get(&g));
+	CHECK_EQ(g.id, CANP_ID(CANP_FN_CFG, NODE_ID));
+	CanRx_GetStats(&st);
+	CHECK_EQ(st.rx[CANP_RX_FIFO_URGENT] + st.rx[CANP_RX_FIFO_NORMAL], n + 2U);
+	CHECK_EQ(st.overruns[CANP_RX_FIFO_URGENT] + st.overruns[CANP_RX_FIFO_NORMAL], 0);
+}
+
+int main(void)
+{
+	check_default_table();
+	check_merge();
+	check_random();
+	check_can_rx();
+	TEST_END();
+}
@@ -0,0 +1,324 @@
+/**
+ * @file    test_can_tlv.c
+ * @brief   TLV d'état sur CAN : aller-retour exact PackTlv / UnpackTlv sur des
+ *          états et sélections aléatoires, nombre de trames minimal, champs
+ *          inchangés non réémis, bandes mortes tenues côté récepteur, champs en
+ *          trop reportés ; lecture en place (TlvNext) de trames quelconques,
+ *          tronquées ou d'id inconnu.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_proto.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define FUZZ_ROUNDS    20000U
+#define TRACE_STEPS    20000U
+#define FRAMES_MAX     CANP_TLV_COUNT     /* un TLV par trame au pire */
+
+static const uint8_t k_ids[CANP_TLV_COUNT] = {
+	TELEM_TLV_TEMP, TELEM_TLV_HUM, TELEM_TLV_TMCU, TELEM_TLV_VIN, TELEM_TLV_DOOR, TELEM_TLV_FLAGS,
+	CANP_TLV_THIGH, CANP_TLV_TLOW, CANP_TLV_HYST,
+};
+
+static uint32_t s_seed = 23U;
+
+/* Valeur du champ id, dans l'unité et le signe du TLV */
+static int32_t field(const canp_state_t *s, uint8_t id)
+{
+	switch (id) {
+	case TELEM_TLV_TEMP:  return s->t.t_cC;
+	case TELEM_TLV_HUM:   return s->t.rh_pm;
+	case TELEM_TLV_TMCU:  return s->t.tmcu_cC;
+	case TELEM_TLV_VIN:   return s->t.vin_mV;
+	case TELEM_TLV_DOOR:  return s->t.door;
+	case TELEM_TLV_FLAGS: return s->t.flags;
+	case CANP_TLV_THIGH:  return s->thigh_cC;
+	case CANP_TLV_TLOW:   return s->tlow_cC;
+	default:              return s->hyst_cC;
+	}
+}
+
+static bool same_state(const canp_state_t *a, const canp_state_t *b)
+{
+	for (size_t i = 0U; i < CANP_TLV_COUNT; i++) {
+		if (field(a, k_ids[i]) != field(b, k_ids[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void rnd_state(canp_state_t *s)
+{
+	memset(s, 0, sizeof(*s));
+	s->t.t_cC    = (int16_t)test_rnd(&s_seed);
+	s->t.rh_pm   = (uint16_t)test_rnd(&s_seed);
+	s->t.tmcu_cC = (int16_t)test_rnd(&s_seed);
+	s->t.vin_mV  = (uint16_t)test_rnd(&s_seed);
+	s->t.door    = (uint8_t)(test_rnd(&s_seed) & 1U);
+	s->t.flags   = (uint8_t)test_rnd(&s_seed);
+	s->thigh_cC  = (int16_t)test_rnd(&s_seed);
+	s->tlow_cC   = (int16_t)test_rnd(&s_seed);
+	s->hyst_cC   = (int16_t)test_rnd(&s_seed);
+}
+
+/* Optimum du rangement de n3 TLV de 3 octets et n2 de 2 dans des trames de 8 :
+ * une trame porte 2 + 1, 1 + 2 ou 0 + 4 de ces TLV
+ */
+static size_t opt_frames(size_t n3, size_t n2)
+{
+	for (size_t k = 0U;; k++) {
+		for (size_t d = 0U; 2U * d <= n3 && d <= k; d++) {
+			size_t s = n3 - 2U * d;
+			if (d + s <= k && d + 2U * s + 4U * (k - d - s) >= n2) {
+				return k;
+			}
+		}
+	}
+}
+
+/* Trames bien formées : ID imposé, DLC <= 8, octets au-delà du DLC à zéro */
+static void check_frames(const can_frame_t *f, size_t nf, uint32_t id)
+{
+	for (size_t k = 0U; k < nf; k++) {
+		CHECK_EQ(f[k].id, id);
+		CHECK(f[k].dlc > 0U && f[k].dlc <= 8U);
+		for (size_t i = f[k].dlc; i < sizeof(f[k].data); i++) {
+			CHECK_EQ(f[k].data[i], 0);
+		}
+	}
+}
+
+/* Décode toutes les trames dans *rx ; champs vus (un TLV par champ au plus) */
+static uint32_t unpack_all(const can_frame_t *f, size_t nf, canp_state_t *rx)
+{
+	uint32_t all = 0U;
+
+	for (size_t k = 0U; k < nf; k++) {
+		uint32_t seen;
+		CHECK(CanProto_UnpackTlv(&f[k], rx, &seen));
+		CHECK_EQ(all & seen, 0);
+		all |= seen;
+	}
+	return all;
+}
+
+/* Aller-retour : tout champ sélectionné revient exact, au plus juste en trames */
+static void fuzz_roundtrip(void)
+{
+	canp_state_t     s, rx;
+	canp_tlv_cache_t c;
+	can_frame_t      f[FRAMES_MAX];
+	uint32_t         id = CANP_ID(CANP_FN_TELEM, NODE_ID);
+
+	for (uint32_t r = 0U; r < FUZZ_ROUNDS; r++) {
+		uint32_t mask = (r == 0U) ? CANP_TLV_ALL : (test_rnd(&s_seed) & CANP_TLV_ALL);
+		size_t   n3 = 0U, n2 = 0U;
+
+		rnd_state(&s);
+		memset(&c, 0xA5, sizeof(c));
+		CanProto_TlvForget(&c);
+		memset(&rx, 0, sizeof(rx));
+		size_t nf = CanProto_PackTlv(&s, &c, mask, CANP_PACK_ALL, id, f, FRAMES_MAX);
+		for (size_t i = 0U; i < CANP_TLV_COUNT; i++) {
+			if ((mask & CANP_TLV_BIT(k_ids[i])) != 0U) {
+				n3 += (CanProto_TlvSize(k_ids[i]) == 2U) ? 1U : 0U;
+				n2 += (CanProto_TlvSize(k_ids[i]) == 1U) ? 1U : 0U;
+			}
+		}
+		CHECK_EQ(nf, opt_frames(n3, n2));
+		check_frames(f, nf, id);
+		CHECK_EQ(unpack_all(f, nf, &rx), mask);
+		CHECK_EQ(c.known, mask);
+		for (size_t i = 0U; i < CANP_TLV_COUNT; i++) {
+			if ((mask & CANP_TLV_BIT(k_ids[i])) != 0U) {
+				CHECK_EQ(field(&rx, k_ids[i]), field(&s, k_ids[i]));
+			}
+		}
+		if (r == 0U) {
+			CHECK_EQ(nf, 4);                                      /* état complet : 4 trames */
+		}
+
+		/* Rien n'a changé depuis : aucune trame */
+		CHECK_EQ(CanProto_PackTlv(&s, &c, mask, CANP_PACK_CHANGED, id, f, FRAMES_MAX), 0);
+	}
+}
+
+/* Trace lente : seuls les champs modifiés repartent, le récepteur reste le miroir de l'émetteur */
+static void check_changed(void)
+{
+	canp_state_t     s, prev, rx;
+	canp_tlv_cache_t c;
+	can_frame_t      f[FRAMES_MAX];
+	uint32_t         id = CANP_ID(CANP_FN_TELEM, NODE_ID);
+	uint32_t         frames = 0U, sets = 0U;
+
+	rnd_state(&s);
+	memset(&c, 0, sizeof(c));
+	memset(&rx, 0, sizeof(rx));
+	(void)unpack_all(f, CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_CHANGED, id, f, FRAMES_MAX), &rx);
+
+	for (uint32_t k = 0U; k < TRACE_STEPS; k++) {
+		prev = s;
+		if (test_rnd(&s_seed) % 2U == 0U) {
+			s.t.t_cC = (int16_t)(s.t.t_cC + (int16_t)(test_rnd(&s_seed) % 5U) - 2);
+		}
+		if (test_rnd(&s_seed) % 4U == 0U) {
+			s.t.rh_pm = (uint16_t)(s.t.rh_pm + 1U);
+		}
+		if (test_rnd(&s_seed) % 50U == 0U) {
+			s.t.door ^= 1U;
+		}
+		if (test_rnd(&s_seed) % 500U == 0U) {
+			s.thigh_cC = (int16_t)(s.thigh_cC + 50);
+		}
+		size_t   nf   = CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_CHANGED, id, f, FRAMES_MAX);
+		uint32_t seen = unpack_all(f, nf, &rx);
+		uint32_t diff = 0U;
+		for (size_t i = 0U; i < CANP_TLV_COUNT; i++) {
+			diff |= (field(&s, k_ids[i]) != field(&prev, k_ids[i])) ? CANP_TLV_BIT(k_ids[i]) : 0U;
+		}
+		CHECK_EQ(seen, diff);
+		CHECK(same_state(&rx, &s));
+		frames += (uint32_t)nf;
+		sets   += (nf > 0U) ? 1U : 0U;
+	}
+	printf("trace CHANGED : %u cycles, %u émis, %u trames\n", TRACE_STEPS, sets, frames);
+	CHECK(frames < 2U * TRACE_STEPS);                                 /* < télémétrie complète à chaque cycle */
+}
+
+/* Bande morte : un champ ne repart que s'il s'écarte de plus de db de la dernière valeur émise */
+static void check_deadband(void)
+{
+	canp_state_t     s, rx;
+	canp_tlv_cache_t c;
+	can_frame_t      f[FRAMES_MAX];
+	uint32_t         id = CANP_ID(CANP_FN_TELEM, NODE_ID);
+	int32_t          err_max = 0;
+
+	memset(&s, 0, sizeof(s));
+	memset(&c, 0, sizeof(c));
+	memset(&rx, 0, sizeof(rx));
+	s.t.t_cC   = 400;
+	s.t.vin_mV = 24000U;
+	c.db[0]    = CAN_DB_TEMP_cC;
+	c.db[3]    = CAN_DB_VIN_mV;
+	(void)unpack_all(f, CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_DEADBAND, id, f, FRAMES_MAX), &rx);
+
+	for (uint32_t k = 0U; k < TRACE_STEPS; k++) {
+		int32_t t0 = field(&rx, TELEM_TLV_TEMP), v0 = field(&rx, TELEM_TLV_VIN);
+		s.t.t_cC   = (int16_t)(s.t.t_cC + (int16_t)(test_rnd(&s_seed) % 7U) - 3);
+		s.t.vin_mV = (uint16_t)(s.t.vin_mV + (uint16_t)(test_rnd(&s_seed) % 41U) - 20U);
+		uint32_t seen = unpack_all(f, CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_DEADBAND, id, f, FRAMES_MAX), &rx);
+		CHECK_EQ((seen & CANP_TLV_BIT(TELEM_TLV_TEMP)) != 0U, abs(s.t.t_cC - t0) > CAN_DB_TEMP_cC);
+		CHECK_EQ((seen & CANP_TLV_BIT(TELEM_TLV_VIN)) != 0U, abs((int)s.t.vin_mV - v0) > CAN_DB_VIN_mV);
+		CHECK(abs(field(&rx, TELEM_TLV_TEMP) - s.t.t_cC) <= CAN_DB_TEMP_cC);
+		CHECK(abs(field(&rx, TELEM_TLV_VIN) - (int)s.t.vin_mV) <= CAN_DB_VIN_mV);
+		err_max = (abs(field(&rx, TELEM_TLV_TEMP) - s.t.t_cC) > err_max) ? abs(field(&rx, TELEM_TLV_TEMP) - s.t.t_cC) : err_max;
+	}
+	CHECK(err_max > 0);                                               /* la bande morte a servi */
+}
+
+/* Trames limitées : les champs en trop restent à émettre au cycle suivant */
+static void check_overflow(void)
+{
+	canp_state_t     s, rx;
+	canp_tlv_cache_t c;
+	can_frame_t      f[FRAMES_MAX];
+	uint32_t         id = CANP_ID(CANP_FN_TELEM, NODE_ID), all = 0U;
+	static const uint8_t k_dlc[4] = { 8U, 8U, 6U, 3U };              /* 3+3+2, 3+3+2, 3+3, 3 */
+
+	rnd_state(&s);
+	memset(&c, 0, sizeof(c));
+	memset(&rx, 0, sizeof(rx));
+	for (uint32_t k = 0U; k < 4U; k++) {
+		size_t nf = CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_CHANGED, id, f, 1U);
+		CHECK_EQ(nf, 1);
+		CHECK_EQ(f[0].dlc, k_dlc[k]);                                 /* la trame du cycle remplie au mieux */
+		all |= unpack_all(f, nf, &rx);
+	}
+	CHECK_EQ(all, CANP_TLV_ALL);
+	CHECK(same_state(&rx, &s));
+	CHECK_EQ(CanProto_PackTlv(&s, &c, CANP_TLV_ALL, CANP_PACK_CHANGED, id, f, 1U), 0);
+}
+
+/* Lecture en place de trames quelconques : jamais hors DLC, reconstruction identique si valide */
+static void fuzz_parse(void)
+{
+	canp_state_t s;
+	uint32_t     ok = 0U;
+
+	for (uint32_t r = 0U; r < FUZZ_ROUNDS; r++) {
+		can_frame_t    f, g;
+		size_t         pos = 0U, last = 0U;
+		uint8_t        id;
+		const uint8_t *v;
+		uint32_t       seen, ids = 0U;
+		bool           dup = false;
+
+		f.id  = 0U;
+		f.dlc = (uint8_t)(test_rnd(&s_seed) % 10U);                   /* DLC > 8 : borné à 8 */
+		for (size_t i = 0U; i < sizeof(f.data); i++) {
+			uint32_t x = test_rnd(&s_seed);
+			f.data[i] = (x & 0x100U) ? k_ids[x % CANP_TLV_COUNT] : (uint8_t)x;
+		}
+		while (CanProto_TlvNext(&f, &pos, &id, &v)) {
+			CHECK(v == &f.data[last + 1U]);                            /* pointeur dans la trame, sans copie */
+			CHECK_EQ(pos, last + 1U + CanProto_TlvSize(id));
+			CHECK(pos <= 8U && pos <= f.dlc);
+			dup   = dup || (ids & CANP_TLV_BIT(id)) != 0U;
+			ids  |= CANP_TLV_BIT(id);
+			last  = pos;
+		}
+
+		memset(&s, 0, sizeof(s));
+		bool good = CanProto_UnpackTlv(&f, &s, &seen);
+		CHECK_EQ(seen, ids);
+		CHECK_EQ(good, last == ((f.dlc > 8U) ? 8U : f.dlc));
+		if (!good || dup) {
+			continue;
+		}
+		ok++;
+		memset(&g, 0, sizeof(g));
+		for (pos = 0U; CanProto_TlvNext(&f, &pos, &id, &v);) {
+			CHECK(CanProto_TlvAppend(&g, &s, id));
+		}
+		CHECK_EQ(g.dlc, last);
+		CHECK(memcmp(g.data, f.data, last) == 0);
+	}
+	CHECK(ok > FUZZ_ROUNDS / 20U);
+
+	/* Tronquée au milieu d'une valeur, puis id inconnu : champs précédents appliqués */
+	can_frame_t f;
+	uint32_t    seen;
+	memset(&f, 0, sizeof(f));
+	rnd_state(&s);
+	CHECK(CanProto_TlvAppend(&f, &s, TELEM_TLV_DOOR));
+	CHECK(CanProto_TlvAppend(&f, &s, TELEM_TLV_TEMP));
+	CHECK(!CanProto_TlvAppend(&f, &s, 0x07U));
+	f.dlc = 4U;
+	canp_state_t rx;
+	memset(&rx, 0, sizeof(rx));
+	CHECK(!CanProto_UnpackTlv(&f, &rx, &seen));
+	CHECK_EQ(seen, CANP_TLV_BIT(TELEM_TLV_DOOR));
+	CHECK_EQ(rx.t.door, s.t.door);
+	f.data[5] = 0x07U;
+	f.dlc     = 7U;
+	CHECK(!CanProto_UnpackTlv(&f, &rx, &seen));
+	CHECK_EQ(seen, CANP_TLV_BIT(TELEM_TLV_DOOR) | CANP_TLV_BIT(TELEM_TLV_TEMP));
+	CHECK_EQ(rx.t.t_cC, s.t.t_cC);
+}
+
+int main(void)
+{
+	fuzz_roundtrip();
+	check_changed();
+	check_deadband();
+	check_overflow();
+	fuzz_parse();
+	TEST_END();
+}
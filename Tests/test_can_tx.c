@@ -0,0 +1,214 @@
+/**
+ * @file    test_can_tx.c
+ * @brief   Ordonnanceur TX sur la bxCAN simulée (3 mailboxes, arbitrage par
+ *          ID, durée de trame à CAN_BAUD) : ordre alarme > télémétrie >
+ *          export, ordre conservé dans chaque classe, durée bus, files
+ *          pleines comptées ; 10 Hz de télémétrie pendant un export continu
+ *          et un bus chargé par d'autres noeuds : aucune perte.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_tx.h"
+#include <string.h>
+
+#define RUN_MS        30000U     /* export d'une trame par STmin : < SEQ_MAX */
+#define SEQ_MAX       20000U
+
+typedef struct {
+	can_frame_t f;
+	uint64_t    t_us;
+} rx_t;
+
+static rx_t     s_rx[SEQ_MAX];
+static uint32_t s_nrx;
+static uint64_t s_t_queued[CANTX_PRIO_COUNT][SEQ_MAX];
+static uint32_t s_seed = 3U;
+
+static void sink(const can_frame_t *f, uint64_t t_end_us)
+{
+	if (s_nrx < SEQ_MAX) {
+		s_rx[s_nrx].f    = *f;
+		s_rx[s_nrx].t_us = t_end_us;
+		s_nrx++;
+	}
+}
+
+static const uint32_t k_fn[CANTX_PRIO_COUNT] = { CANP_FN_ALARM, CANP_FN_TELEM, CANP_FN_XFER_TX };
+
+/* Trame de la classe, numérotée dans data[0..1] */
+static can_frame_t mk(cantx_prio_t p, uint16_t seq, uint8_t dlc)
+{
+	can_frame_t f;
+	memset(&f, 0, sizeof(f));
+	f.id      = CANP_ID(k_fn[p], NODE_ID);
+	f.dlc     = dlc;
+	f.data[0] = (uint8_t)seq;
+	f.data[1] = (uint8_t)(seq >> 8);
+	return f;
+}
+
+static scn_err_t send(cantx_prio_t p, uint16_t seq, uint8_t dlc)
+{
+	can_frame_t f = mk(p, seq, dlc);
+	return CanTx_Send(p, &f);
+}
+
+static cantx_prio_t prio_of(const can_frame_t *f)
+{
+	uint32_t fn = f->id >> 7;
+	return (fn == CANP_FN_ALARM) ? CANTX_PRIO_ALARM : ((fn == CANP_FN_TELEM) ? CANTX_PRIO_TELEM : CANTX_PRIO_BULK);
+}
+
+static uint16_t seq_of(const can_frame_t *f)
+{
+	return (uint16_t)(f->data[0] | (f->data[1] << 8));
+}
+
+/* File remplie bus occupé : à la libération, classes dans l'ordre, ordre FIFO dans chaque classe */
+static void check_ordering(void)
+{
+	cantx_stats_t st;
+	uint16_t      n[CANTX_PRIO_COUNT] = { 5U, CANTX_Q_TELEM + 1U, CANTX_Q_BULK + 1U };   /* + 1 : en mailbox */
+	uint16_t      next[CANTX_PRIO_COUNT] = { 0U };
+
+	CHECK_EQ(CanTx_Init(), SCN_OK);
+	CanTx_ResetStats();
+	s_nrx = 0U;
+	CanTx_SimBusBusy(5000U);
+	for (int p = CANTX_PRIO_COUNT - 1; p >= 0; p--) {                 /* export d'abord, alarmes en dernier */
+		for (uint16_t i = 0U; i < n[p]; i++) {
+			CHECK_EQ(send((cantx_prio_t)p, i, 8U), SCN_OK);
+		}
+	}
+	CanTx_GetStats(&st);
+	CHECK_EQ(st.cls[CANTX_PRIO_ALARM].depth, n[0] - 1U);                /* une trame par classe en mailbox */
+	CHECK_EQ(st.cls[CANTX_PRIO_BULK].hiwater, CANTX_Q_BULK);
+	CHECK_EQ(CanTx_Free(CANTX_PRIO_BULK), 0);
+	CHECK(!CanTx_Idle());
+
+	CanTx_SimAdvance(100000U);
+	CHECK(CanTx_Idle());
+	CHECK_EQ(s_nrx, n[0] + n[1] + n[2]);
+	int last = 0;
+	for (uint32_t i = 0U; i < s_nrx; i++) {
+		cantx_prio_t p = prio_of(&s_rx[i].f);
+		CHECK((int)p >= last);                                        /* classe jamais moins urgente avant */
+		last = (int)p;
+		CHECK_EQ(seq_of(&s_rx[i].f), next[p]);
+		next[p]++;
+	}
+
+	/* Durée bus : départ à la libération, trames consécutives sans trou */
+	CHECK_EQ(s_rx[0].t_us - (CanTx_SimNowUs() - 100000U), 5000U + CanTx_SimFrameUs(8U));
+	for (uint32_t i = 1U; i < s_nrx; i++) {
+		CHECK_EQ(s_rx[i].t_us - s_rx[i - 1U].t_us, CanTx_SimFrameUs(8U));
+	}
+
+	/* Une alarme mise en file en cours d'export passe à la trame suivante */
+	s_nrx = 0U;
+	for (uint16_t i = 0U; i < CANTX_Q_BULK + 1U; i++) {
+		CHECK_EQ(send(CANTX_PRIO_BULK, i, 8U), SCN_OK);
+	}
+	CanTx_SimAdvance(CanTx_SimFrameUs(8U) / 2U);
+	CHECK_EQ(send(CANTX_PRIO_ALARM, 0U, 3U), SCN_OK);
+	CanTx_SimAdvance(100000U);
+	CHECK_EQ(s_nrx, CANTX_Q_BULK + 2U);
+	CHECK_EQ(prio_of(&s_rx[1].f), CANTX_PRIO_ALARM);
+	CHECK_EQ(s_rx[1].t_us - s_rx[0].t_us, CanTx_SimFrameUs(3U));
+
+	/* File pleine : refus compté, rien d'autre perdu */
+	CanTx_ResetStats();
+	CanTx_SimBusBusy(10000U);
+	for (uint16_t i = 0U; i < CANTX_Q_TELEM + 1U + 3U; i++) {
+		scn_err_t err = send(CANTX_PRIO_TELEM, i, 8U);
+		CHECK_EQ(err, (i < CANTX_Q_TELEM + 1U) ? SCN_OK : ERR_CAN_TX_OVR);   /* + 1 : trame en mailbox */
+	}
+	CHECK_EQ(CanTx_Free(CANTX_PRIO_TELEM), 0);
+	CanTx_GetStats(&st);
+	CHECK_EQ(st.cls[CANTX_PRIO_TELEM].drops, 3);
+	CHECK_EQ(st.cls[CANTX_PRIO_TELEM].depth, CANTX_Q_TELEM);
+	CanTx_SimAdvance(100000U);
+	CanTx_GetStats(&st);
+	CHECK_EQ(st.cls[CANTX_PRIO_TELEM].sent, CANTX_Q_TELEM + 1U);
+	CHECK_EQ(CanTx_Free(CANTX_PRIO_TELEM), CANTX_Q_TELEM);
+	can_frame_t f = mk(CANTX_PRIO_TELEM, 0U, 8U);
+	CHECK_EQ(CanTx_Send(CANTX_PRIO_COUNT, &f), ERR_CAN_TX_OVR);
+}
+
+/* task_can à 10 Hz : état en 2..3 trames, alarmes sporadiques, export au fil des places libres,
+ * bus partagé avec d'autres noeuds (~40 % de charge étrangère, prioritaire)
+ */
+static void check_10hz(void)
+{
+	cantx_stats_t st;
+	uint16_t      seq[CANTX_PRIO_COUNT] = { 0U };
+	uint16_t      next[CANTX_PRIO_COUNT] = { 0U };
+	uint64_t      lat_max[CANTX_PRIO_COUNT] = { 0U };
+
+	CHECK_EQ(CanTx_Init(), SCN_OK);
+	CanTx_ResetStats();
+	s_nrx = 0U;
+	uint64_t t0 = CanTx_SimNowUs();
+
+	for (uint32_t ms = 0U; ms < RUN_MS; ms++) {
+		uint64_t now = CanTx_SimNowUs();
+		if (test_rnd(&s_seed) % 10U < 4U) {
+			CanTx_SimBusBusy(CanTx_SimFrameUs(8U));
+		}
+		if (ms % PERIOD_CAN_MS == 0U) {
+			uint32_t k = 2U + test_rnd(&s_seed) % 2U;
+			for (uint32_t i = 0U; i < k && seq[CANTX_PRIO_TELEM] < SEQ_MAX; i++) {
+				s_t_queued[CANTX_PRIO_TELEM][seq[CANTX_PRIO_TELEM]] = now;
+				CHECK_EQ(send(CANTX_PRIO_TELEM, seq[CANTX_PRIO_TELEM]++, 8U), SCN_OK);
+			}
+		}
+		if (test_rnd(&s_seed) % 2000U == 0U && seq[CANTX_PRIO_ALARM] < SEQ_MAX) {
+			s_t_queued[CANTX_PRIO_ALARM][seq[CANTX_PRIO_ALARM]] = now;
+			CHECK_EQ(send(CANTX_PRIO_ALARM, seq[CANTX_PRIO_ALARM]++, 5U), SCN_OK);
+		}
+		if (ms % CANP_XFER_STMIN_MS == 0U && CanTx_Free(CANTX_PRIO_BULK) > 0U && seq[CANTX_PRIO_BULK] < SEQ_MAX) {
+			s_t_queued[CANTX_PRIO_BULK][seq[CANTX_PRIO_BULK]] = now;
+			CHECK_EQ(send(CANTX_PRIO_BULK, seq[CANTX_PRIO_BULK]++, 8U), SCN_OK);
+		}
+		CanTx_SimAdvance(1000U);
+
+		/* Trames acquittées : ordre de classe, latence depuis la mise en file */
+		for (uint32_t i = 0U; i < s_nrx; i++) {
+			cantx_prio_t p = prio_of(&s_rx[i].f);
+			uint16_t     q = seq_of(&s_rx[i].f);
+			CHECK_EQ(q, next[p]);
+			next[p] = (uint16_t)(q + 1U);
+			uint64_t lat = s_rx[i].t_us - s_t_queued[p][q];
+			lat_max[p]   = (lat > lat_max[p]) ? lat : lat_max[p];
+		}
+		s_nrx = 0U;
+	}
+	CanTx_SimAdvance(1000000U);
+	CHECK(CanTx_Idle());
+
+	CanTx_GetStats(&st);
+	printf("10 Hz sur %u s : télémétrie %u trames (latence max %u us), alarmes %u (%u us), export %u (%u us)\n",
+	       RUN_MS / 1000U, st.cls[CANTX_PRIO_TELEM].sent, (unsigned)lat_max[CANTX_PRIO_TELEM],
+	       st.cls[CANTX_PRIO_ALARM].sent, (unsigned)lat_max[CANTX_PRIO_ALARM],
+	       st.cls[CANTX_PRIO_BULK].sent, (unsigned)lat_max[CANTX_PRIO_BULK]);
+	for (uint8_t p = 0U; p < CANTX_PRIO_COUNT; p++) {
+		CHECK_EQ(st.cls[p].drops, 0);
+		CHECK_EQ(st.cls[p].sent, st.cls[p].queued);
+		CHECK_EQ(st.cls[p].queued, seq[p]);
+	}
+	CHECK(seq[CANTX_PRIO_ALARM] > 0U);
+	CHECK(lat_max[CANTX_PRIO_TELEM] < PERIOD_CAN_MS * 1000U);        /* état publié avant le cycle suivant */
+	CHECK(lat_max[CANTX_PRIO_ALARM] < 5000U);
+	CHECK(CanTx_SimNowUs() - t0 > (uint64_t)RUN_MS * 1000U);
+}
+
+int main(void)
+{
+	CanTx_SimSetSink(sink);
+	check_ordering();
+	check_10hz();
+	TEST_END();
+}
@@ -0,0 +1,291 @@
+/**
+ * @file    test_can_xfer.c
+ * @brief   Transfert segmenté CAN (SF/FF/CF/FC) en boucle locale : messages de
+ *          toutes tailles, BS / STmin respectés, CF perdue et FC absente.
+ *          Export du journal sur le bus virtuel (can_bus) face à une gateway
+ *          qui renvoie ses FC : journal reconstitué à l'identique, débit
+ *          soutenu mesuré, latence de la télémétrie des autres noeuds tenue
+ *          (au plus une trame de transfert en plus qu'à bus sans export).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "can_proto.h"
+#include "can_bus.h"
+#include "logger.h"
+#include "fram_spi.h"
+#include <string.h>
+
+#define XF_SAMPLES      5000U
+#define XF_TELEM_NODES  12U         /* noeuds de télémétrie : bus 2.., NodeID 2.. */
+#define XF_RUN_MAX_MS   600000U
+#define XF_FRAME_US     ((160U * 1000000U) / CAN_BAUD)   /* trame 8 octets, bourrage pire cas compris */
+
+static uint8_t     s_msg[CANP_XFER_MAX_LEN];
+static uint8_t     s_buf[CANP_XFER_MAX_LEN];
+static log_entry_t s_ref[XF_SAMPLES];
+static uint32_t    s_seed = 11U;
+
+/* ---------- Boucle locale ---------- */
+
+/* Un message de len octets : émetteur et récepteur branchés directement, horloge ms virtuelle */
+static void loop_one(size_t len)
+{
+	canp_tx_t   tx;
+	canp_rx_t   rx;
+	can_frame_t f, fc;
+	bool        send_fc;
+	uint32_t    now = 1000U, last_cf = 0U, cfs = 0U, blk = 0U;
+
+	for (size_t i = 0U; i < len; i++) {
+		s_msg[i] = (uint8_t)test_rnd(&s_seed);
+	}
+	memset(s_buf, 0, sizeof(s_buf));
+	CanProto_RxBegin(&rx, CANP_ID(CANP_FN_XFER_RX, NODE_ID), s_buf, sizeof(s_buf));
+	CHECK(CanProto_XferBegin(&tx, CANP_ID(CANP_FN_XFER_TX, NODE_ID), s_msg, len, now));
+
+	while (tx.state != CANP_X_DONE && tx.state != CANP_X_ABORT && now < 100000U) {
+		if (CanProto_XferPoll(&tx, now, &f)) {
+			CHECK_EQ(f.dlc, 8);
+			CHECK_EQ(f.id, CANP_ID(CANP_FN_XFER_TX, NODE_ID));
+			if ((f.data[0] >> 4) == 0x2U) {
+				if (blk > 0U) {
+					CHECK(now - last_cf >= CANP_XFER_STMIN_MS);       /* STmin entre CF d'un bloc */
+				}
+				last_cf = now;
+				cfs++;
+				blk++;
+				CHECK(CANP_XFER_BS == 0 || blk <= CANP_XFER_BS);
+			}
+			(void)CanProto_RxFrame(&rx, &f, now, &fc, &send_fc);
+			if (send_fc) {
+				CHECK_EQ(fc.id, CANP_ID(CANP_FN_XFER_RX, NODE_ID));
+				blk = 0U;
+				CanProto_XferOnFc(&tx, &fc, now);
+			}
+		}
+		now++;
+	}
+	CHECK_EQ(tx.state, CANP_X_DONE);
+	CHECK_EQ(rx.state, CANP_X_DONE);
+	CHECK_EQ(rx.len, len);
+	CHECK(memcmp(s_msg, s_buf, len) == 0);
+	CHECK_EQ(cfs, (len <= 7U) ? 0U : (len - 6U + 7U - 1U) / 7U);
+}
+
+static void loop_faults(void)
+{
+	canp_tx_t   tx;
+	canp_rx_t   rx;
+	can_frame_t f, fc;
+	bool        send_fc;
+	uint32_t    now = 0U;
+
+	/* CF perdue : rupture de séquence, le récepteur abandonne */
+	CanProto_RxBegin(&rx, CANP_ID(CANP_FN_XFER_RX, NODE_ID), s_buf, sizeof(s_buf));
+	CHECK(CanProto_XferBegin(&tx, CANP_ID(CANP_FN_XFER_TX, NODE_ID), s_msg, 100U, now));
+	CHECK(CanProto_XferPoll(&tx, now, &f));
+	CHECK_EQ(CanProto_RxFrame(&rx, &f, now, &fc, &send_fc), CANP_X_BUSY);
+	CHECK(send_fc);
+	CanProto_XferOnFc(&tx, &fc, now);
+	CHECK(CanProto_XferPoll(&tx, now, &f));                             /* CF 1 jamais reçue */
+	now += CANP_XFER_STMIN_MS;
+	CHECK(CanProto_XferPoll(&tx, now, &f));
+	CHECK_EQ(CanProto_RxFrame(&rx, &f, now, &fc, &send_fc), CANP_X_ABORT);
+
+	/* Gateway muette : pas de FC, l'émetteur abandonne après N_Bs */
+	CHECK(CanProto_XferBegin(&tx, CANP_ID(CANP_FN_XFER_TX, NODE_ID), s_msg, 100U, now));
+	CHECK(CanProto_XferPoll(&tx, now, &f));
+	CHECK(!CanProto_XferPoll(&tx, now + CANP_XFER_TIMEOUT_MS - 1U, &f));
+	CHECK_EQ(tx.state, CANP_X_WAIT_FC);
+	CHECK(!CanProto_XferPoll(&tx, now + CANP_XFER_TIMEOUT_MS, &f));
+	CHECK_EQ(tx.state, CANP_X_ABORT);
+
+	/* Message trop long pour le récepteur : FC OVFLW, l'émetteur abandonne */
+	CanProto_RxBegin(&rx, CANP_ID(CANP_FN_XFER_RX, NODE_ID), s_buf, 64U);
+	CHECK(CanProto_XferBegin(&tx, CANP_ID(CANP_FN_XFER_TX, NODE_ID), s_msg, 100U, now));
+	CHECK(CanProto_XferPoll(&tx, now, &f));
+	CHECK_EQ(CanProto_RxFrame(&rx, &f, now, &fc, &send_fc), CANP_X_ABORT);
+	CHECK(send_fc);
+	CanProto_XferOnFc(&tx, &fc, now);
+	CHECK_EQ(tx.state, CANP_X_ABORT);
+
+	CHECK(!CanProto_XferBegin(&tx, 0U, s_msg, 0U, now));
+	CHECK(!CanProto_XferBegin(&tx, 0U, s_msg, CANP_XFER_MAX_LEN + 1U, now));
+}
+
+/* ---------- Export sur le bus virtuel ---------- */
+
+/* Trames en file sur un noeud du bus, rendues au destinataire quand elles sont acquittées */
+typedef struct {
+	can_frame_t f[CANTX_Q_BULK];
+	uint32_t    head, pushed, done;
+	uint16_t    node;
+} xf_link_t;
+
+static bool link_send(xf_link_t *l, const can_frame_t *f, uint32_t t)
+{
+	if (l->pushed - l->done >= CANTX_Q_BULK || !CanBus_SimSend(l->node, CANTX_PRIO_BULK, f, (uint64_t)t * 1000U)) {
+		return false;
+	}
+	l->f[(l->head + (l->pushed - l->done)) % CANTX_Q_BULK] = *f;
+	l->pushed++;
+	return true;
+}
+
+static bool link_recv(xf_link_t *l, can_frame_t *f)
+{
+	canbus_node_stats_t ns;
+	CanBus_SimGetNodeStats(l->node, &ns);
+	if (l->done == ns.sent) {
+		return false;
+	}
+	*f      = l->f[l->head];
+	l->head = (l->head + 1U) % CANTX_Q_BULK;
+	l->done++;
+	return true;
+}
+
+/* Segment reçu : blocs contrôlés et décodés, entrées comparées au journal relu localement */
+static uint32_t gw_segment(const uint8_t *m, size_t len, uint32_t k)
+{
+	size_t off = LOGGER_SEG_HDR_SIZE, blk;
+
+	CHECK(len > LOGGER_SEG_HDR_SIZE);
+	while (off < len && Logger_CheckBlock(&m[off], len - off, &blk) == SCN_OK) {
+		logger_dec_t dec;
+		log_entry_t  e;
+		size_t       pos = 0U;
+		Logger_DecBegin(&dec);
+		while (Logger_DecNext(&dec, &m[off + LOGGER_BLK_HDR_SIZE], blk - LOGGER_BLK_HDR_SIZE, &pos, &e)) {
+			CHECK(k < XF_SAMPLES && memcmp(&e, &s_ref[k], sizeof(e)) == 0);
+			k++;
+		}
+		off += blk;
+	}
+	CHECK_EQ(off, len);                                   /* segment exporté tronqué après son dernier bloc */
+	return k;
+}
+
+/* Télémétrie : 2 trames par noeud toutes les PERIOD_CAN_MS, phases décalées. Rend la pire latence. */
+static uint32_t run_bus(bool export, size_t n_ref, uint32_t *ms_out, uint32_t *bytes_out)
+{
+	canp_export_t ex = { 0 };
+	canp_rx_t     rx;
+	xf_link_t     up = { .node = 0U }, down = { .node = 1U };
+	uint32_t      k = 0U, bytes = 0U, t, end = export ? XF_RUN_MAX_MS : 20000U;
+	bool          eot = false;
+
+	CHECK(CanBus_SimInit(2U + XF_TELEM_NODES));
+	CanProto_RxBegin(&rx, CANP_ID(CANP_FN_XFER_RX, NODE_ID), s_buf, sizeof(s_buf));
+	if (export) {
+		CanProto_ExportBegin(&ex, 0U);
+	}
+
+	for (t = 0U; t < end && !eot; t++) {
+		can_frame_t f, fc;
+		bool        send_fc;
+
+		CanBus_SimRunUntil((uint64_t)t * 1000U);
+		while (link_recv(&up, &f)) {                          /* gateway */
+			if (CanProto_RxFrame(&rx, &f, t, &fc, &send_fc) == CANP_X_DONE) {
+				if (rx.len == 1U && s_buf[0] == CANP_EXPORT_EOT) {
+					eot = true;
+				} else {
+					k      = gw_segment(s_buf, rx.len, k);
+					bytes += rx.len;
+				}
+				rx.state = CANP_X_IDLE;
+			}
+			if (send_fc) {
+				CHECK(link_send(&down, &fc, t));
+			}
+		}
+		while (link_recv(&down, &f)) {
+			CanProto_ExportOnFc(&ex, &f, t);
+		}
+		if (export && up.pushed - up.done < CANTX_Q_BULK && CanProto_ExportPoll(&ex, t, &f)) {
+			CHECK(link_send(&up, &f, t));
+		}
+		for (uint16_t i = 0U; i < XF_TELEM_NODES; i++) {
+			if (t % PERIOD_CAN_MS == (i * 7U) % PERIOD_CAN_MS) {
+				for (uint8_t j = 0U; j < 2U; j++) {
+					f.id  = CANP_ID(CANP_FN_TELEM, i + 2U);
+					f.dlc = 8U;
+					for (uint8_t b = 0U; b < 8U; b++) {
+						f.data[b] = (uint8_t)test_rnd(&s_seed);
+					}
+					CHECK(CanBus_SimSend((uint16_t)(2U + i), CANTX_PRIO_TELEM, &f, (uint64_t)t * 1000U));
+				}
+			}
+		}
+	}
+	CanBus_SimRunUntil((uint64_t)t * 1000U);
+
+	if (export) {
+		CHECK(eot);
+		CHECK(!ex.active);
+		CHECK_EQ(ex.err, SCN_OK);
+		CHECK_EQ(k, n_ref);
+		*ms_out    = t;
+		*bytes_out = bytes;
+	}
+
+	uint32_t lat = 0U;
+	for (uint16_t i = 0U; i < XF_TELEM_NODES; i++) {
+		canbus_node_stats_t ns;
+		CanBus_SimGetNodeStats((uint16_t)(2U + i), &ns);
+		CHECK_EQ(ns.lost, 0);
+		lat = (ns.lat_max_us > lat) ? ns.lat_max_us : lat;
+	}
+	return lat;
+}
+
+int main(void)
+{
+	static const uint8_t zero[FRAM_SLOT_SIZE];
+	static const size_t  lens[] = { 1U, 7U, 8U, 13U, 14U, 62U, 63U, 64U, 500U, 512U, 4095U };
+
+	for (size_t i = 0U; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		loop_one(lens[i]);
+	}
+	for (uint32_t i = 0U; i < 200U; i++) {
+		loop_one(1U + test_rnd(&s_seed) % CANP_XFER_MAX_LEN);
+	}
+	loop_faults();
+
+	/* Journal : FRAM effacée, quelques milliers de mesures commitées */
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	for (uint32_t a = 0U; a < FRAM_SIZE_BYTES; a += sizeof(zero)) {
+		CHECK_EQ(Fram_Write(a, zero, sizeof(zero)), SCN_OK);
+	}
+	Logger_Init();
+	for (uint32_t i = 0U; i < XF_SAMPLES; i++) {
+		log_entry_t e = { 0 };
+		e.ts_ms  = i * 1000U;
+		e.t_cC   = (int16_t)(300 + (int32_t)(test_rnd(&s_seed) % 30U));
+		e.rh_pm  = (uint16_t)(550U + test_rnd(&s_seed) % 10U);
+		e.vin_mV = 12000U;
+		e.crc8   = Logger_EntryCrc(&e);
+		CHECK(Logger_Append(&e));
+		if (i % 10U == 9U) {
+			CHECK_EQ(Logger_Commit(), SCN_OK);
+		}
+	}
+	size_t n_ref = Logger_ReadFrom(0U, s_ref, XF_SAMPLES);
+	CHECK(n_ref > 1000U);
+
+	uint32_t ms = 0U, bytes = 0U;
+	uint32_t lat0 = run_bus(false, 0U, NULL, NULL);
+	uint32_t lat1 = run_bus(true, n_ref, &ms, &bytes);
+	uint32_t bps  = (ms > 0U) ? (uint32_t)((uint64_t)bytes * 1000U / ms) : 0U;
+
+	printf("export : %u entrées, %u o en %u ms (%u o/s) ; latence télémétrie max %u us (sans export %u us)\n",
+	       (unsigned)n_ref, bytes, ms, bps, lat1, lat0);
+	/* Plafond : 7 o par CF tous les STmin ; FC toutes les BS CF et en-têtes en plus */
+	CHECK(bps >= (7000U / CANP_XFER_STMIN_MS) * 7U / 10U);
+	CHECK(lat1 <= lat0 + XF_FRAME_US);
+	TEST_END();
+}
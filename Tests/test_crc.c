@@ -0,0 +1,73 @@
+/**
+ * @file    test_crc.c
+ * @brief   CRC-8 (poly 0x31, init 0xFF) : vecteurs connus, variantes bit à
+ *          bit / table / slice-by-4 identiques sur toutes longueurs, tous
+ *          alignements et CRC de départ, calcul incrémental ; CRC-32 de bloc
+ *          bit-exact avec l'unité STM32.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "crc_utils.h"
+
+static void test_crc8_vectors(void)
+{
+	const uint8_t beef[] = { 0xBEU, 0xEFU };
+	const uint8_t check[] = "123456789";
+
+	CHECK_EQ(Crc8_Compute(beef, sizeof(beef)), 0x92);                 /* datasheet SHT31 */
+	CHECK_EQ(Crc8_Compute(check, sizeof(check) - 1U), 0xF7);          /* CRC-8/NRSC-5 */
+	CHECK_EQ(Crc8_Compute(check, 0U), CRC8_INIT);
+	CHECK(Crc8_SelfTest());
+}
+
+static void test_crc8_variants(void)
+{
+	static uint8_t buf[1100];
+	uint32_t       seed = 0xC0FFEEU;
+	uint32_t       diff = 0U;
+
+	for (size_t i = 0U; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)test_rnd(&seed);
+	}
+	/* Toutes les longueurs jusqu'à 260 et quelques grandes, 4 alignements, CRC de départ quelconque */
+	for (size_t len = 0U; len <= 1024U; len = (len < 260U) ? len + 1U : len * 2U) {
+		for (size_t off = 0U; off < 4U; off++) {
+			uint8_t init = (uint8_t)test_rnd(&seed);
+			uint8_t ref  = Crc8_UpdateBitwise(init, &buf[off], len);
+			diff += (Crc8_UpdateTable(init, &buf[off], len) != ref) ? 1U : 0U;
+			diff += (Crc8_UpdateSlice4(init, &buf[off], len) != ref) ? 1U : 0U;
+			diff += (Crc8_Update(init, &buf[off], len) != ref) ? 1U : 0U;
+		}
+	}
+	CHECK_EQ(diff, 0);
+
+	/* Incrémental : CRC(a || b) = Update(CRC(a), b), coupure quelconque */
+	uint8_t whole = Crc8_Compute(buf, 1000U);
+	for (size_t cut = 0U; cut <= 1000U; cut += 7U) {
+		CHECK_EQ(Crc8_Update(Crc8_Compute(buf, cut), &buf[cut], 1000U - cut), whole);
+	}
+}
+
+static void test_crc32(void)
+{
+	const uint8_t word[] = { 0x78U, 0x56U, 0x34U, 0x12U };             /* 0x12345678 LE */
+	uint8_t       buf[12] = { 0x78U, 0x56U, 0x34U, 0x12U, 0xAAU };
+
+	CHECK_EQ(Crc32_Compute(word, sizeof(word)), 0xDF8A8A2BU);          /* référence ST */
+	CHECK(Crc32_SelfTest());
+
+	/* Dernier mot complété par des zéros : 5 octets = 8 octets avec 3 zéros */
+	CHECK_EQ(Crc32_Compute(buf, 5U), Crc32_Compute(buf, 8U));
+	CHECK(Crc32_Compute(buf, 5U) != Crc32_Compute(word, 4U));
+}
+
+int main(void)
+{
+	test_crc8_vectors();
+	test_crc8_variants();
+	test_crc32();
+	TEST_END();
+}
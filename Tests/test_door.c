@@ -0,0 +1,114 @@
+/**
+ * @file    test_door.c
+ * @brief   Contact de porte sur broche et timer simulés : rafales de rebonds
+ *          injectées, état pris en compte exactement DOOR_DEBOUNCE_MS après le
+ *          dernier front, glitch plus court que l'anti-rebond ignoré, un seul
+ *          changement compté (et horodaté) par transition réelle.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "door.h"
+
+#define FUZZ_BURSTS   2000U
+
+static uint32_t s_seed = 18U;
+
+/* Rafale : fronts espacés de moins que l'anti-rebond, niveau final `end` (un front de plus
+ * si la parité l'exige) ; instant du dernier front
+ */
+static uint32_t burst(bool end, uint32_t edges)
+{
+	bool lvl = Door_IsOpen();
+
+	if (((edges & 1U) != 0U) == (lvl == end)) {
+		edges++;
+	}
+	for (uint32_t i = 0U; i < edges; i++) {
+		lvl = !lvl;
+		Door_SimSetPin(lvl);
+		if (i + 1U < edges) {
+			Door_SimAdvance(1U + test_rnd(&s_seed) % (DOOR_DEBOUNCE_MS - 1U));
+		}
+	}
+	return Door_SimNowMs();
+}
+
+/* Avance ms par ms : l'état ne bascule qu'à last + DOOR_DEBOUNCE_MS, et une seule fois */
+static void settle(uint32_t last, bool want)
+{
+	door_stats_t st0, st;
+	bool         before = Door_IsOpen();
+
+	Door_GetStats(&st0);
+	while (Door_SimNowMs() - last < DOOR_DEBOUNCE_MS - 1U) {
+		Door_SimAdvance(1U);
+		CHECK_EQ(Door_IsOpen(), before);
+	}
+	Door_SimAdvance(1U);
+	CHECK_EQ(Door_SimNowMs(), last + DOOR_DEBOUNCE_MS);
+	CHECK_EQ(Door_IsOpen(), want);
+	Door_SimAdvance(5U * DOOR_DEBOUNCE_MS);
+	CHECK_EQ(Door_IsOpen(), want);
+
+	Door_GetStats(&st);
+	CHECK_EQ(st.changes, st0.changes + ((want != before) ? 1U : 0U));
+	if (want != before) {
+		CHECK_EQ(st.last_change_ms, last + DOOR_DEBOUNCE_MS);
+	} else {
+		CHECK_EQ(st.last_change_ms, st0.last_change_ms);
+	}
+}
+
+int main(void)
+{
+	door_stats_t st;
+
+	Door_SimSetPin(false);
+	CHECK_EQ(Door_Init(), SCN_OK);
+	CHECK(!Door_IsOpen());
+	Door_SimAdvance(100U);
+
+	/* Ouverture franche puis fermeture avec rebonds */
+	settle(burst(true, 1U), true);
+	Door_GetStats(&st);
+	CHECK_EQ(st.changes, 1);
+	CHECK_EQ(st.edges, 1);
+	uint32_t last = burst(false, 9U);
+	Door_GetStats(&st);
+	CHECK_EQ(st.edges, 10);
+	settle(last, false);
+
+	/* Front à DOOR_DEBOUNCE_MS - 1 du précédent : l'échéance est repoussée */
+	Door_SimSetPin(true);
+	Door_SimAdvance(DOOR_DEBOUNCE_MS - 1U);
+	CHECK(!Door_IsOpen());
+	Door_SimSetPin(false);
+	Door_SimAdvance(DOOR_DEBOUNCE_MS - 1U);
+	Door_SimSetPin(true);
+	settle(Door_SimNowMs(), true);
+
+	/* Glitch plus court que l'anti-rebond : aucun changement */
+	for (uint32_t w = 1U; w < DOOR_DEBOUNCE_MS; w++) {
+		Door_SimSetPin(false);
+		Door_SimAdvance(w);
+		Door_SimSetPin(true);
+		settle(Door_SimNowMs(), true);
+	}
+
+	/* Rafales aléatoires : niveau final quelconque, une transition comptée au plus */
+	Door_GetStats(&st);
+	uint32_t changes = st.changes;
+	for (uint32_t i = 0U; i < FUZZ_BURSTS; i++) {
+		bool want = (test_rnd(&s_seed) & 1U) != 0U;
+		changes  += (want != Door_IsOpen()) ? 1U : 0U;
+		settle(burst(want, 1U + test_rnd(&s_seed) % 12U), want);
+	}
+	Door_GetStats(&st);
+	CHECK_EQ(st.changes, changes);
+	printf("%u fronts, %u changements publiés\n", st.edges, st.changes);
+
+	TEST_END();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file    test_filter.c
+ * @brief   Filtrage en flux : médiane 5 contre un tri de référence, rejet des
+ *          pics isolés, EMA sans biais de troncature (échelon positif et
+ *          négatif), calibration Q14, amorçage et reprise d'une voie.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "filter.h"
+#include <stdlib.h>
+
+static int cmp_i32(const void *a, const void *b)
+{
+	int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+	return (x > y) - (x < y);
+}
+
+static void test_med5_reference(void)
+{
+	filter_med5_t m;
+	int32_t       hist[FILTER_MED_LEN];
+	uint32_t      seed = 0x2545F491U;
+
+	Filter_Med5Seed(&m, 0);
+	for (uint32_t i = 0U; i < FILTER_MED_LEN; i++) {
+		hist[i] = 0;
+	}
+	for (uint32_t i = 0U; i < 20000U; i++) {
+		int32_t x = (int32_t)(test_rnd(&seed) % 2001U) - 1000;
+		int32_t w[FILTER_MED_LEN];
+
+		hist[i % FILTER_MED_LEN] = x;
+		for (uint32_t k = 0U; k < FILTER_MED_LEN; k++) {
+			w[k] = hist[k];
+		}
+		qsort(w, FILTER_MED_LEN, sizeof(w[0]), cmp_i32);
+		CHECK_EQ(Filter_Med5(&m, x), w[FILTER_MED_LEN / 2U]);
+	}
+}
+
+static void test_med5_spikes(void)
+{
+	filter_med5_t m;
+
+	/* Deux pics sur cinq, de signes opposés, à toutes les positions */
+	Filter_Med5Seed(&m, 300);
+	for (uint32_t i = 0U; i < 100U; i++) {
+		int32_t x = 300;
+		if (i % 5U == 1U) {
+			x = 30000;
+		} else if (i % 5U == 3U) {
+			x = -30000;
+		}
+		CHECK_EQ(Filter_Med5(&m, x), 300);
+	}
+}
+
+static void test_ema(void)
+{
+	filter_ema_t e;
+	int32_t      y = 0;
+
+	/* Echelon : la sortie atteint exactement la consigne, dans les deux sens */
+	e.shift = 3U;
+	Filter_EmaSeed(&e, 0);
+	for (uint32_t i = 0U; i < 400U; i++) {
+		y = Filter_Ema(&e, 1000);
+		CHECK(y >= 0 && y <= 1000);
+	}
+	CHECK_EQ(y, 1000);
+	for (uint32_t i = 0U; i < 400U; i++) {
+		y = Filter_Ema(&e, -1000);
+	}
+	CHECK_EQ(y, -1000);
+
+	/* Entrée constante après amorçage : sortie constante */
+	e.shift = 4U;
+	Filter_EmaSeed(&e, -257);
+	for (uint32_t i = 0U; i < 50U; i++) {
+		CHECK_EQ(Filter_Ema(&e, -257), -257);
+	}
+}
+
+static void test_cal(void)
+{
+	filter_cal_t c = { 0, FILTER_GAIN_ONE };
+
+	CHECK_EQ(Filter_Cal(&c, 1234), 1234);
+	CHECK_EQ(Filter_Cal(&c, -1234), -1234);
+
+	c.offset   = -25;
+	c.gain_q14 = FILTER_GAIN_ONE + FILTER_GAIN_ONE / 2;           /* x1,5 */
+	CHECK_EQ(Filter_Cal(&c, 1000), 1475);
+	CHECK_EQ(Filter_Cal(&c, -1000), -1525);
+
+	c.offset   = 0;
+	c.gain_q14 = FILTER_GAIN_ONE + 82;                            /* +0,5 % : arrondi au plus proche */
+	CHECK_EQ(Filter_Cal(&c, 10000), 10050);
+	CHECK_EQ(Filter_Cal(&c, 32767), 32931);
+}
+
+static void test_chan(void)
+{
+	filter_chan_t c;
+
+	/* Premier échantillon : aucun transitoire depuis 0 */
+	Filter_ChanInit(&c, 2U);
+	CHECK(!c.seeded);
+	CHECK_EQ(Filter_Chan(&c, 2500), 2500);
+	CHECK(c.seeded);
+
+	/* Pic isolé absorbé par la médiane, donc invisible après l'EMA */
+	CHECK_EQ(Filter_Chan(&c, 9000), 2500);
+	CHECK_EQ(Filter_Chan(&c, 2500), 2500);
+
+	/* Calibration modifiée en marche : appliquée en sortie, filtres intacts */
+	c.cal.offset = 100;
+	CHECK_EQ(Filter_Chan(&c, 2500), 2600);
+	c.cal.offset = 0;
+
+	/* Reprise après défaut : repart de l'échantillon suivant */
+	Filter_ChanReset(&c);
+	CHECK(!c.seeded);
+	CHECK_EQ(Filter_Chan(&c, -400), -400);
+	CHECK_EQ(Filter_Chan(&c, -400), -400);
+}
+
+int main(void)
+{
+	test_med5_reference();
+	test_med5_spikes();
+	test_ema();
+	test_cal();
+	test_chan();
+	TEST_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file    test_fram_sim.c
+ * @brief   FRAM virtuelle (SIM_TARGET) : image sur fichier mappé, bornes,
+ *          compteurs bus, temps SPI modélisé (FRAM_SIM_SPI_HZ / FRAM_SIM_CS_NS),
+ *          usure par octet, double buffer de staging, coupure d'alim.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "fram_spi.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CMD_LEN    3U          /* opcode + adresse 16 bits (fram_spi.c) */
+#define SIM_ADDR       0x1230U
+
+static uint8_t  s_buf[FRAM_STAGE_SIZE];
+static uint8_t  s_chk[FRAM_STAGE_SIZE];
+static uint32_t s_seed = 7U;
+
+/* Modèle attendu : une transaction CS = surcoût fixe + octets à FRAM_SIM_SPI_HZ */
+static uint64_t cs_ns(uint32_t bytes)
+{
+	return FRAM_SIM_CS_NS + ((uint64_t)bytes * 8U * 1000000000ULL) / FRAM_SIM_SPI_HZ;
+}
+
+static void fill(uint8_t *p, size_t n)
+{
+	for (size_t i = 0U; i < n; i++) {
+		p[i] = (uint8_t)test_rnd(&s_seed);
+	}
+}
+
+/* Octets lus directement dans le fichier : l'image est bien celle du disque */
+static void check_file(uint32_t addr, const uint8_t *ref, size_t n)
+{
+	const char *path = getenv("SCN_FRAM_FILE");
+	FILE       *f    = fopen((path != NULL) ? path : FRAM_SIM_FILE, "rb");
+	uint8_t     tmp[64];
+
+	CHECK(f != NULL);
+	if (f == NULL) {
+		return;
+	}
+	CHECK_EQ(fseek(f, (long)addr, SEEK_SET), 0);
+	CHECK_EQ(fread(tmp, 1U, n, f), n);
+	CHECK(memcmp(tmp, ref, n) == 0);
+	fclose(f);
+}
+
+int main(void)
+{
+	fram_stats_t     st;
+	fram_sim_stats_t ss, ss0;
+
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	CHECK(Fram_SimWearMap() != NULL);
+
+	/* Bornes : dernier octet accessible, un de plus refusé */
+	CHECK_EQ(Fram_Write(FRAM_SIZE_BYTES - 1U, s_buf, 1U), SCN_OK);
+	CHECK_EQ(Fram_Write(FRAM_SIZE_BYTES - 1U, s_buf, 2U), ERR_FRAM_RANGE);
+	CHECK_EQ(Fram_Read(FRAM_SIZE_BYTES, s_chk, 1U), ERR_FRAM_RANGE);
+	CHECK_EQ(Fram_Read(0U, s_chk, FRAM_SIZE_BYTES + 1U), ERR_FRAM_RANGE);
+	CHECK_EQ(Fram_StageSubmit(0U, FRAM_STAGE_SIZE + 1U), ERR_FRAM_RANGE);
+
+	/* Aller-retour, compteurs bus et temps SPI d'une écriture puis d'une lecture */
+	fill(s_buf, 64U);
+	Fram_ResetStats();
+	CHECK_EQ(Fram_Write(SIM_ADDR, s_buf, 64U), SCN_OK);
+	Fram_SimGetStats(&ss);
+	CHECK_EQ(ss.bus_ns, cs_ns(1U) + cs_ns(SIM_CMD_LEN + 64U));     /* WREN puis WRITE */
+	CHECK_EQ(Fram_Read(SIM_ADDR, s_chk, 64U), SCN_OK);
+	CHECK(memcmp(s_buf, s_chk, 64U) == 0);
+	Fram_SimGetStats(&ss);
+	CHECK_EQ(ss.bus_ns, cs_ns(1U) + 2U * cs_ns(SIM_CMD_LEN + 64U));
+	Fram_GetStats(&st);
+	CHECK_EQ(st.transactions, 3);
+	CHECK_EQ(st.cmd_bytes, 1U + 2U * SIM_CMD_LEN);
+	CHECK_EQ(st.data_bytes, 128);
+	CHECK_EQ(st.errors, 0);
+	check_file(SIM_ADDR, s_buf, 64U);
+
+	/* Page de staging pleine : ~196 µs à 21 MHz, le surcoût CS reste marginal */
+	Fram_ResetStats();
+	fill(Fram_StageBuffer(), FRAM_STAGE_SIZE);
+	memcpy(s_buf, Fram_StageBuffer(), FRAM_STAGE_SIZE);
+	CHECK_EQ(Fram_StageSubmit(FRAM_JOURNAL_BASE, FRAM_STAGE_SIZE), SCN_OK);
+	CHECK_EQ(Fram_Flush(), SCN_OK);
+	Fram_SimGetStats(&ss);
+	CHECK_EQ(ss.bus_ns, cs_ns(1U) + cs_ns(SIM_CMD_LEN + FRAM_STAGE_SIZE));
+	CHECK(ss.bus_ns > 190000U && ss.bus_ns < 205000U);
+	CHECK_EQ(Fram_Read(FRAM_JOURNAL_BASE, s_chk, FRAM_STAGE_SIZE), SCN_OK);
+	CHECK(memcmp(s_buf, s_chk, FRAM_STAGE_SIZE) == 0);
+
+	/* Double buffer : les deux pages alternent, aucune n'écrase l'autre avant son envoi */
+	uint8_t *b0 = Fram_StageBuffer();
+	memset(b0, 0xA5, 32U);
+	CHECK_EQ(Fram_StageSubmit(SIM_ADDR, 32U), SCN_OK);
+	uint8_t *b1 = Fram_StageBuffer();
+	CHECK(b1 != b0);
+	memset(b1, 0x5A, 32U);
+	CHECK_EQ(Fram_StageSubmit(SIM_ADDR + 32U, 32U), SCN_OK);
+	CHECK(Fram_StageBuffer() == b0);
+	CHECK_EQ(Fram_Flush(), SCN_OK);
+	CHECK_EQ(Fram_Read(SIM_ADDR, s_chk, 64U), SCN_OK);
+	CHECK(s_chk[0] == 0xA5U && s_chk[31] == 0xA5U && s_chk[32] == 0x5AU && s_chk[63] == 0x5AU);
+
+	/* Usure : comptée par octet écrit, jamais remise à zéro, octet le plus sollicité repéré */
+	const uint32_t *wear = Fram_SimWearMap();
+	uint32_t        w0   = wear[SIM_ADDR + 1U];
+	uint32_t        wn   = wear[SIM_ADDR + 9U];
+	Fram_SimGetStats(&ss0);
+	for (uint32_t i = 0U; i < 1000U; i++) {
+		CHECK_EQ(Fram_Write(SIM_ADDR + 1U, s_buf, 8U), SCN_OK);
+	}
+	Fram_ResetStats();
+	Fram_SimGetStats(&ss);
+	CHECK_EQ(ss.bus_ns, 0);
+	CHECK_EQ(ss.byte_writes - ss0.byte_writes, 8000);
+	CHECK_EQ(wear[SIM_ADDR + 1U] - w0, 1000);
+	CHECK_EQ(wear[SIM_ADDR + 9U], wn);
+	CHECK(ss.max_writes >= wear[SIM_ADDR + 1U]);
+	CHECK_EQ(wear[ss.max_addr], ss.max_writes);
+
+	/* Coupure d'alim : écriture tronquée, tout est perdu ensuite ; reboot = alim rétablie */
+	memset(s_buf, 0x11, 64U);
+	CHECK_EQ(Fram_Write(SIM_ADDR, s_buf, 64U), SCN_OK);
+	memset(s_buf, 0x22, 64U);
+	Fram_SimPowerCut(40U);
+	CHECK_EQ(Fram_Write(SIM_ADDR, s_buf, 32U), SCN_OK);
+	CHECK_EQ(Fram_Write(SIM_ADDR + 32U, s_buf, 32U), SCN_OK);
+	CHECK_EQ(Fram_Read(SIM_ADDR, s_chk, 64U), SCN_OK);
+	CHECK(s_chk[39] == 0x22U && s_chk[40] == 0x11U && s_chk[63] == 0x11U);
+	CHECK_EQ(Fram_Write(SIM_ADDR + 48U, s_buf, 8U), SCN_OK);
+	CHECK_EQ(Fram_Read(SIM_ADDR + 48U, s_chk, 8U), SCN_OK);
+	CHECK_EQ(s_chk[0], 0x11);
+
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	CHECK_EQ(Fram_Read(SIM_ADDR, s_chk, 64U), SCN_OK);            /* contenu conservé au reboot */
+	CHECK(s_chk[0] == 0x22U && s_chk[40] == 0x11U);
+	CHECK_EQ(Fram_Write(SIM_ADDR + 40U, s_buf, 24U), SCN_OK);
+	CHECK_EQ(Fram_Read(SIM_ADDR, s_chk, 64U), SCN_OK);
+	CHECK(memcmp(s_buf, s_chk, 64U) == 0);
+	check_file(SIM_ADDR, s_buf, 64U);
+
+	TEST_END();
+}
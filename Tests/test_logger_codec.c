@@ -0,0 +1,226 @@
+/**
+ * @file    test_logger_codec.c
+ * @brief   Codec du journal : aller-retour exact (trace de chambre froide,
+ *          valeurs aléatoires pleine échelle, longues répétitions, écarts
+ *          d'horodatage variables), refus sans place, groupe altéré rejeté
+ *          avant toute entrée, puis rétention mesurée à 1 Hz à travers
+ *          Logger_Commit (octets par mesure, durée couverte par la FRAM).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include "fram_spi.h"
+#include <string.h>
+
+#define CODEC_BUF        4096U
+#define CODEC_N          3000U
+#define RETAIN_SAMPLES   100000U
+#define CODEC_MAX_BPS_X100   300U   /* codec seul, trace froide : octets par mesure x100 (~2,1 mesuré) */
+#define JRNL_MAX_BPS_X100    800U   /* journal, commit toutes les COMMIT_MS : keyframe, en-tête et
+                                     * CRC-32 par bloc compris (~5,2 mesuré) */
+
+typedef enum { TRACE_COLD, TRACE_RANDOM, TRACE_FLAT } trace_t;
+
+static uint32_t s_seed = 0x9E3779B9U;
+
+/* Mesure i d'une trace : grandeurs d'une chambre froide, ou valeurs quelconques */
+static log_entry_t trace(trace_t kind, uint32_t i)
+{
+	log_entry_t e = { 0 };
+
+	switch (kind) {
+	case TRACE_COLD:
+		e.ts_ms   = i * 1000U;
+		e.t_cC    = (int16_t)(300 + (int32_t)((i / 20U) % 60U) - 30 + (int32_t)(test_rnd(&s_seed) % 3U) - 1);
+		e.rh_pm   = (uint16_t)(550 + (i / 300U) % 5U);
+		e.tmcu_cC = 3000;
+		e.vin_mV  = (uint16_t)(24000 + (test_rnd(&s_seed) % 8U == 0U ? 10 : 0));
+		e.door    = (uint8_t)((i % 600U) < 30U);
+		e.flags   = 0U;
+		break;
+	case TRACE_RANDOM:
+		e.ts_ms   = i * 1000U + test_rnd(&s_seed) % 5000U;     /* écarts irréguliers, parfois nuls */
+		e.t_cC    = (int16_t)test_rnd(&s_seed);
+		e.rh_pm   = (uint16_t)test_rnd(&s_seed);
+		e.tmcu_cC = (int16_t)test_rnd(&s_seed);
+		e.vin_mV  = (uint16_t)test_rnd(&s_seed);
+		e.door    = (uint8_t)test_rnd(&s_seed);
+		e.flags   = (uint8_t)test_rnd(&s_seed);
+		break;
+	default:
+		e.ts_ms   = 0xFFFF0000U + i * 250U;                     /* repli 32 bits en cours de trace */
+		e.t_cC    = -1800;
+		e.rh_pm   = 900;
+		e.tmcu_cC = 2700;
+		e.vin_mV  = 23950;
+		break;
+	}
+	return e;
+}
+
+static bool same(const log_entry_t *a, const log_entry_t *b)
+{
+	return a->ts_ms == b->ts_ms && a->t_cC == b->t_cC && a->rh_pm == b->rh_pm && a->tmcu_cC == b->tmcu_cC &&
+	       a->vin_mV == b->vin_mV && a->door == b->door && a->flags == b->flags;
+}
+
+static log_entry_t s_tr[CODEC_N];
+
+static void trace_fill(trace_t kind, uint32_t seed)
+{
+	s_seed = seed;
+	for (uint32_t i = 0U; i < CODEC_N; i++) {
+		s_tr[i] = trace(kind, i);
+	}
+}
+
+/* Encode la trace par buffers de CODEC_BUF, redécode chaque buffer ; octets produits */
+static size_t roundtrip(trace_t kind)
+{
+	static uint8_t buf[CODEC_BUF];
+	logger_enc_t   enc;
+	size_t         total = 0U;
+	uint32_t       in = 0U, out = 0U, bad = 0U;
+
+	trace_fill(kind, 0x9E3779B9U);
+	while (in < CODEC_N) {
+		size_t   pos   = 0U;
+		uint32_t first = in;
+
+		Logger_EncBegin(&enc);
+		while (in < CODEC_N && Logger_EncPut(&enc, &s_tr[in], buf, sizeof(buf), &pos)) {
+			in++;
+		}
+		Logger_EncEnd(&enc, buf, &pos);
+		CHECK(pos <= sizeof(buf));
+		CHECK(in > first);
+		total += pos;
+
+		logger_dec_t dec;
+		log_entry_t  d;
+		size_t       rp = 0U;
+		Logger_DecBegin(&dec);
+		while (out < in && Logger_DecNext(&dec, buf, pos, &rp, &d)) {
+			bad += (same(&d, &s_tr[out]) && d.crc8 == Logger_EntryCrc(&d)) ? 0U : 1U;
+			out++;
+		}
+		CHECK(!Logger_DecNext(&dec, buf, pos, &rp, &d));   /* rien au-delà */
+		CHECK_EQ(out, in);
+	}
+	CHECK_EQ(bad, 0);
+	return total;
+}
+
+static void test_roundtrip(void)
+{
+	size_t cold = roundtrip(TRACE_COLD);
+	size_t rnd  = roundtrip(TRACE_RANDOM);
+	size_t flat = roundtrip(TRACE_FLAT);
+
+	printf("codec %u mesures : froide %zu o, aléatoire %zu o, constante %zu o\n", CODEC_N, cold, rnd, flat);
+	CHECK(flat < cold && cold < rnd);
+	CHECK(cold * 100U <= (size_t)CODEC_N * CODEC_MAX_BPS_X100);
+	CHECK(rnd <= (size_t)CODEC_N * LOGGER_REC_MAX);
+}
+
+static void test_limits(void)
+{
+	uint8_t      buf[64];
+	logger_enc_t enc;
+	log_entry_t  e = trace(TRACE_RANDOM, 0U);
+	size_t       pos = sizeof(buf) - LOGGER_REC_MAX + 1U;
+
+	Logger_EncBegin(&enc);
+	CHECK(!Logger_EncPut(&enc, &e, buf, sizeof(buf), &pos));   /* moins de LOGGER_REC_MAX libres */
+	CHECK_EQ(pos, sizeof(buf) - LOGGER_REC_MAX + 1U);
+
+	/* Keyframe pleine échelle et sa clôture : dans LOGGER_REC_MAX */
+	pos = 0U;
+	CHECK(Logger_EncPut(&enc, &e, buf, sizeof(buf), &pos));
+	Logger_EncEnd(&enc, buf, &pos);
+	CHECK(pos <= LOGGER_REC_MAX);
+}
+
+static void test_corruption(void)
+{
+	static uint8_t buf[CODEC_BUF];
+	logger_enc_t   enc;
+	size_t         pos = 0U;
+	uint32_t       n   = 2U * LOGGER_KEYFRAME_INTERVAL;
+
+	trace_fill(TRACE_COLD, 1U);
+	Logger_EncBegin(&enc);
+	for (uint32_t i = 0U; i < n; i++) {
+		CHECK(Logger_EncPut(&enc, &s_tr[i], buf, sizeof(buf), &pos));
+	}
+	Logger_EncEnd(&enc, buf, &pos);
+
+	/* Chaque octet altéré à son tour : aucune entrée fausse ne sort du décodeur */
+	uint32_t wrong = 0U, short_reads = 0U;
+	for (size_t k = 0U; k < pos; k++) {
+		logger_dec_t dec;
+		log_entry_t  d;
+		size_t       rp = 0U;
+		uint32_t     i  = 0U;
+
+		buf[k] ^= 0x10U;
+		Logger_DecBegin(&dec);
+		while (i < n && Logger_DecNext(&dec, buf, pos, &rp, &d)) {
+			wrong += same(&d, &s_tr[i++]) ? 0U : 1U;
+		}
+		short_reads += (i < n) ? 1U : 0U;
+		buf[k] ^= 0x10U;
+	}
+	CHECK_EQ(wrong, 0);
+	CHECK_EQ(short_reads, pos);                    /* tout octet altéré fait rejeter un groupe */
+}
+
+/* Journal complet à 1 Hz, commit toutes les COMMIT_MS : combien de temps la FRAM garde-t-elle ? */
+static void test_retention(void)
+{
+	static log_entry_t out[RETAIN_SAMPLES];
+	fram_sim_stats_t   st0, st1;
+	uint32_t           per_commit = COMMIT_MS / PERIOD_ACQ_MS;
+
+	remove(FRAM_SIM_FILE);
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	Logger_Init();
+	Fram_SimGetStats(&st0);
+
+	s_seed = 7U;
+	for (uint32_t i = 0U; i < RETAIN_SAMPLES; i++) {
+		log_entry_t e = trace(TRACE_COLD, i);
+		CHECK(Logger_Append(&e));
+		if ((i + 1U) % per_commit == 0U) {
+			CHECK_EQ(Logger_Commit(), SCN_OK);
+		}
+	}
+	CHECK_EQ(Logger_Commit(), SCN_OK);
+	Fram_SimGetStats(&st1);
+
+	size_t n = Logger_ReadFrom(0U, out, RETAIN_SAMPLES);
+	CHECK(n > 0U);
+	CHECK_EQ(out[n - 1U].ts_ms, (RETAIN_SAMPLES - 1U) * 1000U);   /* le plus récent est gardé */
+	for (size_t k = 1U; k < n; k++) {
+		CHECK_EQ(out[k].ts_ms - out[k - 1U].ts_ms, 1000);
+	}
+
+	uint32_t area = FRAM_SIZE_BYTES - FRAM_JOURNAL_BASE;
+	uint32_t bps  = (uint32_t)((uint64_t)area * 100U / n);
+	printf("rétention 1 Hz : %zu mesures (%.1f h) dans %u o de journal, %u.%02u o/mesure, %llu o écrits\n",
+	       n, (double)n / 3600.0, area, bps / 100U, bps % 100U,
+	       (unsigned long long)(st1.byte_writes - st0.byte_writes));
+	CHECK(bps <= JRNL_MAX_BPS_X100);
+}
+
+int main(void)
+{
+	test_roundtrip();
+	test_limits();
+	test_corruption();
+	test_retention();
+	TEST_END();
+}
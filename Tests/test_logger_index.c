@@ -0,0 +1,128 @@
+/**
+ * @file    test_logger_index.c
+ * @brief   Index du journal et requêtes par date (Logger_ReadFrom) : résultat
+ *          identique à un filtrage linéaire de tout ce qui a été écrit, pour
+ *          des bornes quelconques, journal plein et recyclé ; pagination
+ *          "dernier ts + 1" ; FRAM lue limitée aux segments utiles ; compteur
+ *          ms replié en cours de journal.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include "fram_spi.h"
+
+#define IDX_SAMPLES    40000U     /* plusieurs tours de journal */
+#define IDX_QUERIES    300U
+#define IDX_PAGE       97U
+
+static log_entry_t s_all[IDX_SAMPLES];
+static log_entry_t s_out[IDX_SAMPLES];
+static uint32_t    s_seed = 42U;
+
+/* Écrit n mesures à partir de ts0 (pas 1..3 s), commit toutes les 10 */
+static void fill(uint32_t ts0, uint32_t n)
+{
+	uint32_t ts = ts0;
+
+	/* FRAM effacée : la FRAM simulée reste mappée d'un appel à l'autre */
+	static const uint8_t zero[FRAM_SLOT_SIZE];
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	for (uint32_t a = 0U; a < FRAM_SIZE_BYTES; a += sizeof(zero)) {
+		CHECK_EQ(Fram_Write(a, zero, sizeof(zero)), SCN_OK);
+	}
+	Logger_Init();
+	for (uint32_t i = 0U; i < n; i++) {
+		log_entry_t e = { 0 };
+		e.ts_ms  = ts;
+		e.t_cC   = (int16_t)(250 + (int32_t)(test_rnd(&s_seed) % 40U));
+		e.rh_pm  = 600U;
+		e.vin_mV = 24000U;
+		CHECK(Logger_Append(&e));
+		s_all[i] = e;
+		ts += 1000U * (1U + test_rnd(&s_seed) % 3U);
+		if (i % 10U == 9U) {
+			CHECK_EQ(Logger_Commit(), SCN_OK);
+		}
+	}
+	CHECK_EQ(Logger_Commit(), SCN_OK);
+}
+
+/* Entrées encore en FRAM : suffixe de s_all commençant à la plus ancienne relue */
+static uint32_t retained_from(uint32_t n)
+{
+	size_t got = Logger_ReadFrom(s_all[0].ts_ms, s_out, 1U);
+	uint32_t k = 0U;
+
+	CHECK_EQ(got, 1);
+	while (k < n && s_all[k].ts_ms != s_out[0].ts_ms) {
+		k++;
+	}
+	CHECK(k < n);
+	return k;
+}
+
+static void check_query(uint32_t first, uint32_t n, uint32_t q)
+{
+	uint32_t k = first;
+	while (k < n && (int32_t)(s_all[k].ts_ms - q) < 0) {
+		k++;
+	}
+	size_t got = Logger_ReadFrom(q, s_out, IDX_SAMPLES);
+	CHECK_EQ(got, n - k);
+	uint32_t bad = 0U;
+	for (size_t j = 0U; j < got && k + j < n; j++) {
+		bad += (s_out[j].ts_ms != s_all[k + j].ts_ms || s_out[j].t_cC != s_all[k + j].t_cC) ? 1U : 0U;
+	}
+	CHECK_EQ(bad, 0);
+}
+
+static void run(uint32_t ts0)
+{
+	fill(ts0, IDX_SAMPLES);
+	uint32_t first = retained_from(IDX_SAMPLES);
+	uint32_t last  = IDX_SAMPLES - 1U;
+	CHECK(first > 0U);                             /* journal recyclé */
+
+	/* Bornes : exactes, entre deux mesures, avant la queue, après la tête */
+	check_query(first, IDX_SAMPLES, s_all[first].ts_ms);
+	check_query(first, IDX_SAMPLES, s_all[first].ts_ms - 123456U);
+	check_query(first, IDX_SAMPLES, s_all[last].ts_ms);
+	CHECK_EQ(Logger_ReadFrom(s_all[last].ts_ms + 1U, s_out, IDX_SAMPLES), 0);
+	for (uint32_t i = 0U; i < IDX_QUERIES; i++) {
+		uint32_t k = first + test_rnd(&s_seed) % (IDX_SAMPLES - first);
+		check_query(first, IDX_SAMPLES, s_all[k].ts_ms - (test_rnd(&s_seed) & 1U) * 500U);
+	}
+
+	/* Pagination : ts_from = dernier ts + 1 */
+	uint32_t k = first, pages = 0U;
+	size_t   got;
+	uint32_t from = s_all[first].ts_ms;
+	while ((got = Logger_ReadFrom(from, s_out, IDX_PAGE)) != 0U) {
+		for (size_t j = 0U; j < got; j++) {
+			CHECK_EQ(s_out[j].ts_ms, s_all[k++].ts_ms);
+		}
+		from = s_out[got - 1U].ts_ms + 1U;
+		pages++;
+	}
+	CHECK_EQ(k, IDX_SAMPLES);
+
+	/* Requête récente : la dichotomie sur l'index ne lit que les derniers segments */
+	fram_stats_t st;
+	Fram_ResetStats();
+	(void)Logger_ReadFrom(s_all[last - 5U].ts_ms, s_out, IDX_SAMPLES);
+	Fram_GetStats(&st);
+	CHECK(st.data_bytes <= 2U * FRAM_SLOT_SIZE);
+
+	printf("ts0 0x%08X : %u mesures retenues sur %u, %u pages, requête récente %u o lus\n",
+	       ts0, IDX_SAMPLES - first, IDX_SAMPLES, pages, st.data_bytes);
+}
+
+int main(void)
+{
+	run(0U);
+	run(0U - 75000000U);                           /* compteur replié au milieu du journal retenu */
+	TEST_END();
+}
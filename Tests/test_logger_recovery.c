@@ -0,0 +1,126 @@
+/**
+ * @file    test_logger_recovery.c
+ * @brief   Journal résistant aux coupures : boots successifs avec coupure
+ *          d'alimentation (Fram_SimPowerCut) à un octet quelconque d'un
+ *          commit. Après chaque reboot : entrées relues valides et dans
+ *          l'ordre, aucune entrée d'un commit terminé perdue, horodatage
+ *          repris après la dernière entrée, et lecture FRAM au boot bornée
+ *          (en-têtes + un segment) quel que soit le remplissage.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include "fram_spi.h"
+
+#define REC_ROUNDS       400U      /* tours : mesures, commits, coupure une fois sur trois */
+#define REC_MAX_IDS      200000U
+#define REC_SLOTS        ((FRAM_SIZE_BYTES - FRAM_JOURNAL_BASE) / FRAM_SLOT_SIZE)
+#define REC_BOOT_BYTES   (REC_SLOTS * (10U + LOGGER_SEG_HDR_SIZE) + FRAM_SLOT_SIZE)   /* index + en-têtes + tête */
+
+static uint8_t     s_sure[REC_MAX_IDS];            /* 1 : id dans un commit terminé sans coupure */
+static log_entry_t s_out[REC_MAX_IDS];
+static uint32_t    s_seed = 2024U;
+
+/* Identifiant de mesure porté par rh_pm / vin_mV : chaque entrée relue est reconnue */
+static log_entry_t mk(uint32_t id, uint32_t ts)
+{
+	log_entry_t e = { 0 };
+	e.ts_ms   = ts;
+	e.t_cC    = (int16_t)(300 + (int32_t)(test_rnd(&s_seed) % 50U));
+	e.rh_pm   = (uint16_t)id;
+	e.vin_mV  = (uint16_t)(id >> 16);
+	e.door    = (uint8_t)(id / 100U & 1U);
+	return e;
+}
+
+static uint32_t id_of(const log_entry_t *e)
+{
+	return (uint32_t)e->rh_pm | ((uint32_t)e->vin_mV << 16);
+}
+
+int main(void)
+{
+	static const uint8_t zero[FRAM_SLOT_SIZE];
+	uint32_t id = 0U, pend = 0U, cuts = 0U, boot_max = 0U;
+	uint32_t tick = 0U;                            /* tick RTOS : repart de 0 à chaque reboot */
+	uint32_t last_ts = 0U;
+	bool     have_last = false;
+
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	for (uint32_t a = 0U; a < FRAM_SIZE_BYTES; a += sizeof(zero)) {
+		CHECK_EQ(Fram_Write(a, zero, sizeof(zero)), SCN_OK);
+	}
+	Logger_Init();
+
+	for (uint32_t round = 0U; round < REC_ROUNDS && id < REC_MAX_IDS - 400U; round++) {
+		uint32_t n    = 1U + test_rnd(&s_seed) % 300U;
+		bool     cut  = (test_rnd(&s_seed) % 3U) == 0U;
+
+		for (uint32_t k = 0U; k < n; k++, tick += 1000U) {
+			log_entry_t e = mk(id, tick);
+			CHECK(Logger_Append(&e));
+			id++;
+			if (k % 10U == 9U && k + 1U < n) {     /* commits terminés, avant la coupure */
+				CHECK_EQ(Logger_Commit(), SCN_OK);
+				for (; pend < id; pend++) {
+					s_sure[pend] = 1U;
+				}
+			}
+		}
+		if (cut) {
+			Fram_SimPowerCut(test_rnd(&s_seed) % 1200U);
+			(void)Logger_Commit();                 /* issue inconnue : rien de garanti */
+			pend = id;
+			cuts++;
+
+			/* Reboot : boot en temps borné */
+			fram_stats_t st;
+			tick = 0U;
+			CHECK_EQ(Fram_Init(), SCN_OK);
+			Fram_ResetStats();
+			Logger_Init();
+			Fram_GetStats(&st);
+			boot_max = (st.data_bytes > boot_max) ? st.data_bytes : boot_max;
+			CHECK(st.data_bytes <= REC_BOOT_BYTES);
+		} else {
+			CHECK_EQ(Logger_Commit(), SCN_OK);
+			for (; pend < id; pend++) {
+				s_sure[pend] = 1U;
+			}
+		}
+
+		/* Journal relu : valide, ordonné, sans trou sur les commits terminés */
+		size_t   got  = Logger_ReadFrom(0U, s_out, REC_MAX_IDS);
+		uint32_t bad  = 0U, lost = 0U;
+		for (size_t j = 0U; j < got; j++) {
+			bad += (s_out[j].crc8 != Logger_EntryCrc(&s_out[j])) ? 1U : 0U;
+			if (j > 0U) {
+				bad += (id_of(&s_out[j]) <= id_of(&s_out[j - 1U])) ? 1U : 0U;
+				bad += ((int32_t)(s_out[j].ts_ms - s_out[j - 1U].ts_ms) <= 0) ? 1U : 0U;
+				for (uint32_t m = id_of(&s_out[j - 1U]) + 1U; m < id_of(&s_out[j]) && m < REC_MAX_IDS; m++) {
+					lost += s_sure[m];
+				}
+			}
+		}
+		if (got > 0U) {
+			for (uint32_t m = id_of(&s_out[got - 1U]) + 1U; m < id; m++) {
+				lost += s_sure[m];                 /* commit terminé après la dernière entrée relue */
+			}
+			/* Horodatage repris après la dernière entrée connue, jamais en arrière */
+			if (have_last) {
+				bad += ((int32_t)(s_out[got - 1U].ts_ms - last_ts) < 0) ? 1U : 0U;
+			}
+			last_ts   = s_out[got - 1U].ts_ms;
+			have_last = true;
+		}
+		CHECK_EQ(bad, 0);
+		CHECK_EQ(lost, 0);
+	}
+
+	printf("%u mesures, %u coupures, lecture FRAM au boot <= %u o (borne %u)\n", id, cuts, boot_max, REC_BOOT_BYTES);
+	CHECK(cuts > 0U);
+	TEST_END();
+}
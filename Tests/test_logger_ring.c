@@ -0,0 +1,133 @@
+/**
+ * @file    test_logger_ring.c
+ * @brief   Ring SPSC du logger : capacité exacte, entrée refusée et comptée
+ *          quand il est plein, ordre conservé au repli des index, puis
+ *          producteur et consommateur sur deux threads (aucune perte, aucun
+ *          doublon, CRC-8 intacts).
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "logger.h"
+#include "fram_spi.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define SPSC_ENTRIES   2000000U
+
+static log_entry_t mk(uint32_t i)
+{
+	log_entry_t e = { 0 };
+	e.ts_ms   = i;
+	e.t_cC    = (int16_t)(i & 0x7FFFU);
+	e.rh_pm   = (uint16_t)(i >> 3);
+	e.vin_mV  = 24000U;
+	e.door    = (uint8_t)((i >> 8) & 1U);
+	return e;
+}
+
+static void test_capacity(void)
+{
+	log_entry_t e = mk(0U);
+	log_entry_t out[LOGGER_RING_CAPACITY];
+
+	for (uint32_t i = 0U; i < LOGGER_RING_CAPACITY; i++) {
+		e = mk(i);
+		CHECK(Logger_Append(&e));
+	}
+	CHECK_EQ(Logger_Count(), LOGGER_RING_CAPACITY);
+	e = mk(LOGGER_RING_CAPACITY);
+	CHECK(!Logger_Append(&e));                     /* plein : l'historique est gardé */
+	CHECK_EQ(Logger_Dropped(), 1);
+
+	CHECK_EQ(Logger_Drain(out, LOGGER_RING_CAPACITY), LOGGER_RING_CAPACITY);
+	for (uint32_t i = 0U; i < LOGGER_RING_CAPACITY; i++) {
+		CHECK_EQ(out[i].ts_ms, i);
+		CHECK_EQ(out[i].crc8, Logger_EntryCrc(&out[i]));
+	}
+	CHECK_EQ(Logger_Count(), 0);
+	CHECK_EQ(Logger_Drain(out, 1U), 0);
+}
+
+static void test_wrap(void)
+{
+	log_entry_t out[LOGGER_RING_CAPACITY];
+	uint32_t    next_in = 0U, next_out = 0U;
+
+	/* Lots de tailles premières entre elles : le repli tombe partout dans le ring */
+	for (uint32_t round = 0U; round < 200U; round++) {
+		uint32_t put = 1U + (round * 37U) % 301U;
+		for (uint32_t i = 0U; i < put; i++) {
+			log_entry_t e = mk(next_in);
+			if (Logger_Append(&e)) {
+				next_in++;
+			}
+		}
+		size_t n = Logger_Drain(out, 1U + (round * 53U) % 257U);
+		for (size_t i = 0U; i < n; i++) {
+			CHECK_EQ(out[i].ts_ms, next_out);
+			next_out++;
+		}
+	}
+	size_t n;
+	while ((n = Logger_Drain(out, LOGGER_RING_CAPACITY)) != 0U) {
+		for (size_t i = 0U; i < n; i++) {
+			CHECK_EQ(out[i].ts_ms, next_out);
+			next_out++;
+		}
+	}
+	CHECK_EQ(next_out, next_in);
+}
+
+static void *producer(void *arg)
+{
+	(void)arg;
+	for (uint32_t i = 0U; i < SPSC_ENTRIES; i++) {
+		log_entry_t e = mk(i);
+		while (!Logger_Append(&e)) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void test_spsc_threads(void)
+{
+	static log_entry_t out[64];
+	pthread_t th;
+	uint32_t  next = 0U;
+	uint32_t  bad  = 0U;
+
+	CHECK_EQ(pthread_create(&th, NULL, producer, NULL), 0);
+	while (next < SPSC_ENTRIES) {
+		size_t n = Logger_Drain(out, 64U);
+		if (n == 0U) {
+			sched_yield();
+		}
+		for (size_t i = 0U; i < n; i++) {
+			log_entry_t ref = mk(next);
+			if (out[i].ts_ms != next || out[i].t_cC != ref.t_cC || out[i].rh_pm != ref.rh_pm ||
+			    out[i].crc8 != Logger_EntryCrc(&out[i])) {
+				bad++;
+			}
+			next++;
+		}
+	}
+	pthread_join(th, NULL);
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(Logger_Count(), 0);
+}
+
+int main(void)
+{
+	remove(FRAM_SIM_FILE);                         /* journal vierge : décalage d'horodatage nul */
+	CHECK_EQ(Fram_Init(), SCN_OK);
+	Logger_Init();
+
+	test_capacity();
+	test_wrap();
+	test_spsc_threads();
+	TEST_END();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file    test_sensor_detect.c
+ * @brief   Détection du capteur au boot sur le bus I2C simulé : SHT31 seul
+ *          (0x44 ou 0x45), HDC1080 seul, les deux (SHT31 prioritaire), aucun ;
+ *          chaque driver retenu mesure juste avec ses propres constantes.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "sensor_th.h"
+#include <stdlib.h>
+
+typedef struct {
+	uint8_t    present;
+	th_model_t model;
+	uint16_t   addr;
+} det_case_t;
+
+static const det_case_t k_cases[] = {
+	{ TH_SIM_SHT31,                                   TH_MODEL_SHT31,   SHT31_I2C_ADDR     },
+	{ TH_SIM_SHT31_ALT,                               TH_MODEL_SHT31,   SHT31_I2C_ADDR_ALT },
+	{ TH_SIM_HDC1080,                                 TH_MODEL_HDC1080, HDC1080_I2C_ADDR   },
+	{ TH_SIM_SHT31 | TH_SIM_HDC1080,                  TH_MODEL_SHT31,   SHT31_I2C_ADDR     },
+	{ TH_SIM_SHT31_ALT | TH_SIM_HDC1080,              TH_MODEL_SHT31,   SHT31_I2C_ADDR_ALT },
+	{ TH_SIM_SHT31 | TH_SIM_SHT31_ALT,                TH_MODEL_SHT31,   SHT31_I2C_ADDR     },
+	{ 0U,                                             TH_MODEL_NONE,    0U                 },
+};
+
+/* Mesures sur toute la plage : résolution HDC1080 14 bits (~1 centi-°C, ~0,6 ‰), SHT31 16 bits */
+static void check_range(void)
+{
+	th_sample_t s;
+
+	for (int16_t t = -3000; t <= 7000; t += 125) {
+		uint16_t rh = (uint16_t)(100 + (t + 3000) / 12);
+		SensorTh_SimSetEnv(t, rh);
+		SensorTh_SimAdvance(250U);
+		CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+		CHECK(abs(s.t_cC - t) <= 2);
+		CHECK(abs((int)s.rh_pm - (int)rh) <= 2);
+	}
+}
+
+int main(void)
+{
+	th_sample_t s;
+	th_stats_t  st;
+
+	for (size_t i = 0U; i < sizeof(k_cases) / sizeof(k_cases[0]); i++) {
+		const det_case_t *c = &k_cases[i];
+
+		SensorTh_SimPresent(c->present);
+		SensorTh_SimAdvance(1000U);                                    /* conversions en cours terminées */
+		CHECK_EQ(SensorTh_Init(), SCN_OK);
+		CHECK_EQ(SensorTh_Probe(), (c->model == TH_MODEL_NONE) ? ERR_I2C_NACK : SCN_OK);
+		CHECK_EQ(SensorTh_Model(), c->model);
+		CHECK_EQ(SensorTh_Addr(), c->addr);
+		SensorTh_GetStats(&st);
+		CHECK_EQ(st.probes, 1);
+		CHECK_EQ(st.setups, 0);                                        /* aucune configuration à la détection */
+
+		if (c->model == TH_MODEL_NONE) {
+			CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);                 /* nouvelle détection, même issue */
+			SensorTh_GetStats(&st);
+			CHECK_EQ(st.probes, 2);
+			continue;
+		}
+		uint32_t probe_nacks = st.nacks;                               /* adresses vides avant le capteur */
+		check_range();
+		SensorTh_GetStats(&st);
+		CHECK_EQ(st.setups, 1);
+		CHECK_EQ(st.nacks, probe_nacks);
+		CHECK_EQ(st.crc_errors, 0);
+	}
+
+	/* Détection au premier Trigger, sans Probe explicite ; capteur branché à chaud ensuite */
+	SensorTh_SimPresent(0U);
+	CHECK_EQ(SensorTh_Init(), SCN_OK);
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	SensorTh_SimPresent(TH_SIM_HDC1080);
+	SensorTh_SimSetEnv(-1850, 910U);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_HDC1080);
+	CHECK(abs(s.t_cC + 1850) <= 2);
+	CHECK(abs((int)s.rh_pm - 910) <= 2);
+
+	/* HDC1080 remplacé par un SHT31 : NACK répétés, puis nouveau driver retenu */
+	SensorTh_SimPresent(TH_SIM_SHT31_ALT);
+	for (uint8_t i = 0U; i < SENSOR_TH_NACK_RESETUP; i++) {
+		CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	}
+	SensorTh_SimAdvance(250U);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_SHT31);
+	CHECK_EQ(SensorTh_Addr(), SHT31_I2C_ADDR_ALT);
+
+	TEST_END();
+}
@@ -0,0 +1,142 @@
+/**
+ * @file    test_sensor_th.c
+ * @brief   Driver SHT31 sur le bus I2C simulé : mesure non bloquante (Trigger
+ *          rend la main sans temps écoulé, Collect n'attend que la conversion),
+ *          valeurs converties, puis chemins d'erreur injectés : NACK, bus
+ *          bloqué (timeout puis reconfiguration), CRC faux, NACK répétés
+ *          jusqu'à une nouvelle détection, appels hors séquence.
+ * @copyright
+ *   © 2025 SYLORIA — MIT License
+ *   Auteur : BAQUEY Lucas (contact@syloria.fr)
+ */
+
+#include "scn_test.h"
+#include "sensor_th.h"
+#include <stdlib.h>
+
+#define ART_MS   250U      /* SHT31 périodique : une mesure nouvelle toutes les 250 ms */
+
+static void check_sample(const th_sample_t *s, int16_t t_cC, uint16_t rh_pm)
+{
+	CHECK(abs(s->t_cC - t_cC) <= 1);
+	CHECK(abs((int)s->rh_pm - (int)rh_pm) <= 1);
+}
+
+int main(void)
+{
+	th_sample_t s;
+	th_stats_t  st;
+	uint32_t    t0;
+
+	SensorTh_SimPresent(TH_SIM_SHT31);
+	SensorTh_SimSetEnv(2150, 640U);
+	CHECK_EQ(SensorTh_Init(), SCN_OK);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_NONE);
+	CHECK_EQ(SensorTh_Collect(&s), ERR_I2C_BUS);                       /* aucun Trigger en attente */
+
+	/* Première mesure : détection, configuration, attente de la 1re conversion (tâche endormie) */
+	t0 = SensorTh_SimNowMs();
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_SHT31);
+	CHECK_EQ(SensorTh_Addr(), SHT31_I2C_ADDR);
+	check_sample(&s, 2150, 640U);
+	CHECK(SensorTh_SimNowMs() - t0 >= 13U && SensorTh_SimNowMs() - t0 <= 20U);
+
+	/* Régime établi : Trigger sans temps écoulé, Collect sans conversion à attendre */
+	SensorTh_ResetStats();
+	for (int16_t t = -2000; t <= 6000; t += 250) {
+		SensorTh_SimSetEnv(t, (uint16_t)(500 + t / 20));
+		SensorTh_SimAdvance(ART_MS);
+		t0 = SensorTh_SimNowMs();
+		CHECK_EQ(SensorTh_Trigger(), SCN_OK);
+		CHECK_EQ(SensorTh_State(), TH_READ);
+		CHECK_EQ(SensorTh_SimNowMs(), t0);
+		CHECK_EQ(SensorTh_Trigger(), ERR_I2C_BUS);                     /* mesure précédente non collectée */
+		CHECK_EQ(SensorTh_Collect(&s), SCN_OK);
+		CHECK_EQ(SensorTh_State(), TH_IDLE);
+		CHECK_EQ(SensorTh_SimNowMs(), t0);
+		check_sample(&s, t, (uint16_t)(500 + t / 20));
+	}
+	SensorTh_GetStats(&st);
+	CHECK_EQ(st.xfers, 33);                                            /* un FETCH DATA par mesure */
+	CHECK_EQ(st.bytes, 33U * (3U + 7U));
+	CHECK_EQ(st.setups, 0);
+	SensorTh_SimSetEnv(2000, 500U);
+
+	/* NACK : adresse non acquittée, le capteur reste retenu */
+	SensorTh_ResetStats();
+	SensorTh_SimAdvance(ART_MS);
+	SensorTh_SimFault(TH_SIM_NACK, 1U);
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	CHECK_EQ(SensorTh_State(), TH_IDLE);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_SHT31);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	SensorTh_GetStats(&st);
+	CHECK_EQ(st.nacks, 1);
+	CHECK_EQ(st.setups, 0);
+
+	/* Mesure pas encore prête (lue avant la suivante) : NACK du capteur lui-même */
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+
+	/* Bus bloqué : timeout borné, puis reconfiguration complète à la mesure suivante */
+	SensorTh_ResetStats();
+	SensorTh_SimAdvance(ART_MS);
+	SensorTh_SimFault(TH_SIM_HANG, 1U);
+	t0 = SensorTh_SimNowMs();
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_TIMEOUT);
+	CHECK_EQ(SensorTh_SimNowMs() - t0, SENSOR_TH_I2C_TIMEOUT_MS);
+	CHECK_EQ(SensorTh_State(), TH_IDLE);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	check_sample(&s, 2000, 500U);
+	SensorTh_GetStats(&st);
+	CHECK_EQ(st.timeouts, 1);
+	CHECK_EQ(st.setups, 1);
+
+	/* Timeout pendant la configuration elle-même : reprise à la mesure suivante */
+	SensorTh_SimAdvance(ART_MS);
+	SensorTh_SimFault(TH_SIM_HANG, 1U);
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_TIMEOUT);                      /* FETCH bloqué */
+	SensorTh_SimFault(TH_SIM_HANG, 1U);
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_TIMEOUT);                      /* Break bloqué */
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+
+	/* CRC faux : mesure rejetée, ni reconfiguration ni nouvelle détection */
+	SensorTh_ResetStats();
+	SensorTh_SimAdvance(ART_MS);
+	SensorTh_SimFault(TH_SIM_CRC, 1U);
+	CHECK_EQ(SensorTh_Read(&s), ERR_SENSOR_CRC);
+	SensorTh_SimAdvance(ART_MS);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	SensorTh_GetStats(&st);
+	CHECK_EQ(st.crc_errors, 1);
+	CHECK_EQ(st.setups, 0);
+	CHECK_EQ(st.probes, 0);
+
+	/* NACK répétés : capteur oublié puis redétecté au Trigger suivant */
+	SensorTh_ResetStats();
+	SensorTh_SimAdvance(ART_MS);
+	SensorTh_SimFault(TH_SIM_NACK, SENSOR_TH_NACK_RESETUP);
+	for (uint8_t i = 0U; i < SENSOR_TH_NACK_RESETUP; i++) {
+		CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	}
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_NONE);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+	CHECK_EQ(SensorTh_Model(), TH_MODEL_SHT31);
+	SensorTh_GetStats(&st);
+	CHECK_EQ(st.probes, 1);
+	CHECK_EQ(st.setups, 1);
+
+	/* Capteur débranché : chaque Trigger retente la détection, sans jamais bloquer */
+	SensorTh_SimPresent(0U);
+	SensorTh_SimAdvance(ART_MS);
+	for (uint8_t i = 0U; i < SENSOR_TH_NACK_RESETUP; i++) {
+		CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	}
+	t0 = SensorTh_SimNowMs();
+	CHECK_EQ(SensorTh_Read(&s), ERR_I2C_NACK);
+	CHECK(SensorTh_SimNowMs() - t0 <= 1U);
+	SensorTh_SimPresent(TH_SIM_SHT31);
+	CHECK_EQ(SensorTh_Read(&s), SCN_OK);
+
+	TEST_END();
+}